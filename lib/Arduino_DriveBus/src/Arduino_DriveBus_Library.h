@@ -21,6 +21,7 @@
 
 #include "./hardware/Arduino_HWIIC.h"
 #include "./hardware/Arduino_HWIIS.h"
+#include "./hardware/Arduino_ReplayIIS.h"
 
 #include "Arduino_IIC.h"
 #include "Arduino_IIS.h"
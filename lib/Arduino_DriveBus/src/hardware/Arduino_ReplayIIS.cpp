@@ -0,0 +1,418 @@
+/*
+ * @Description: Arduino_ReplayIIS.cpp
+ * @version: V1.0.0
+ * @Author: MoodLink
+ * @Date: 2026-10-18 10:00:00
+ * @License: GPL 3.0
+ */
+#include "Arduino_ReplayIIS.h"
+
+#include <stdio.h>
+
+Arduino_ReplayIIS::Arduino_ReplayIIS()
+    : _sample_pos(0), _loop(true), _exhausted(false),
+      _synthetic(SS_SILENCE), _use_synthetic(false), _frequency_hz(440.0f), _phase(0.0f),
+      _amplitude(8000), _synthetic_pos(0),
+      _dma_buf_count(8), _dma_buf_len(1024), _jitter_max_us(0), _dropout_rate(0.0f),
+      _realtime(true), _seed(1), _random_state(1),
+      _running(false), _frame_bytes(0), _block_bytes(0), _slots_per_frame(1), _block_period_us(0),
+      _clock_us(0), _skew_us(0), _start_us(0), _last_deadline_us(0), _last_micros(0),
+      _next_block(0), _next_jitter_us(0),
+      _ring_read(0), _ring_fill(0), _stats()
+{
+}
+
+bool Arduino_ReplayIIS::loadWav(const char *path, bool loop)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        log_e("->fopen(%s) fail", path);
+        return false;
+    }
+
+    uint8_t riff[12];
+    if (fread(riff, 1, sizeof(riff), file) != sizeof(riff) ||
+        memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0)
+    {
+        log_e("->%s is not a WAV file", path);
+        fclose(file);
+        return false;
+    }
+
+    uint16_t channels = 0, bits = 0;
+    bool found = false;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, sizeof(chunk), file) == sizeof(chunk))
+    {
+        uint32_t size = chunk[4] | (chunk[5] << 8) | (chunk[6] << 16) | ((uint32_t)chunk[7] << 24);
+
+        if (memcmp(chunk, "fmt ", 4) == 0)
+        {
+            uint8_t fmt[16];
+            if (size < sizeof(fmt) || fread(fmt, 1, sizeof(fmt), file) != sizeof(fmt))
+            {
+                break;
+            }
+            channels = fmt[2] | (fmt[3] << 8);
+            bits = fmt[14] | (fmt[15] << 8);
+            size -= sizeof(fmt);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            found = true;
+            break;
+        }
+
+        // Skip the rest of the chunk (odd sizes carry a padding byte)
+        fseek(file, size + (size & 1), SEEK_CUR);
+    }
+
+    if (found == false || bits != 16 || channels == 0)
+    {
+        log_e("->%s is not 16-bit PCM", path);
+        fclose(file);
+        return false;
+    }
+
+    // Reads up to the end of the file: truncated data chunks are accepted
+    _samples.clear();
+    int16_t frame[8];
+    size_t frame_bytes = channels * sizeof(int16_t);
+    while (channels <= 8 && fread(frame, 1, frame_bytes, file) == frame_bytes)
+    {
+        _samples.push_back(frame[0]);
+    }
+    fclose(file);
+
+    _use_synthetic = false;
+    _loop = loop;
+    _sample_pos = 0;
+    _exhausted = false;
+    return _samples.empty() == false;
+}
+
+void Arduino_ReplayIIS::setSamples(const int16_t *samples, size_t count, bool loop)
+{
+    _samples.assign(samples, samples + count);
+    _use_synthetic = false;
+    _loop = loop;
+    _sample_pos = 0;
+    _exhausted = false;
+}
+
+void Arduino_ReplayIIS::setSynthetic(Synthetic_Source source, float frequency_hz, int16_t amplitude)
+{
+    _synthetic = source;
+    _use_synthetic = true;
+    _frequency_hz = frequency_hz;
+    _amplitude = amplitude;
+    _exhausted = false;
+}
+
+void Arduino_ReplayIIS::setDmaBuffers(uint16_t count, uint16_t frames)
+{
+    _dma_buf_count = (count < 2) ? 2 : count;
+    _dma_buf_len = (frames < 8) ? 8 : frames;
+}
+
+void Arduino_ReplayIIS::setJitter(uint32_t max_us)
+{
+    _jitter_max_us = max_us;
+}
+
+void Arduino_ReplayIIS::setDropoutRate(float probability)
+{
+    _dropout_rate = probability;
+}
+
+void Arduino_ReplayIIS::setRealtime(bool realtime)
+{
+    _realtime = realtime;
+}
+
+void Arduino_ReplayIIS::setSeed(uint32_t seed)
+{
+    _seed = (seed == 0) ? 1 : seed;
+}
+
+bool Arduino_ReplayIIS::begin(i2s_mode_t iis_mode, ad_iis_data_mode_t device_state, i2s_channel_fmt_t channel_mode,
+                              int8_t bits_per_sample, int32_t sample_rate)
+{
+    _iis_mode = iis_mode;
+    _device_state = device_state;
+    _channel_mode = channel_mode;
+    _bits_per_sample = (bits_per_sample == DRIVEBUS_DEFAULT_VALUE) ? 16 : bits_per_sample;
+    _sample_rate = (sample_rate == DRIVEBUS_DEFAULT_VALUE) ? 44100U : sample_rate;
+
+    if (_bits_per_sample != 16 && _bits_per_sample != 32)
+    {
+        log_e("->bits_per_sample %d not supported (16 or 32)", (int)_bits_per_sample);
+        return false;
+    }
+
+    switch (_channel_mode)
+    {
+    case I2S_CHANNEL_FMT_ONLY_LEFT:
+    case I2S_CHANNEL_FMT_ONLY_RIGHT:
+        _slots_per_frame = 1;
+        break;
+    default:
+        _slots_per_frame = 2;
+        break;
+    }
+
+    _frame_bytes = _slots_per_frame * (_bits_per_sample / 8);
+    _block_bytes = _dma_buf_len * _frame_bytes;
+    _block_period_us = _dma_buf_len * 1000000.0 / _sample_rate;
+    _ring.assign(_dma_buf_count * _block_bytes, 0);
+    _ring_read = 0;
+    _ring_fill = 0;
+
+    // Same seed, same source position: every begin() replays identically
+    _random_state = _seed;
+    _sample_pos = 0;
+    _synthetic_pos = 0;
+    _phase = 0.0f;
+    _exhausted = false;
+
+    _clock_us = 0;
+    _skew_us = 0;
+    _last_micros = micros();
+    _start_us = Now();
+    _last_deadline_us = _start_us;
+    _next_block = 0;
+    _next_jitter_us = (_jitter_max_us > 0) ? Random() % (_jitter_max_us + 1) : 0;
+
+    _running = true;
+    return true;
+}
+
+size_t Arduino_ReplayIIS::Read(void *data, size_t bytes)
+{
+    if (_running == false)
+    {
+        return 0;
+    }
+
+    _stats.read_calls++;
+
+    uint8_t *out = (uint8_t *)data;
+    size_t done = 0;
+    while (done < bytes)
+    {
+        Advance(Now());
+
+        if (_ring_fill == 0)
+        {
+            // Nothing in the DMA buffers yet: wait for the next block
+            uint64_t now = Now();
+            uint64_t deadline = BlockDeadline(_next_block);
+            if (deadline > now)
+            {
+                uint64_t wait = deadline - now;
+                if (_realtime == true)
+                {
+                    if (wait >= 1000)
+                    {
+                        delay(wait / 1000);
+                    }
+                    delayMicroseconds(wait % 1000);
+                    _stats.wait_us += Now() - now;
+                }
+                else
+                {
+                    _skew_us += wait;
+                }
+            }
+            continue;
+        }
+
+        size_t chunk = bytes - done;
+        if (chunk > _ring_fill)
+        {
+            chunk = _ring_fill;
+        }
+        if (chunk > _ring.size() - _ring_read)
+        {
+            chunk = _ring.size() - _ring_read;
+        }
+
+        memcpy(out + done, &_ring[_ring_read], chunk);
+        _ring_read = (_ring_read + chunk) % _ring.size();
+        _ring_fill -= chunk;
+        done += chunk;
+    }
+
+    _stats.bytes_read += done;
+    return done;
+}
+
+size_t Arduino_ReplayIIS::Write(const void *data, size_t bytes)
+{
+    // Output is discarded: the bus only models the receive path
+    return bytes;
+}
+
+bool Arduino_ReplayIIS::end()
+{
+    _running = false;
+    _ring.clear();
+    _ring_fill = 0;
+    return true;
+}
+
+Arduino_ReplayIIS::Stats Arduino_ReplayIIS::getStats(void) const
+{
+    return _stats;
+}
+
+void Arduino_ReplayIIS::resetStats(void)
+{
+    _stats = Stats();
+}
+
+bool Arduino_ReplayIIS::isExhausted(void) const
+{
+    return _exhausted;
+}
+
+uint32_t Arduino_ReplayIIS::Random(void)
+{
+    // xorshift32: cheap and reproducible across targets
+    uint32_t x = _random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _random_state = x;
+    return x;
+}
+
+int16_t Arduino_ReplayIIS::NextSourceSample(void)
+{
+    if (_use_synthetic == false)
+    {
+        if (_samples.empty() == true)
+        {
+            return 0;
+        }
+        if (_sample_pos >= _samples.size())
+        {
+            if (_loop == false)
+            {
+                _exhausted = true;
+                return 0;
+            }
+            _sample_pos = 0;
+        }
+        return _samples[_sample_pos++];
+    }
+
+    const float two_pi = 6.28318530718f;
+    float frequency = _frequency_hz;
+    int16_t value = 0;
+
+    switch (_synthetic)
+    {
+    case SS_SWEEP:
+    {
+        float t = (float)(_synthetic_pos % (uint32_t)_sample_rate) / _sample_rate;
+        frequency = 100.0f * powf((_sample_rate / 2.0f) / 100.0f, t);
+    }
+        // fall through
+    case SS_SINE:
+        value = (int16_t)(sinf(_phase) * _amplitude);
+        _phase += two_pi * frequency / _sample_rate;
+        if (_phase >= two_pi)
+        {
+            _phase -= two_pi;
+        }
+        break;
+    case SS_NOISE:
+        value = (int16_t)(((int32_t)(Random() >> 16) - 32768) * _amplitude / 32768);
+        break;
+    default:
+        break;
+    }
+
+    _synthetic_pos++;
+    return value;
+}
+
+uint64_t Arduino_ReplayIIS::Now(void)
+{
+    // 64-bit clock from the 32-bit micros() (wraps after ~71 min)
+    uint32_t now = micros();
+    _clock_us += (uint32_t)(now - _last_micros);
+    _last_micros = now;
+    return _clock_us + _skew_us;
+}
+
+uint64_t Arduino_ReplayIIS::BlockDeadline(uint32_t block)
+{
+    uint64_t deadline = _start_us + (uint64_t)((block + 1) * _block_period_us) + _next_jitter_us;
+
+    // Jitter delays a block but never reorders it
+    return (deadline < _last_deadline_us) ? _last_deadline_us : deadline;
+}
+
+void Arduino_ReplayIIS::ProduceBlock(void)
+{
+    // Ring full: like the IDF driver, the oldest block is overwritten
+    if (_ring_fill + _block_bytes > _ring.size())
+    {
+        _ring_read = (_ring_read + _block_bytes) % _ring.size();
+        _ring_fill -= _block_bytes;
+        _stats.blocks_dropped++;
+    }
+
+    bool dropout = _dropout_rate > 0.0f && (Random() / 4294967296.0f) < _dropout_rate;
+    if (dropout == true)
+    {
+        _stats.dropouts++;
+    }
+
+    size_t write = (_ring_read + _ring_fill) % _ring.size();
+    for (uint16_t i = 0; i < _dma_buf_len; i++)
+    {
+        // The source keeps advancing during a dropout so timing stays aligned
+        int16_t sample = NextSourceSample();
+        if (dropout == true)
+        {
+            sample = 0;
+        }
+
+        for (uint8_t slot = 0; slot < _slots_per_frame; slot++)
+        {
+            if (_bits_per_sample == 32)
+            {
+                int32_t wide = (int32_t)sample << 16;
+                memcpy(&_ring[write], &wide, sizeof(wide));
+                write += sizeof(wide);
+            }
+            else
+            {
+                memcpy(&_ring[write], &sample, sizeof(sample));
+                write += sizeof(sample);
+            }
+        }
+        if (write >= _ring.size())
+        {
+            write = 0;
+        }
+    }
+
+    _ring_fill += _block_bytes;
+    _last_deadline_us = BlockDeadline(_next_block);
+    _next_block++;
+    _next_jitter_us = (_jitter_max_us > 0) ? Random() % (_jitter_max_us + 1) : 0;
+    _stats.blocks_produced++;
+}
+
+void Arduino_ReplayIIS::Advance(uint64_t now)
+{
+    while (_running == true && BlockDeadline(_next_block) <= now)
+    {
+        ProduceBlock();
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * @Description(CN):
+ *      这是一个不使用硬件的IIS底层驱动文件 从WAV文件或合成信号回放采样
+ *  并模拟实时节奏、DMA块大小、抖动和丢块
+ *
+ * @Description(EN):
+ *      This is a bottom-layer IIS driver file without hardware. It replays samples
+ *  from a WAV file or a synthetic generator and models real-time pacing, DMA block
+ *  size, jitter and dropouts, so capture code can be load-tested on any host.
+ *
+ * @version: V1.0.0
+ * @Author: MoodLink
+ * @Date: 2026-10-18 10:00:00
+ * @License: GPL 3.0
+ */
+#pragma once
+
+#include "../Arduino_DriveBus.h"
+
+class Arduino_ReplayIIS : public Arduino_IIS_DriveBus
+{
+public:
+    enum Synthetic_Source
+    {
+        SS_SILENCE,
+        SS_SINE,
+        SS_SWEEP,  // Logarithmic sweep 100 Hz -> sample_rate / 2, repeats every second
+        SS_NOISE,  // Uniform white noise
+    };
+
+    struct Stats
+    {
+        uint64_t read_calls;
+        uint64_t bytes_read;
+        uint32_t blocks_produced;
+        uint32_t blocks_dropped;  // DMA overrun: the reader fell behind and the oldest block was lost
+        uint32_t dropouts;        // Injected blocks of silence
+        uint64_t wait_us;         // Time spent blocked inside Read()
+    };
+
+    Arduino_ReplayIIS();
+
+    /*
+     * Sources: call one before begin(). Without a source the bus serves silence.
+     * WAV files must be 16-bit PCM; only the first channel is used and the
+     * file's sample rate is not converted. loadWav() uses stdio, so on the
+     * ESP32 the path must include the VFS mount point (e.g. "/littlefs/a.wav").
+     */
+    bool loadWav(const char *path, bool loop = true);
+    void setSamples(const int16_t *samples, size_t count, bool loop = true);
+    void setSynthetic(Synthetic_Source source, float frequency_hz = 440.0f, int16_t amplitude = 8000);
+
+    /*
+     * Timing model (defaults match Arduino_HWIIS: 8 buffers x 1024 frames,
+     * real-time pacing, no jitter, no dropouts, seed 1).
+     * In real-time mode Read() blocks like i2s_read(); otherwise the virtual
+     * clock jumps forward to the next block and Read() never waits.
+     */
+    void setDmaBuffers(uint16_t count, uint16_t frames);
+    void setJitter(uint32_t max_us);
+    void setDropoutRate(float probability);
+    void setRealtime(bool realtime);
+    void setSeed(uint32_t seed);
+
+    bool begin(i2s_mode_t iis_mode, ad_iis_data_mode_t device_state, i2s_channel_fmt_t channel_mode,
+               int8_t bits_per_sample = DRIVEBUS_DEFAULT_VALUE, int32_t sample_rate = DRIVEBUS_DEFAULT_VALUE) override;
+
+    size_t Read(void *data, size_t bytes) override;
+    size_t Write(const void *data, size_t bytes) override;
+
+    bool end() override;
+
+    Stats getStats(void) const;
+    void resetStats(void);
+
+    // true once a non-looping source has been fully served
+    bool isExhausted(void) const;
+
+private:
+    uint32_t Random(void);
+    int16_t NextSourceSample(void);
+    uint64_t Now(void);
+    uint64_t BlockDeadline(uint32_t block);
+    void ProduceBlock(void);
+    void Advance(uint64_t now);
+
+    std::vector<int16_t> _samples;
+    size_t _sample_pos;
+    bool _loop, _exhausted;
+
+    Synthetic_Source _synthetic;
+    bool _use_synthetic;
+    float _frequency_hz, _phase;
+    int16_t _amplitude;
+    uint32_t _synthetic_pos;
+
+    uint16_t _dma_buf_count, _dma_buf_len;
+    uint32_t _jitter_max_us;
+    float _dropout_rate;
+    bool _realtime;
+    uint32_t _seed, _random_state;
+
+    bool _running;
+    size_t _frame_bytes, _block_bytes;
+    uint8_t _slots_per_frame;
+    double _block_period_us;
+    uint64_t _clock_us, _skew_us, _start_us, _last_deadline_us;
+    uint32_t _last_micros;
+    uint32_t _next_block;
+    uint32_t _next_jitter_us;
+
+    std::vector<uint8_t> _ring;
+    size_t _ring_read, _ring_fill;
+
+    Stats _stats;
+};
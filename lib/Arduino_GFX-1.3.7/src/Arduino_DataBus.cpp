@@ -6,6 +6,8 @@
 
 Arduino_DataBus::Arduino_DataBus() {}
 
+void Arduino_DataBus::waitIdle() {}
+
 void Arduino_DataBus::writeC8D8(uint8_t c, uint8_t d)
 {
   writeCommand(c);
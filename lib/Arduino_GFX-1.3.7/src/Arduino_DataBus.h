@@ -267,6 +267,10 @@ public:
   virtual void writeRepeat(uint16_t p, uint32_t len) = 0;
   virtual void writePixels(uint16_t *data, uint32_t len) = 0;
 
+  // Block until every queued transfer has left the bus. Only buses that
+  // queue transfers in the background need to override this.
+  virtual void waitIdle();
+
   void sendCommand(uint8_t c);
   void sendCommand16(uint16_t c);
   void sendData(uint8_t d);
@@ -13,6 +13,31 @@ Arduino_G::Arduino_G(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h)
 {
 }
 
+/**************************************************************************/
+/*!
+   @brief    Draw a window of a larger RGB565 bitmap, one row at a time. Outputs that can keep an address window open across rows should override this
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    bitmap   First pixel of the window
+   @param    w   Width of the window in pixels
+   @param    h   Height of the window in pixels
+   @param    x_skip   Pixels to skip at the end of each row (bitmap stride - w)
+*/
+/**************************************************************************/
+void Arduino_G::draw16bitRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t x_skip)
+{
+  if (x_skip == 0)
+  {
+    draw16bitRGBBitmap(x, y, bitmap, w, h);
+    return;
+  }
+  while (h--)
+  {
+    draw16bitRGBBitmap(x, y++, bitmap, w, 1);
+    bitmap += w + x_skip;
+  }
+}
+
 // utility functions
 bool gfx_draw_bitmap_to_framebuffer(
     uint16_t *from_bitmap, int16_t bitmap_w, int16_t bitmap_h,
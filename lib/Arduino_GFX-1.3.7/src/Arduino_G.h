@@ -22,6 +22,9 @@ public:
   virtual void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) = 0;
   virtual void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) = 0;
 
+  // Draw a w x h window of a larger 16-bit bitmap, skipping x_skip pixels at the end of each row
+  virtual void draw16bitRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t x_skip);
+
 protected:
   int16_t
       WIDTH,  ///< This is the 'raw' display width - never changes
@@ -7,6 +7,7 @@
  */
 #include "Arduino_DataBus.h"
 #include "Arduino_GFX.h"
+#include "Arduino_GlyphCache.h"
 #include "font/glcdfont.h"
 #include "float.h"
 #ifdef __AVR__
@@ -148,6 +149,23 @@ void Arduino_GFX::writePixel(int16_t x, int16_t y, uint16_t color)
   }
 }
 
+/**************************************************************************/
+/*!
+  @brief  Write a partly covered pixel, overwrite in subclasses that can read back pixels to blend
+  @param  x       x coordinate
+  @param  y       y coordinate
+  @param  color   16-bit 5-6-5 Color to draw with
+  @param  alpha   Coverage, 0 transparent to 255 opaque; without blending, drawn from 128 up
+*/
+/**************************************************************************/
+void Arduino_GFX::writePixelAlpha(int16_t x, int16_t y, uint16_t color, uint8_t alpha)
+{
+  if (alpha >= 128)
+  {
+    writePixel(x, y, color);
+  }
+}
+
 /**************************************************************************/
 /*!
   @brief  Write a pixel, overwrite in subclasses if startWrite is defined!
@@ -625,6 +643,75 @@ void Arduino_GFX::fillEllipse(int16_t x, int16_t y, int16_t rx, int16_t ry, uint
   endWrite();
 }
 
+// sin() of 0..89 degrees in Q16, for the integer arc rasterizer (sin(90) = 65536 does not fit)
+static const uint16_t arc_sin_table[90] PROGMEM = {
+    0, 1144, 2287, 3430, 4572, 5712, 6850, 7987, 9121, 10252,
+    11380, 12505, 13626, 14742, 15855, 16962, 18064, 19161, 20252, 21336,
+    22415, 23486, 24550, 25607, 26656, 27697, 28729, 29753, 30767, 31772,
+    32768, 33754, 34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243,
+    42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930, 48703, 49461,
+    50203, 50931, 51643, 52339, 53020, 53684, 54332, 54963, 55578, 56175,
+    56756, 57319, 57865, 58393, 58903, 59396, 59870, 60326, 60764, 61183,
+    61584, 61966, 62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+    64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446, 65496, 65526};
+
+static int32_t arc_sin_entry(int32_t deg)
+{
+  return (deg < 90) ? (int32_t)pgm_read_word(&arc_sin_table[deg]) : 65536;
+}
+
+// sin() of an angle in 0.1 degree (0..3600) in Q16, linear between whole degrees
+static int32_t arc_sin(int32_t a)
+{
+  int32_t quadrant = a / 900;
+  a %= 900;
+  if (quadrant & 1)
+  {
+    a = 900 - a;
+  }
+  int32_t i = a / 10;
+  int32_t f = a % 10;
+  int32_t v = arc_sin_entry(i);
+  if (f)
+  {
+    v += ((arc_sin_entry(i + 1) - v) * f + 5) / 10;
+  }
+  return (quadrant & 2) ? -v : v;
+}
+
+static int32_t arc_cos(int32_t a)
+{
+  return arc_sin((a + 900) % 3600);
+}
+
+// Largest x with x <= num / den, den != 0
+static int32_t arc_floor_div(int32_t num, int32_t den)
+{
+  int32_t q = num / den;
+  if ((q * den != num) && ((num < 0) != (den < 0)))
+  {
+    --q;
+  }
+  return q;
+}
+
+// Angles in 0.1 degree within 0..3599, returns true if start and end differ by whole turns
+static bool arc_angles(float start, float end, int16_t *s, int16_t *e)
+{
+  int32_t s10 = lroundf(start * 10);
+  int32_t e10 = lroundf(end * 10);
+  bool equal = (s10 == e10);
+  s10 %= 3600;
+  e10 %= 3600;
+  if (s10 < 0)
+    s10 += 3600;
+  if (e10 < 0)
+    e10 += 3600;
+  *s = s10;
+  *e = e10;
+  return (!equal) && (s10 == e10);
+}
+
 /**************************************************************************/
 /*!
   @brief  Draw an arc outline
@@ -651,24 +738,19 @@ void Arduino_GFX::drawArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float st
   {
     r2 = 1;
   }
-  bool equal = fabsf(start - end) < FLT_EPSILON;
-  start = fmodf(start, 360);
-  end = fmodf(end, 360);
-  if (start < 0)
-    start += 360.0;
-  if (end < 0)
-    end += 360.0;
+  int16_t s, e;
+  bool full = arc_angles(start, end, &s, &e);
 
   startWrite();
-  fillArcHelper(x, y, r1, r2, start, start, color);
-  fillArcHelper(x, y, r1, r2, end, end, color);
-  if (!equal && (fabsf(start - end) <= 0.0001))
+  fillArcSpans(x, y, r1, r2, s, s, color, false);
+  fillArcSpans(x, y, r1, r2, e, e, color, false);
+  if (full)
   {
-    start = .0;
-    end = 360.0;
+    s = 0;
+    e = 3600;
   }
-  fillArcHelper(x, y, r1, r1, start, end, color);
-  fillArcHelper(x, y, r2, r2, start, end, color);
+  fillArcSpans(x, y, r1, r1, s, e, color, false);
+  fillArcSpans(x, y, r2, r2, s, e, color, false);
   endWrite();
 }
 
@@ -698,21 +780,53 @@ void Arduino_GFX::fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float st
   {
     r2 = 1;
   }
-  bool equal = fabsf(start - end) < FLT_EPSILON;
-  start = fmodf(start, 360);
-  end = fmodf(end, 360);
-  if (start < 0)
-    start += 360.0;
-  if (end < 0)
-    end += 360.0;
-  if (!equal && (fabsf(start - end) <= 0.0001))
+  int16_t s, e;
+  if (arc_angles(start, end, &s, &e))
   {
-    start = .0;
-    end = 360.0;
+    s = 0;
+    e = 3600;
   }
 
   startWrite();
-  fillArcHelper(x, y, r1, r2, start, end, color);
+  fillArcSpans(x, y, r1, r2, s, e, color, false);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw an arc with filled color and anti-aliased round edges, partly covered pixels go through writePixelAlpha()
+  @param  x       Center-point x coordinate
+  @param  y       Center-point y coordinate
+  @param  r1      Outer radius of arc
+  @param  r2      Inner radius of arc
+  @param  start   degree of arc start
+  @param  end     degree of arc end
+  @param  color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void Arduino_GFX::fillArcAA(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color)
+{
+  if (r1 < r2)
+  {
+    _swap_int16_t(r1, r2);
+  }
+  if (r1 < 1)
+  {
+    r1 = 1;
+  }
+  if (r2 < 1)
+  {
+    r2 = 1;
+  }
+  int16_t s, e;
+  if (arc_angles(start, end, &s, &e))
+  {
+    s = 0;
+    e = 3600;
+  }
+
+  startWrite();
+  fillArcSpans(x, y, r1, r2, s, e, color, true);
   endWrite();
 }
 
@@ -822,6 +936,242 @@ void Arduino_GFX::fillArcHelper(int16_t cx, int16_t cy, int16_t oradius, int16_t
   } while (++y <= ye);
 }
 
+/**************************************************************************/
+/*!
+  @brief  Integer version of fillArcHelper(): each row is cut into spans from the ring bounds and the start/end edges, solved once per row from a sin table
+  @param  cx      Center-point x coordinate
+  @param  cy      Center-point y coordinate
+  @param  oradius Outer radius of arc
+  @param  iradius Inner radius of arc
+  @param  start   0.1 degree of arc start (0..3600)
+  @param  end     0.1 degree of arc end (0..3600)
+  @param  color   16-bit 5-6-5 Color to fill with
+  @param  aa      Blend the pixels on the outer and inner circle by coverage
+*/
+/**************************************************************************/
+void Arduino_GFX::fillArcSpans(int16_t cx, int16_t cy, int16_t oradius, int16_t iradius, int16_t start, int16_t end, uint16_t color, bool aa)
+{
+  if ((start == 900) || (start == 1800) || (start == 2700) || (start == 3600))
+  {
+    --start;
+  }
+
+  if ((end == 900) || (end == 1800) || (end == 2700) || (end == 3600))
+  {
+    --end;
+  }
+
+  // fillArcHelper() tests x <= (y + 0.5 / cos) * cos / sin, i.e. x <= (y * cos + 0.5) / sin
+  int32_t s_cos = arc_cos(start);
+  int32_t s_sin = arc_sin(start);
+  int32_t e_cos = arc_cos(end);
+  int32_t e_sin = arc_sin(end);
+  --iradius;
+  int32_t ir2 = iradius * iradius + iradius;
+  int32_t or2 = oradius * oradius + oradius;
+
+  // AA: scan one pixel further, full coverage only inside [ir2_full, or2_full)
+  int32_t edge_ir2 = ir2;
+  int32_t edge_or2 = or2;
+  int32_t ir2_full = ir2;
+  int32_t or2_full = or2;
+  int16_t scan_radius = oradius;
+  if (aa)
+  {
+    or2 += oradius + 1;
+    or2_full = edge_or2 - oradius;
+    if (iradius > 0)
+    {
+      ir2 -= iradius;
+      ir2_full = edge_ir2 + iradius + 1;
+    }
+    ++scan_radius;
+  }
+
+  bool start180 = !(start < 1800);
+  bool end180 = end < 1800;
+  bool reversed = start + 1800 < end || (end < start && start < end + 1800);
+
+  int32_t xs = -scan_radius;
+  int32_t y = -scan_radius;
+  int32_t ye = scan_radius;
+  int32_t xe = scan_radius + 1;
+  if (!reversed)
+  {
+    if ((end >= 2700 || end < 900) && (start >= 2700 || start < 900))
+    {
+      xs = 0;
+    }
+    else if (end < 2700 && end >= 900 && start < 2700 && start >= 900)
+    {
+      xe = 1;
+    }
+    if (end >= 1800 && start >= 1800)
+    {
+      ye = 0;
+    }
+    else if (end < 1800 && start < 1800)
+    {
+      y = 0;
+    }
+  }
+  // Columns the scan above may reach: xs == 0 drops the left half, xe == 1 the right half
+  int32_t x_min = xs;
+  int32_t x_max = (xe == 1) ? 0 : scan_radius;
+  int32_t limit = scan_radius + 1;
+
+  // |x| bounds of the ring on the current row, moved a few steps per row:
+  // ox is the last |x| inside or2, ix the first |x| outside ir2 (same for the full coverage AA ring)
+  int32_t ox = scan_radius;
+  int32_t ix = 0;
+  int32_t ox_full = scan_radius;
+  int32_t ix_full = 0;
+
+  int32_t s_num = y * s_cos + 32768; // 0.5 in Q16
+  int32_t e_num = y * e_cos - 32768;
+  do
+  {
+    int32_t y2 = y * y;
+    while ((ox >= 0) && (ox * ox + y2 >= or2))
+    {
+      --ox;
+    }
+    while ((ox + 1) * (ox + 1) + y2 < or2)
+    {
+      ++ox;
+    }
+    while ((ix > 0) && ((ix - 1) * (ix - 1) + y2 >= ir2))
+    {
+      --ix;
+    }
+    while (ix * ix + y2 < ir2)
+    {
+      ++ix;
+    }
+    if ((xs < 0) && (ox == 0))
+    {
+      // fillArcHelper() sets xe = 1 - x here, which then reads as "right half dropped" for the rest of the arc
+      x_max = 0;
+    }
+    if (aa)
+    {
+      while ((ox_full >= 0) && (ox_full * ox_full + y2 >= or2_full))
+      {
+        --ox_full;
+      }
+      while ((ox_full + 1) * (ox_full + 1) + y2 < or2_full)
+      {
+        ++ox_full;
+      }
+      while ((ix_full > 0) && ((ix_full - 1) * (ix_full - 1) + y2 >= ir2_full))
+      {
+        --ix_full;
+      }
+      while (ix_full * ix_full + y2 < ir2_full)
+      {
+        ++ix_full;
+      }
+    }
+
+    int32_t ysslope = s_sin ? arc_floor_div(s_num, s_sin) : ((s_num > 0) ? INT32_MAX : INT32_MIN);
+    int32_t yeslope = e_sin ? arc_floor_div(e_num, e_sin) : ((e_num > 0) ? INT32_MAX : INT32_MIN);
+    s_num += s_cos;
+    e_num += e_cos;
+    ysslope = (ysslope < -limit - 1) ? (-limit - 1) : ((ysslope > limit) ? limit : ysslope);
+    yeslope = (yeslope < -limit - 1) ? (-limit - 1) : ((yeslope > limit) ? limit : yeslope);
+
+    // flg1 of fillArcHelper() holds on [s_lo, s_hi], flg2 on [e_lo, e_hi]
+    int32_t s_lo = start180 ? ysslope + 1 : -limit;
+    int32_t s_hi = start180 ? limit : ysslope;
+    int32_t e_lo = end180 ? yeslope + 1 : -limit;
+    int32_t e_hi = end180 ? limit : yeslope;
+    int32_t span_lo[2];
+    int32_t span_hi[2];
+    int spans = 1;
+    if (!reversed)
+    {
+      span_lo[0] = (s_lo > e_lo) ? s_lo : e_lo;
+      span_hi[0] = (s_hi < e_hi) ? s_hi : e_hi;
+    }
+    else if ((s_lo <= e_hi + 1) && (e_lo <= s_hi + 1))
+    {
+      span_lo[0] = (s_lo < e_lo) ? s_lo : e_lo;
+      span_hi[0] = (s_hi > e_hi) ? s_hi : e_hi;
+    }
+    else
+    {
+      span_lo[0] = s_lo;
+      span_hi[0] = s_hi;
+      span_lo[1] = e_lo;
+      span_hi[1] = e_hi;
+      spans = 2;
+    }
+
+    for (int i = 0; i < spans; i++)
+    {
+      int32_t lo = span_lo[i];
+      int32_t hi = span_hi[i];
+      lo = (lo < x_min) ? x_min : lo;
+      lo = (lo < -ox) ? -ox : lo;
+      hi = (hi > x_max) ? x_max : hi;
+      hi = (hi > ox) ? ox : hi;
+
+      // Left and right of the inner circle
+      int32_t part_lo[2] = {lo, (ix > 0) ? ((lo > ix) ? lo : ix) : hi + 1};
+      int32_t part_hi[2] = {(ix > 0) ? ((hi < -ix) ? hi : -ix) : hi, hi};
+      for (int p = 0; p < 2; p++)
+      {
+        int32_t x = part_lo[p];
+        int32_t x_end = part_hi[p];
+        if (!aa)
+        {
+          if (x <= x_end)
+          {
+            writeFastHLine(cx + x, cy + y, x_end - x + 1, color);
+          }
+          continue;
+        }
+        while (x <= x_end)
+        {
+          int32_t ax = (x < 0) ? -x : x;
+          if ((ax <= ox_full) && (ax >= ix_full))
+          {
+            int32_t run = ((x < 0) && (ix_full > 0)) ? -ix_full : ox_full;
+            if (run > x_end)
+            {
+              run = x_end;
+            }
+            writeFastHLine(cx + x, cy + y, run - x + 1, color);
+            x = run + 1;
+            continue;
+          }
+
+          // 0.5 + distance to the circle, in 1/256 pixel
+          int32_t distance = x * x + y2;
+          int32_t coverage = 256;
+          if (distance >= or2_full)
+          {
+            coverage = 128 + ((edge_or2 - distance) * 256) / (2 * oradius + 1);
+          }
+          if (distance < ir2_full)
+          {
+            int32_t inner = 128 + ((distance - edge_ir2) * 256) / (2 * iradius + 1);
+            if (inner < coverage)
+            {
+              coverage = inner;
+            }
+          }
+          if (coverage > 0)
+          {
+            writePixelAlpha(cx + x, cy + y, color, coverage);
+          }
+          ++x;
+        }
+      }
+    }
+  } while (++y <= ye);
+}
+
 /**************************************************************************/
 /*!
   @brief  Draw a rectangle with no fill color
@@ -1870,9 +2220,6 @@ void Arduino_GFX::u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint1
   uint8_t current; /* number of pixels, which need to be drawn for the draw procedure */
   /* current is either equal to cnt or equal to rem */
 
-  /* target position on the screen */
-  uint16_t x, y;
-
   cnt = len;
 
   /* get the local position */
@@ -1893,41 +2240,13 @@ void Arduino_GFX::u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint1
 
     /* now draw the line, but apply the rotation around the glyph target position */
     // u8g2_font_decode_draw_pixel(u8g2, lx,ly,current, is_foreground);
-
-    if (textsize_x == 1 && textsize_y == 1)
+    u8g2_font_draw_run(lx, ly, current, is_foreground, color, bg);
+#if !defined(LITTLE_FOOT_PRINT)
+    if (_glyphRecording) // zero length runs too, they still draw with text_pixel_margin
     {
-      /* get target position */
-      x = _u8g2_target_x + lx;
-      y = _u8g2_target_y + ly;
-
-      /* draw foreground and background (if required) */
-      if (is_foreground)
-      {
-        writeFastHLine(x, y, current, color);
-      }
-      else if (bg != color)
-      {
-        writeFastHLine(x, y, current, bg);
-      }
-    }
-    else
-    {
-      /* get target position */
-      x = _u8g2_target_x + (lx * textsize_x);
-      y = _u8g2_target_y + (ly * textsize_y);
-
-      /* draw foreground and background (if required) */
-      if (is_foreground)
-      {
-        writeFillRect(x, y, (current * textsize_x) - text_pixel_margin,
-                      textsize_y - text_pixel_margin, color);
-      }
-      else if (bg != color)
-      {
-        writeFillRect(x, y, (current * textsize_x) - text_pixel_margin,
-                      textsize_y - text_pixel_margin, bg);
-      }
+      _glyphCache->addSpan(lx, ly, current, is_foreground);
     }
+#endif // !defined(LITTLE_FOOT_PRINT)
 
     /* check, whether the end of the run length code has been reached */
     if (cnt < rem)
@@ -1941,6 +2260,78 @@ void Arduino_GFX::u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint1
   _u8g2_dx = lx;
   _u8g2_dy = ly;
 }
+
+/**************************************************************************/
+/*!
+  @brief  Draw one run of a u8g2 glyph, relative to the glyph target position
+  @param  lx             Run start x inside the glyph, in font pixels
+  @param  ly             Run y inside the glyph, in font pixels
+  @param  len            Run length, in font pixels
+  @param  is_foreground  Foreground run, else background run
+  @param  color          16-bit 5-6-5 Color to draw foreground with
+  @param  bg             16-bit 5-6-5 Color to draw background with (if same as color, no background)
+*/
+/**************************************************************************/
+void Arduino_GFX::u8g2_font_draw_run(uint8_t lx, uint8_t ly, uint8_t len, uint8_t is_foreground, uint16_t color, uint16_t bg)
+{
+  /* target position on the screen */
+  uint16_t x, y;
+
+  if (textsize_x == 1 && textsize_y == 1)
+  {
+    /* get target position */
+    x = _u8g2_target_x + lx;
+    y = _u8g2_target_y + ly;
+
+    /* draw foreground and background (if required) */
+    if (is_foreground)
+    {
+      writeFastHLine(x, y, len, color);
+    }
+    else if (bg != color)
+    {
+      writeFastHLine(x, y, len, bg);
+    }
+  }
+  else
+  {
+    /* get target position */
+    x = _u8g2_target_x + (lx * textsize_x);
+    y = _u8g2_target_y + (ly * textsize_y);
+
+    /* draw foreground and background (if required) */
+    if (is_foreground)
+    {
+      writeFillRect(x, y, (len * textsize_x) - text_pixel_margin,
+                    textsize_y - text_pixel_margin, color);
+    }
+    else if (bg != color)
+    {
+      writeFillRect(x, y, (len * textsize_x) - text_pixel_margin,
+                    textsize_y - text_pixel_margin, bg);
+    }
+  }
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+  @brief  Store the runs recorded since beginGlyph() and the current u8g2 glyph header in the glyph cache
+*/
+/**************************************************************************/
+void Arduino_GFX::cacheU8g2Glyph()
+{
+  GlyphCacheEntry *e = _glyphCache->commitGlyph(u8g2Font, _encoding);
+  if (e)
+  {
+    e->width = _u8g2_char_width;
+    e->height = _u8g2_char_height;
+    e->x = _u8g2_char_x;
+    e->y = _u8g2_char_y;
+    e->delta_x = _u8g2_delta_x;
+  }
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
 #endif // defined(U8G2_FONT_SUPPORT)
 
 // TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
@@ -2008,8 +2399,46 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     {
       writeFillRect(x, y - (baseline * textsize_y), block_w, block_h, bg);
     }
+#if !defined(LITTLE_FOOT_PRINT)
+    GlyphCacheEntry *cached = _glyphCache ? _glyphCache->find(gfxFont, c) : nullptr;
+    if (cached)
+    {
+      // replay the runs decoded by a previous call
+      GlyphSpan *span = cached->spans;
+      for (uint16_t i = 0; i < cached->span_count; i++, span++)
+      {
+        if (textsize_x == 1 && textsize_y == 1)
+        {
+          writeFastHLine(x + xo16 + span->x, y + yo16 + span->y, span->len, color);
+        }
+        else if (text_pixel_margin == 0)
+        {
+          writeFillRect(x + (xo16 + span->x) * textsize_x, y + (yo16 + span->y) * textsize_y,
+                        span->len * textsize_x, textsize_y, color);
+        }
+        else
+        {
+          for (xx = span->x; xx < span->x + span->len; xx++)
+          {
+            writeFillRect(x + (xo16 + xx) * textsize_x, y + (yo16 + span->y) * textsize_y,
+                          textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
+          }
+        }
+      }
+      endWrite();
+      return;
+    }
+    if (_glyphCache)
+    {
+      _glyphCache->beginGlyph();
+    }
+    int16_t run_x;
+#endif // !defined(LITTLE_FOOT_PRINT)
     for (yy = 0; yy < h; yy++)
     {
+#if !defined(LITTLE_FOOT_PRINT)
+      run_x = -1;
+#endif // !defined(LITTLE_FOOT_PRINT)
       for (xx = 0; xx < w; xx++)
       {
         if (!(bit++ & 7))
@@ -2027,10 +2456,36 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
             writeFillRect(x + (xo16 + xx) * textsize_x, y + (yo16 + yy) * textsize_y,
                           textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
           }
+#if !defined(LITTLE_FOOT_PRINT)
+          if (run_x < 0)
+          {
+            run_x = xx;
+          }
+        }
+        else if (run_x >= 0)
+        {
+          if (_glyphCache)
+          {
+            _glyphCache->addSpan(run_x, yy, xx - run_x, true);
+          }
+          run_x = -1;
+#endif // !defined(LITTLE_FOOT_PRINT)
         }
         bits <<= 1;
       }
+#if !defined(LITTLE_FOOT_PRINT)
+      if ((run_x >= 0) && _glyphCache)
+      {
+        _glyphCache->addSpan(run_x, yy, w - run_x, true);
+      }
+#endif // !defined(LITTLE_FOOT_PRINT)
     }
+#if !defined(LITTLE_FOOT_PRINT)
+    if (_glyphCache)
+    {
+      _glyphCache->commitGlyph(gfxFont, c);
+    }
+#endif // !defined(LITTLE_FOOT_PRINT)
     endWrite();
   }
   else // 'Classic' built-in font
@@ -2038,6 +2493,23 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 #if defined(U8G2_FONT_SUPPORT)
       if (u8g2Font)
   {
+#if !defined(LITTLE_FOOT_PRINT)
+    if ((_glyphCached) && (_u8g2_char_width > 0))
+    {
+      _u8g2_target_x = x + (_u8g2_char_x * textsize_x);
+      _u8g2_target_y = y - ((_u8g2_char_height + _u8g2_char_y) * textsize_y);
+
+      /* replay the runs decoded by a previous call */
+      GlyphSpan *span = _glyphCached->spans;
+      startWrite();
+      for (uint16_t i = 0; i < _glyphCached->span_count; i++, span++)
+      {
+        u8g2_font_draw_run(span->x, span->y, span->len, span->fg, color, bg);
+      }
+      endWrite();
+    }
+    else
+#endif // !defined(LITTLE_FOOT_PRINT)
     if ((_u8g2_decode_ptr) && (_u8g2_char_width > 0))
     {
       uint8_t a, b;
@@ -2049,6 +2521,13 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       /* reset local x/y position */
       _u8g2_dx = 0;
       _u8g2_dy = 0;
+#if !defined(LITTLE_FOOT_PRINT)
+      if (_glyphCache)
+      {
+        _glyphCache->beginGlyph();
+        _glyphRecording = true;
+      }
+#endif // !defined(LITTLE_FOOT_PRINT)
       /* decode glyph */
       startWrite();
       for (;;)
@@ -2066,6 +2545,13 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
           break;
       }
       endWrite();
+#if !defined(LITTLE_FOOT_PRINT)
+      if (_glyphRecording)
+      {
+        _glyphRecording = false;
+        cacheU8g2Glyph();
+      }
+#endif // !defined(LITTLE_FOOT_PRINT)
     }
   }
   else // glcdfont
@@ -2084,6 +2570,43 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     }
 
     startWrite();
+    if ((text_pixel_margin == 0) || (textsize_x == 1 && textsize_y == 1))
+    {
+      // one call per horizontal run of the same color instead of one per pixel
+      uint8_t col[6];
+      for (int8_t i = 0; i < 5; i++)
+      {
+        col[i] = pgm_read_byte(&font[c * 5 + i]);
+      }
+      col[5] = 0; // last column always background
+      for (int8_t j = 0; j < 8; j++)
+      {
+        int8_t i = 0;
+        while (i < 6)
+        {
+          bool draw_dot = col[i] & (1 << j);
+          int8_t run = i + 1;
+          while ((run < 6) && (((col[run] & (1 << j)) != 0) == draw_dot))
+          {
+            run++;
+          }
+          if (textsize_x == 1 && textsize_y == 1)
+          {
+            if (draw_dot || (bg != color))
+            {
+              writeFastHLine(x + i, y + j, run - i, draw_dot ? color : bg);
+            }
+          }
+          else if (draw_dot || (bg != color))
+          {
+            writeFillRect(x + i * textsize_x, y + j * textsize_y, (run - i) * textsize_x, textsize_y, draw_dot ? color : bg);
+          }
+          i = run;
+        }
+      }
+      endWrite();
+      return;
+    }
     for (int8_t i = 0; i < 5; i++)
     { // Char bitmap = 5 columns
       uint8_t line = pgm_read_byte(&font[c * 5 + i]);
@@ -2179,6 +2702,9 @@ size_t Arduino_GFX::write(uint8_t c)
       if (u8g2Font)
   {
     _u8g2_decode_ptr = 0;
+#if !defined(LITTLE_FOOT_PRINT)
+    _glyphCached = nullptr;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
     if (_enableUTF8Print)
     {
@@ -2239,6 +2765,18 @@ size_t Arduino_GFX::write(uint8_t c)
 
         // extract from u8g2_font_get_glyph_data()
         font += 23; // U8G2_FONT_DATA_STRUCT_SIZE
+#if !defined(LITTLE_FOOT_PRINT)
+        if (_glyphCache && (_glyphCached = _glyphCache->find(u8g2Font, _encoding)))
+        {
+          // glyph header from cache, skip the glyph table walk
+          _u8g2_char_width = _glyphCached->width;
+          _u8g2_char_height = _glyphCached->height;
+          _u8g2_char_x = _glyphCached->x;
+          _u8g2_char_y = _glyphCached->y;
+          _u8g2_delta_x = _glyphCached->delta_x;
+        }
+        else
+#endif // !defined(LITTLE_FOOT_PRINT)
         if (_encoding <= 255)
         {
           if (_encoding >= 'a')
@@ -2306,7 +2844,18 @@ size_t Arduino_GFX::write(uint8_t c)
           _u8g2_delta_x = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_delta_x);
           // log_d("c: %c, _encoding: %d, _u8g2_char_width: %d, _u8g2_char_height: %d, _u8g2_char_x: %d, _u8g2_char_y: %d, _u8g2_delta_x: %d",
           //       c, _encoding, _u8g2_char_width, _u8g2_char_height, _u8g2_char_x, _u8g2_char_y, _u8g2_delta_x);
+#if !defined(LITTLE_FOOT_PRINT)
+          if (_glyphCache && (_u8g2_char_width == 0))
+          {
+            // nothing to decode (e.g. space), cache the advance only
+            _glyphCache->beginGlyph();
+            cacheU8g2Glyph();
+          }
+        }
 
+        if (glyph_data || _glyphCached)
+        {
+#endif // !defined(LITTLE_FOOT_PRINT)
           if (_u8g2_char_width > 0)
           {
             if (wrap && ((cursor_x + (textsize_x * _u8g2_char_width) - 1) > _max_x))
@@ -2429,6 +2978,20 @@ void Arduino_GFX::setFont(const GFXfont *f)
 #endif // defined(U8G2_FONT_SUPPORT)
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+  @brief  Use a glyph cache for u8g2 and GFXfont text, glyphs are decoded once and replayed as runs after
+  @param  cache   The glyph cache, may be shared between displays, if NULL decode every glyph every time
+*/
+/**************************************************************************/
+void Arduino_GFX::setGlyphCache(Arduino_GlyphCache *cache)
+{
+  _glyphCache = cache;
+  _glyphCached = nullptr;
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 /**************************************************************************/
 /*!
   @brief  flush framebuffer to output (for Canvas or NeoPixel sub-class)
@@ -160,6 +160,9 @@ INLINE uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont)
 }
 #endif // !defined(ATTINY_CORE)
 
+class Arduino_GlyphCache;
+struct GlyphCacheEntry;
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a minimum you can subclass and provide drawPixel(). At a maximum you can do a ton of overriding to optimize. Used for any/all Adafruit displays!
 #if defined(LITTLE_FOOT_PRINT)
 class Arduino_GFX : public Print
@@ -182,6 +185,7 @@ public:
   virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
   virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  virtual void writePixelAlpha(int16_t x, int16_t y, uint16_t color, uint8_t alpha);
   virtual void endWrite(void);
 
   // CONTROL API
@@ -235,7 +239,11 @@ public:
   uint8_t u8g2_font_decode_get_unsigned_bits(uint8_t cnt);
   int8_t u8g2_font_decode_get_signed_bits(uint8_t cnt);
   void u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint16_t color, uint16_t bg);
+  void u8g2_font_draw_run(uint8_t lx, uint8_t ly, uint8_t len, uint8_t is_foreground, uint16_t color, uint16_t bg);
 #endif // defined(U8G2_FONT_SUPPORT)
+#if !defined(LITTLE_FOOT_PRINT)
+  void setGlyphCache(Arduino_GlyphCache *cache);
+#endif // !defined(LITTLE_FOOT_PRINT)
   virtual void flush(void);
 #endif // !defined(ATTINY_CORE)
 
@@ -246,7 +254,9 @@ public:
   void fillEllipseHelper(int32_t x, int32_t y, int32_t rx, int32_t ry, uint8_t cornername, int16_t delta, uint16_t color);
   void drawArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
   void fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
+  void fillArcAA(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
   void fillArcHelper(int16_t cx, int16_t cy, int16_t oradius, int16_t iradius, float start, float end, uint16_t color);
+  void fillArcSpans(int16_t cx, int16_t cy, int16_t oradius, int16_t iradius, int16_t start, int16_t end, uint16_t color, bool aa);
 
 // TFT optimization code, too big for ATMEL family
 #if defined(LITTLE_FOOT_PRINT)
@@ -391,6 +401,9 @@ public:
 
 protected:
   void charBounds(char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy);
+#if defined(U8G2_FONT_SUPPORT) && !defined(LITTLE_FOOT_PRINT)
+  void cacheU8g2Glyph();
+#endif // defined(U8G2_FONT_SUPPORT) && !defined(LITTLE_FOOT_PRINT)
   int16_t
       _width,   ///< Display width as modified by current rotation
       _height,  ///< Display height as modified by current rotation
@@ -448,6 +461,12 @@ protected:
   uint8_t _u8g2_decode_bit_pos;
 #endif // defined(U8G2_FONT_SUPPORT)
 
+#if !defined(LITTLE_FOOT_PRINT)
+  Arduino_GlyphCache *_glyphCache = nullptr; ///< Decoded glyph cache, nullptr: decode every time
+  GlyphCacheEntry *_glyphCached = nullptr;   ///< u8g2 glyph found in cache by write()
+  bool _glyphRecording = false;              ///< u8g2_font_decode_len() also records runs
+#endif                                       // !defined(LITTLE_FOOT_PRINT)
+
 #if defined(LITTLE_FOOT_PRINT)
   int16_t
       WIDTH,  ///< This is the 'raw' display width - never changes
@@ -22,6 +22,7 @@
 #include "databus/Arduino_ESP32SPI.h"
 #include "databus/Arduino_ESP32SPIDMA.h"
 #include "databus/Arduino_ESP8266SPI.h"
+#include "databus/Arduino_HostFramebuffer.h"
 #include "databus/Arduino_HWSPI.h"
 #include "databus/Arduino_mbedSPI.h"
 #include "databus/Arduino_NRFXSPI.h"
@@ -37,6 +38,7 @@
 
 #include "Arduino_GFX.h" // Core graphics library
 #if !defined(LITTLE_FOOT_PRINT)
+#include "Arduino_GlyphCache.h"
 #include "canvas/Arduino_Canvas.h"
 #include "canvas/Arduino_Canvas_Indexed.h"
 #include "canvas/Arduino_Canvas_3bit.h"
@@ -0,0 +1,144 @@
+#include "Arduino_GlyphCache.h"
+
+static void *glyph_cache_alloc(size_t s)
+{
+#if defined(ESP32)
+  if (psramFound())
+  {
+    return ps_malloc(s);
+  }
+#endif
+  return malloc(s);
+}
+
+Arduino_GlyphCache::Arduino_GlyphCache(uint16_t entries)
+{
+  _entries = (GlyphCacheEntry *)calloc(entries, sizeof(GlyphCacheEntry));
+  if (_entries)
+  {
+    _entry_count = entries;
+  }
+}
+
+Arduino_GlyphCache::~Arduino_GlyphCache()
+{
+  clear();
+  free(_entries);
+  free(_scratch);
+}
+
+GlyphCacheEntry *Arduino_GlyphCache::find(const void *font, uint16_t code)
+{
+  for (uint16_t i = 0; i < _entry_count; i++)
+  {
+    GlyphCacheEntry *e = &_entries[i];
+    if ((e->font == font) && (e->code == code))
+    {
+      e->last_used = ++_tick;
+      ++_hits;
+      return e;
+    }
+  }
+  ++_misses;
+  return nullptr;
+}
+
+void Arduino_GlyphCache::beginGlyph()
+{
+  _scratch_count = 0;
+  _scratch_overflow = false;
+}
+
+void Arduino_GlyphCache::addSpan(uint8_t x, uint8_t y, uint8_t len, bool fg)
+{
+  if (_scratch_count == _scratch_size)
+  {
+    uint16_t size = _scratch_size ? (_scratch_size * 2) : 64;
+    GlyphSpan *s = (GlyphSpan *)realloc(_scratch, size * sizeof(GlyphSpan));
+    if (!s)
+    {
+      _scratch_overflow = true;
+      return;
+    }
+    _scratch = s;
+    _scratch_size = size;
+  }
+  GlyphSpan *s = &_scratch[_scratch_count++];
+  s->x = x;
+  s->y = y;
+  s->len = len;
+  s->fg = fg;
+}
+
+GlyphCacheEntry *Arduino_GlyphCache::commitGlyph(const void *font, uint16_t code)
+{
+  if (_scratch_overflow || (!_entry_count))
+  {
+    return nullptr;
+  }
+
+  // Free entry, else the least recently used one
+  GlyphCacheEntry *e = &_entries[0];
+  for (uint16_t i = 0; i < _entry_count; i++)
+  {
+    if (!_entries[i].font)
+    {
+      e = &_entries[i];
+      break;
+    }
+    if (_entries[i].last_used < e->last_used)
+    {
+      e = &_entries[i];
+    }
+  }
+  if (e->spans)
+  {
+    free(e->spans);
+    _span_bytes -= e->span_count * sizeof(GlyphSpan);
+  }
+  e->font = nullptr;
+  e->spans = nullptr;
+  e->span_count = 0;
+
+  if (_scratch_count)
+  {
+    size_t s = _scratch_count * sizeof(GlyphSpan);
+    e->spans = (GlyphSpan *)glyph_cache_alloc(s);
+    if (!e->spans)
+    {
+      return nullptr;
+    }
+    memcpy(e->spans, _scratch, s);
+    e->span_count = _scratch_count;
+    _span_bytes += s;
+  }
+  e->font = font;
+  e->code = code;
+  e->last_used = ++_tick;
+  return e;
+}
+
+void Arduino_GlyphCache::clear()
+{
+  for (uint16_t i = 0; i < _entry_count; i++)
+  {
+    free(_entries[i].spans);
+    memset(&_entries[i], 0, sizeof(GlyphCacheEntry));
+  }
+  _span_bytes = 0;
+}
+
+uint32_t Arduino_GlyphCache::getHits()
+{
+  return _hits;
+}
+
+uint32_t Arduino_GlyphCache::getMisses()
+{
+  return _misses;
+}
+
+uint32_t Arduino_GlyphCache::getSpanBytes()
+{
+  return _span_bytes;
+}
@@ -0,0 +1,75 @@
+#ifndef _ARDUINO_GLYPHCACHE_H_
+#define _ARDUINO_GLYPHCACHE_H_
+
+#include <Arduino.h>
+
+#ifndef GLYPH_CACHE_ENTRIES
+#define GLYPH_CACHE_ENTRIES 64
+#endif
+
+/// One horizontal run of a decoded glyph, in font pixels (before text size)
+struct GlyphSpan
+{
+  uint8_t x;
+  uint8_t y;
+  uint8_t len;
+  uint8_t fg; ///< 0: background run (u8g2 fonts only)
+};
+
+struct GlyphCacheEntry
+{
+  const void *font; ///< nullptr: free entry
+  uint16_t code;
+  uint32_t last_used;
+
+  // u8g2 glyph header, so print() can skip the glyph table walk
+  uint8_t width;
+  uint8_t height;
+  int8_t x;
+  int8_t y;
+  int8_t delta_x;
+
+  uint16_t span_count;
+  GlyphSpan *spans;
+};
+
+/// LRU cache of decoded glyphs shared by any number of Arduino_GFX (see Arduino_GFX::setGlyphCache).
+/// The first draw of a glyph records its runs while drawing as usual; later draws replay the runs
+/// with writeFastHLine() / writeFillRect(), scaled by the current text size.
+class Arduino_GlyphCache
+{
+public:
+  Arduino_GlyphCache(uint16_t entries = GLYPH_CACHE_ENTRIES);
+  ~Arduino_GlyphCache();
+
+  GlyphCacheEntry *find(const void *font, uint16_t code);
+
+  // Recording a glyph: beginGlyph(), addSpan() per run, then commitGlyph()
+  void beginGlyph();
+  void addSpan(uint8_t x, uint8_t y, uint8_t len, bool fg);
+  GlyphCacheEntry *commitGlyph(const void *font, uint16_t code);
+
+  void clear();
+
+  uint32_t getHits();
+  uint32_t getMisses();
+  uint32_t getSpanBytes();
+
+protected:
+  GlyphCacheEntry *_entries = nullptr;
+  uint16_t _entry_count = 0;
+  uint32_t _tick = 0;
+
+  GlyphSpan *_scratch = nullptr;
+  uint16_t _scratch_size = 0;
+  uint16_t _scratch_count = 0;
+  bool _scratch_overflow = false;
+
+  uint32_t _hits = 0;
+  uint32_t _misses = 0;
+  uint32_t _span_bytes = 0;
+
+private:
+};
+
+#endif // _ARDUINO_GLYPHCACHE_H_
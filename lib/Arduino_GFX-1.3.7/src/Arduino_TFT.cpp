@@ -610,6 +610,41 @@ void Arduino_TFT::draw16bitRGBBitmap(
     }
 }
 
+void Arduino_TFT::draw16bitRGBBitmapStride(
+    int16_t x, int16_t y,
+    uint16_t *bitmap, int16_t w, int16_t h, int16_t x_skip)
+{
+    if (
+        (x < 0) ||                // Clip left
+        (y < 0) ||                // Clip top
+        ((x + w - 1) > _max_x) || // Clip right
+        ((y + h - 1) > _max_y)    // Clip bottom
+    )
+    {
+        Arduino_G::draw16bitRGBBitmapStride(x, y, bitmap, w, h, x_skip);
+    }
+    else
+    {
+        // One address window for the whole region, then each row streams
+        // into it back to back
+        startWrite();
+        writeAddrWindow(x, y, w, h);
+        if (x_skip == 0)
+        {
+            _bus->writePixels(bitmap, (uint32_t)w * h);
+        }
+        else
+        {
+            while (h--)
+            {
+                _bus->writePixels(bitmap, w);
+                bitmap += w + x_skip;
+            }
+        }
+        endWrite();
+    }
+}
+
 void Arduino_TFT::draw16bitBeRGBBitmap(
     int16_t x, int16_t y,
     uint16_t *bitmap, int16_t w, int16_t h)
@@ -854,27 +889,40 @@ void Arduino_TFT::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color
             }
             else // (bg == color), no background color
             {
+                // one address window per horizontal run of dots instead of per dot
+                bool merge = (text_pixel_margin == 0) || (textsize_x == 1 && textsize_y == 1);
+                int16_t gx = (textsize_x == 1 && textsize_y == 1) ? (x + xo) : (x + xo16 * textsize_x);
+                int16_t gy = y + yo16 * textsize_y;
                 for (yy = 0; yy < h; yy++)
                 {
-                    for (xx = 0; xx < w; xx++)
+                    int16_t run_x = -1;
+                    for (int16_t dx = 0; dx <= w; dx++)
                     {
-                        if (!(bit++ & 7))
-                        {
-                            bits = pgm_read_byte(&bitmap[bo++]);
-                        }
-                        if (bits & 0x80)
+                        bool draw_dot = false;
+                        if (dx < w)
                         {
-                            if (textsize_x == 1 && textsize_y == 1)
+                            if (!(bit++ & 7))
                             {
-                                writePixelPreclipped(x + xo + xx, y + yo + yy, color);
-                            }
-                            else
-                            {
-                                writeFillRectPreclipped(x + (xo16 + xx) * textsize_x, y + (yo16 + yy) * textsize_y,
-                                                        textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
+                                bits = pgm_read_byte(&bitmap[bo++]);
                             }
+                            draw_dot = bits & 0x80;
+                            bits <<= 1;
+                        }
+                        if (draw_dot && !merge)
+                        {
+                            writeFillRectPreclipped(gx + dx * textsize_x, gy + yy * textsize_y,
+                                                    textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
+                        }
+                        else if (draw_dot && (run_x < 0))
+                        {
+                            run_x = dx;
+                        }
+                        else if (!draw_dot && (run_x >= 0))
+                        {
+                            writeFillRectPreclipped(gx + run_x * textsize_x, gy + yy * textsize_y,
+                                                    (dx - run_x) * textsize_x, textsize_y, color);
+                            run_x = -1;
                         }
-                        bits <<= 1;
                     }
                 }
             }
@@ -981,21 +1029,26 @@ void Arduino_TFT::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color
             }
             else // (bg == color), no background color
             {
-                for (int8_t i = 0; i < 5; i++)
-                { // Char bitmap = 5 columns
-                    uint8_t line = col[i];
-                    for (int8_t j = 0; j < 8; j++, line >>= 1)
+                // one address window per horizontal run of dots instead of per dot
+                bool merge = (text_pixel_margin == 0) || (textsize_x == 1 && textsize_y == 1);
+                for (int8_t j = 0; j < 8; j++)
+                {
+                    int8_t run_x = -1;
+                    for (int8_t i = 0; i <= 5; i++)
                     {
-                        if (line & 1)
+                        bool draw_dot = (i < 5) && (col[i] & (1 << j));
+                        if (draw_dot && !merge)
                         {
-                            if (textsize_x == 1 && textsize_y == 1)
-                            {
-                                writePixelPreclipped(x + i, y + j, color);
-                            }
-                            else
-                            {
-                                writeFillRectPreclipped(x + i * textsize_x, y + j * textsize_y, textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
-                            }
+                            writeFillRectPreclipped(x + i * textsize_x, y + j * textsize_y, textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
+                        }
+                        else if (draw_dot && (run_x < 0))
+                        {
+                            run_x = i;
+                        }
+                        else if (!draw_dot && (run_x >= 0))
+                        {
+                            writeFillRectPreclipped(x + run_x * textsize_x, y + j * textsize_y, (i - run_x) * textsize_x, textsize_y, color);
+                            run_x = -1;
                         }
                     }
                 }
@@ -1005,4 +1058,260 @@ void Arduino_TFT::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color
     }
 }
 
+// print() path: runs of opaque glcdfont / GFXfont characters go out as one address window
+// with one writePixels() per pixel row, anything else through write(uint8_t)
+size_t Arduino_TFT::write(const uint8_t *buffer, size_t size)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        int16_t run_w;
+        size_t len = textRunLength(buffer + i, size - i, &run_w);
+        if (len > 1)
+        {
+            drawTextRun(buffer + i, len, run_w);
+            i += len;
+        }
+        else
+        {
+            write(buffer[i++]);
+        }
+    }
+    return size;
+}
+
+// Number of characters from the start of buffer that drawTextRun() can draw: opaque text,
+// every character box fully on screen and no wrap or newline in between, at most
+// TFT_TEXT_RUN_MAX_CHARS characters and TFT_TEXT_RUN_MAX_W pixels (write() sends the rest as
+// further runs)
+size_t Arduino_TFT::textRunLength(const uint8_t *buffer, size_t size, int16_t *run_w)
+{
+    *run_w = 0;
+    if (textbgcolor == textcolor)
+    {
+        return 0;
+    }
+#if defined(U8G2_FONT_SUPPORT)
+    if (u8g2Font)
+    {
+        return 0;
+    }
+#endif // defined(U8G2_FONT_SUPPORT)
+
+    int16_t x = cursor_x;
+    size_t len = 0;
+#if !defined(ATTINY_CORE)
+    if (gfxFont)
+    {
+        uint8_t first = pgm_read_byte(&gfxFont->first),
+                last = pgm_read_byte(&gfxFont->last),
+                yAdvance = pgm_read_byte(&gfxFont->yAdvance),
+                baseline = yAdvance * 2 / 3;
+        int16_t y = cursor_y - (baseline * textsize_y);
+        int16_t block_h = yAdvance * textsize_y;
+        if ((y < 0) || ((y + block_h - 1) > _max_y))
+        {
+            return 0;
+        }
+        // drawChar() clips against the unscaled baseline, keep its partial draws as they are
+        if (((cursor_y - baseline) < 0) || ((cursor_y - baseline + block_h - 1) > _max_y))
+        {
+            return 0;
+        }
+        for (; len < size; len++)
+        {
+            uint8_t c = buffer[len];
+            if ((c == '\n') || (c == '\r') || (c < first) || (c > last))
+            {
+                break;
+            }
+            GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+            uint8_t w = pgm_read_byte(&glyph->width),
+                    xAdvance = pgm_read_byte(&glyph->xAdvance);
+            int8_t xo = pgm_read_byte(&glyph->xOffset);
+            // drawChar() shifts or widens these boxes, leave them to it
+            if ((xo < 0) || (xAdvance < w))
+            {
+                break;
+            }
+            if (wrap && ((x + ((xo + w) * textsize_x) - 1) > _max_x))
+            {
+                break;
+            }
+            if ((x < 0) || ((x + (xAdvance * textsize_x) - 1) > _max_x))
+            {
+                break;
+            }
+            if ((len == TFT_TEXT_RUN_MAX_CHARS) || ((x - cursor_x + (xAdvance * textsize_x)) > TFT_TEXT_RUN_MAX_W))
+            {
+                break;
+            }
+            x += xAdvance * textsize_x;
+        }
+    }
+    else // not gfxFont
+#endif   // !defined(ATTINY_CORE)
+    {
+        if ((cursor_y < 0) || ((cursor_y + (8 * textsize_y) - 1) > _max_y))
+        {
+            return 0;
+        }
+        for (; len < size; len++)
+        {
+            uint8_t c = buffer[len];
+            // a box on screen is also a box write() would not wrap
+            if ((c == '\n') || (c == '\r') || (x < 0) || ((x + (6 * textsize_x) - 1) > _max_x))
+            {
+                break;
+            }
+            if ((len == TFT_TEXT_RUN_MAX_CHARS) || ((x - cursor_x + (6 * textsize_x)) > TFT_TEXT_RUN_MAX_W))
+            {
+                break;
+            }
+            x += 6 * textsize_x;
+        }
+    }
+    *run_w = x - cursor_x;
+    return len;
+}
+
+// Same pixels as drawChar() with background for each character, rasterized a whole pixel
+// row of the run at a time. textRunLength() keeps runs within the fixed-size buffers
+void Arduino_TFT::drawTextRun(const uint8_t *buffer, size_t len, int16_t run_w)
+{
+    uint16_t line_buf[TFT_TEXT_RUN_MAX_W];
+
+    startWrite();
+#if !defined(ATTINY_CORE)
+    if (gfxFont)
+    {
+        uint8_t first = pgm_read_byte(&gfxFont->first),
+                yAdvance = pgm_read_byte(&gfxFont->yAdvance),
+                baseline = yAdvance * 2 / 3;
+        uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont);
+
+        // glyph headers read once for all the pixel rows
+        struct
+        {
+            uint32_t bit;
+            uint8_t w, xAdvance;
+            int8_t xo;
+            int16_t top, bottom;
+        } glyphs[TFT_TEXT_RUN_MAX_CHARS];
+        for (size_t n = 0; n < len; n++)
+        {
+            GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, buffer[n] - first);
+            uint8_t w = pgm_read_byte(&glyph->width),
+                    h = pgm_read_byte(&glyph->height),
+                    xAdvance = pgm_read_byte(&glyph->xAdvance);
+            int8_t xo = pgm_read_byte(&glyph->xOffset),
+                   yo = pgm_read_byte(&glyph->yOffset);
+            if ((xo + w) > xAdvance) // same padding as drawChar()
+            {
+                xo = xAdvance - w;
+            }
+            // drawChar() reads the rows in order from the first one inside the box
+            int16_t top = baseline + yo;
+            glyphs[n].bit = ((uint32_t)pgm_read_word(&glyph->bitmapOffset) << 3) - (((top < 0) ? 0 : top) * w);
+            glyphs[n].w = w;
+            glyphs[n].xAdvance = xAdvance;
+            glyphs[n].xo = xo;
+            glyphs[n].top = top;
+            glyphs[n].bottom = top + h;
+        }
+
+        writeAddrWindow(cursor_x, cursor_y - (baseline * textsize_y), run_w, yAdvance * textsize_y);
+        for (int16_t yy = 0; yy < yAdvance; yy++)
+        {
+            uint16_t *p = line_buf;
+            bool blank = true;
+            for (size_t n = 0; n < len; n++)
+            {
+                uint8_t xo = glyphs[n].xo;
+                uint8_t w = (yy >= glyphs[n].top) && (yy < glyphs[n].bottom) ? glyphs[n].w : 0;
+                uint32_t bit = glyphs[n].bit + (yy * glyphs[n].w);
+                for (uint8_t xx = 0; xx < glyphs[n].xAdvance; xx++)
+                {
+                    bool draw_dot = false;
+                    if ((xx >= xo) && (xx < (xo + w)))
+                    {
+                        uint32_t b = bit + (xx - xo);
+                        draw_dot = pgm_read_byte(&bitmap[b >> 3]) & (0x80 >> (b & 7));
+                    }
+                    blank &= !draw_dot;
+                    p = fillTextDot(p, draw_dot);
+                }
+            }
+            writeTextLine(line_buf, run_w, blank);
+        }
+    }
+    else // not gfxFont
+#endif   // !defined(ATTINY_CORE)
+    {
+        // 5 columns + 1 column gap per character, bit j is pixel row j
+        uint8_t cols[TFT_TEXT_RUN_MAX_CHARS * 6];
+        for (size_t n = 0; n < len; n++)
+        {
+            for (uint8_t i = 0; i < 5; i++)
+            {
+                cols[n * 6 + i] = pgm_read_byte(&font[buffer[n] * 5 + i]);
+            }
+            cols[n * 6 + 5] = 0;
+        }
+
+        writeAddrWindow(cursor_x, cursor_y, run_w, 8 * textsize_y);
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            uint16_t *p = line_buf;
+            uint8_t mask = 0;
+            for (size_t i = 0; i < len * 6; i++)
+            {
+                uint8_t draw_dot = cols[i] & (1 << j);
+                mask |= draw_dot;
+                p = fillTextDot(p, draw_dot);
+            }
+            writeTextLine(line_buf, run_w, !mask);
+        }
+    }
+    endWrite();
+
+    cursor_x += run_w;
+}
+
+// textsize_x entries of a line buffer for one font dot, the margin columns in background
+uint16_t *Arduino_TFT::fillTextDot(uint16_t *p, bool draw_dot)
+{
+    if (textsize_x == 1)
+    {
+        *p++ = draw_dot ? textcolor : textbgcolor;
+        return p;
+    }
+    for (uint8_t k = 0; k < textsize_x; k++)
+    {
+        *p++ = (draw_dot && (k < (textsize_x - text_pixel_margin))) ? textcolor : textbgcolor;
+    }
+    return p;
+}
+
+// One text pixel row: textsize_y copies of line_buf, the margin rows in background
+void Arduino_TFT::writeTextLine(uint16_t *line_buf, uint16_t w, bool blank)
+{
+    if (blank)
+    {
+        writeRepeat(textbgcolor, (uint32_t)w * textsize_y);
+        return;
+    }
+    for (uint8_t l = 0; l < textsize_y; l++)
+    {
+        if ((textsize_y > 1) && (l >= (textsize_y - text_pixel_margin)))
+        {
+            writeRepeat(textbgcolor, w);
+        }
+        else
+        {
+            writePixels(line_buf, w);
+        }
+    }
+}
+
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -8,6 +8,14 @@
 #include "Arduino_DataBus.h"
 #include "Arduino_GFX.h"
 
+// Widest text run (in pixels, textsize included) print() sends as one address window; longer
+// runs go out in chunks. Sizes the line buffer drawTextRun() keeps on the stack
+#ifndef TFT_TEXT_RUN_MAX_W
+#define TFT_TEXT_RUN_MAX_W 320
+#endif
+// Characters per run, bounds the per-character tables of drawTextRun()
+#define TFT_TEXT_RUN_MAX_CHARS (TFT_TEXT_RUN_MAX_W / 6)
+
 class Arduino_TFT : public Arduino_GFX
 {
 public:
@@ -51,15 +59,26 @@ public:
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, uint8_t *mask, int16_t w, int16_t h) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void draw16bitRGBBitmapStride(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h, int16_t x_skip) override;
   void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
   void draw24bitRGBBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h) override;
   void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) override;
   void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg) override;
+
+  using Arduino_GFX::write;
+  size_t write(const uint8_t *buffer, size_t size) override;
 #endif // !defined(LITTLE_FOOT_PRINT)
 
 protected:
   virtual void tftInit() = 0;
 
+#if !defined(LITTLE_FOOT_PRINT)
+  size_t textRunLength(const uint8_t *buffer, size_t size, int16_t *run_w);
+  void drawTextRun(const uint8_t *buffer, size_t len, int16_t run_w);
+  uint16_t *fillTextDot(uint16_t *p, bool draw_dot);
+  void writeTextLine(uint16_t *line_buf, uint16_t w, bool blank);
+#endif // !defined(LITTLE_FOOT_PRINT)
+
   Arduino_DataBus *_bus;
   int8_t _rst;
   bool _ips;
@@ -16,6 +16,11 @@ Arduino_Canvas::~Arduino_Canvas()
   {
     free(_framebuffer);
   }
+  if (_span_x1)
+  {
+    free(_span_x1);
+    free(_span_x2);
+  }
 }
 
 bool Arduino_Canvas::begin(int32_t speed)
@@ -50,12 +55,117 @@ bool Arduino_Canvas::begin(int32_t speed)
     }
   }
 
+  if (_circular && !buildCircularSpans())
+  {
+    return false;
+  }
+
+  return true;
+}
+
+void Arduino_Canvas::setCircularMask(bool enable)
+{
+  _circular = enable;
+  if (enable && _framebuffer && !buildCircularSpans())
+  {
+    _circular = false;
+  }
+  // Corners may hold anything the panel has not been sent yet
+  markAllDirty();
+}
+
+// Pixel (x, y) is visible when its center lies inside the disc of diameter
+// d = min(w, h) centered on the canvas. In doubled coordinates that is
+// (2x + 1 - w)^2 + (2y + 1 - h)^2 <= d^2, so each row keeps the columns with
+// |2x + 1 - w| <= s, s = isqrt(d^2 - (2y + 1 - h)^2).
+bool Arduino_Canvas::buildCircularSpans(void)
+{
+  if (!_span_x1)
+  {
+    _span_x1 = (int16_t *)malloc(_height * sizeof(int16_t));
+    _span_x2 = (int16_t *)malloc(_height * sizeof(int16_t));
+    if ((!_span_x1) || (!_span_x2))
+    {
+      free(_span_x1);
+      free(_span_x2);
+      _span_x1 = nullptr;
+      _span_x2 = nullptr;
+      return false;
+    }
+  }
+
+  int32_t d = (_width < _height) ? _width : _height;
+  for (int16_t y = 0; y < _height; y++)
+  {
+    int32_t dy = 2 * y + 1 - _height;
+    int32_t t = d * d - dy * dy;
+    if (t < 0)
+    {
+      _span_x1[y] = _width; // empty row
+      _span_x2[y] = -1;
+      continue;
+    }
+    int32_t sq = (int32_t)sqrt((double)t);
+    while (sq * sq > t)
+    {
+      --sq;
+    }
+    while ((sq + 1) * (sq + 1) <= t)
+    {
+      ++sq;
+    }
+    _span_x1[y] = (_width - sq) / 2;
+    _span_x2[y] = (_width - 1 + sq) / 2;
+  }
   return true;
 }
 
+bool Arduino_Canvas::isVisible(int16_t x, int16_t y)
+{
+  if (!_ordered_in_range(x, 0, _max_x) || !_ordered_in_range(y, 0, _max_y))
+  {
+    return false;
+  }
+  return (!_circular) || ((x >= _span_x1[y]) && (x <= _span_x2[y]));
+}
+
+// Offsets [*i1, *i2] of the pixels of a w wide run starting at x on row y
+// that fall inside the disc; false when none does
+bool Arduino_Canvas::maskedSpan(int16_t y, int16_t x, int16_t w, int16_t *i1, int16_t *i2)
+{
+  *i1 = (_span_x1[y] > x) ? (_span_x1[y] - x) : 0;
+  *i2 = (_span_x2[y] < (x + w - 1)) ? (_span_x2[y] - x) : (w - 1);
+  return *i1 <= *i2;
+}
+
 void Arduino_Canvas::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
 {
+  if (_circular && ((x < _span_x1[y]) || (x > _span_x2[y])))
+  {
+    return;
+  }
   _framebuffer[((int32_t)y * _width) + x] = color;
+  addDirty(x, y, x, y);
+}
+
+void Arduino_Canvas::writePixelAlpha(int16_t x, int16_t y, uint16_t color, uint8_t alpha)
+{
+  if (!_ordered_in_range(x, 0, _max_x) || !_ordered_in_range(y, 0, _max_y))
+  {
+    return;
+  }
+  if (_circular && ((x < _span_x1[y]) || (x > _span_x2[y])))
+  {
+    return;
+  }
+  uint16_t *p = &_framebuffer[((int32_t)y * _width) + x];
+  // spread 5-6-5 as -G-R-B with room for a 5 bit multiply
+  uint32_t a = (alpha + 4) >> 3;
+  uint32_t fg = (color | ((uint32_t)color << 16)) & 0x07E0F81F;
+  uint32_t bg = (*p | ((uint32_t)*p << 16)) & 0x07E0F81F;
+  uint32_t c = ((fg * a + bg * (32 - a)) >> 5) & 0x07E0F81F;
+  *p = c | (c >> 16);
+  addDirty(x, y, x, y);
 }
 
 void Arduino_Canvas::writeFastVLine(int16_t x, int16_t y,
@@ -84,6 +194,24 @@ void Arduino_Canvas::writeFastVLine(int16_t x, int16_t y,
           h = _max_y - y + 1;
         } // Clip bottom
 
+        if (_circular)
+        { // The disc is convex: trim the ends until both are inside
+          while (h && ((x < _span_x1[y]) || (x > _span_x2[y])))
+          {
+            ++y;
+            --h;
+          }
+          while (h && ((x < _span_x1[y + h - 1]) || (x > _span_x2[y + h - 1])))
+          {
+            --h;
+          }
+          if (!h)
+          {
+            return;
+          }
+        }
+
+        addDirty(x, y, x, y + h - 1);
         uint16_t *fb = _framebuffer + ((int32_t)y * _width) + x;
         while (h--)
         {
@@ -121,6 +249,24 @@ void Arduino_Canvas::writeFastHLine(int16_t x, int16_t y,
           w = _max_x - x + 1;
         } // Clip right
 
+        if (_circular)
+        {
+          if (x < _span_x1[y])
+          {
+            w -= _span_x1[y] - x;
+            x = _span_x1[y];
+          }
+          if ((x + w - 1) > _span_x2[y])
+          {
+            w = _span_x2[y] - x + 1;
+          }
+          if (w <= 0)
+          {
+            return;
+          }
+        }
+
+        addDirty(x, y, x + w - 1, y);
         uint16_t *fb = _framebuffer + ((int32_t)y * _width) + x;
         while (w--)
         {
@@ -134,6 +280,24 @@ void Arduino_Canvas::writeFastHLine(int16_t x, int16_t y,
 void Arduino_Canvas::writeFillRectPreclipped(int16_t x, int16_t y,
                                              int16_t w, int16_t h, uint16_t color)
 {
+  if (_circular)
+  {
+    int16_t x2 = x + w - 1;
+    for (int16_t j = y; j < (y + h); j++)
+    {
+      int16_t rx1 = (x > _span_x1[j]) ? x : _span_x1[j];
+      int16_t rx2 = (x2 < _span_x2[j]) ? x2 : _span_x2[j];
+      uint16_t *row = _framebuffer + ((int32_t)j * _width);
+      for (int16_t i = rx1; i <= rx2; i++)
+      {
+        row[i] = color;
+      }
+    }
+    addDirty(x, y, x2, y + h - 1);
+    return;
+  }
+
+  addDirty(x, y, x + w - 1, y + h - 1);
   uint16_t *row = _framebuffer;
   row += y * _width;
   row += x;
@@ -184,9 +348,27 @@ void Arduino_Canvas::drawIndexedBitmap(
       w += x;
       x = 0;
     }
+    addDirty(x, y, x + w - 1, y + h - 1);
     uint16_t *row = _framebuffer;
     row += y * _width;
     row += x;
+    if (_circular)
+    { // Copy only the visible span of each row
+      int16_t i1, i2;
+      for (int16_t j = 0; j < h; j++)
+      {
+        if (maskedSpan(y + j, x, w, &i1, &i2))
+        {
+          for (int16_t i = i1; i <= i2; i++)
+          {
+            row[i] = color_index[bitmap[i]];
+          }
+        }
+        bitmap += w + x_skip;
+        row += _width;
+      }
+      return;
+    }
     int16_t i;
     int16_t wi;
     while (h--)
@@ -250,9 +432,30 @@ void Arduino_Canvas::drawIndexedBitmap(
       w += x;
       x = 0;
     }
+    addDirty(x, y, x + w - 1, y + h - 1);
     uint16_t *row = _framebuffer;
     row += y * _width;
     row += x;
+    if (_circular)
+    { // Copy only the visible span of each row
+      int16_t i1, i2;
+      for (int16_t j = 0; j < h; j++)
+      {
+        if (maskedSpan(y + j, x, w, &i1, &i2))
+        {
+          for (int16_t i = i1; i <= i2; i++)
+          {
+            if (bitmap[i] != chroma_key)
+          {
+            row[i] = color_index[bitmap[i]];
+          }
+          }
+        }
+        bitmap += w + x_skip;
+        row += _width;
+      }
+      return;
+    }
     int16_t i;
     int16_t wi;
     uint8_t color_key;
@@ -342,9 +545,27 @@ void Arduino_Canvas::draw16bitRGBBitmap(int16_t x, int16_t y,
       w += x;
       x = 0;
     }
+    addDirty(x, y, x + w - 1, y + h - 1);
     uint16_t *row = _framebuffer;
     row += y * _width;
     row += x;
+    if (_circular)
+    { // Copy only the visible span of each row
+      int16_t i1, i2;
+      for (int16_t j = 0; j < h; j++)
+      {
+        if (maskedSpan(y + j, x, w, &i1, &i2))
+        {
+          for (int16_t i = i1; i <= i2; i++)
+          {
+            row[i] = bitmap[i];
+          }
+        }
+        bitmap += w + xskip;
+        row += _width;
+      }
+      return;
+    }
     int16_t i;
     int16_t wi;
     while (h--)
@@ -407,9 +628,30 @@ void Arduino_Canvas::draw16bitRGBBitmap(
       w += x;
       x = 0;
     }
+    addDirty(x, y, x + w - 1, y + h - 1);
     uint16_t *row = _framebuffer;
     row += y * _width;
     row += x;
+    if (_circular)
+    { // Copy only the visible span of each row
+      int16_t i1, i2;
+      for (int16_t j = 0; j < h; j++)
+      {
+        if (maskedSpan(y + j, x, w, &i1, &i2))
+        {
+          for (int16_t i = i1; i <= i2; i++)
+          {
+            if (bitmap[i] != transparent_color)
+          {
+            row[i] = bitmap[i];
+          }
+          }
+        }
+        bitmap += w + xskip;
+        row += _width;
+      }
+      return;
+    }
     int16_t i;
     int16_t wi;
     uint16_t p;
@@ -487,9 +729,27 @@ void Arduino_Canvas::draw16bitBeRGBBitmap(int16_t x, int16_t y,
       w += x;
       x = 0;
     }
+    addDirty(x, y, x + w - 1, y + h - 1);
     uint16_t *row = _framebuffer;
     row += y * _width;
     row += x;
+    if (_circular)
+    { // Copy only the visible span of each row
+      int16_t i1, i2;
+      for (int16_t j = 0; j < h; j++)
+      {
+        if (maskedSpan(y + j, x, w, &i1, &i2))
+        {
+          for (int16_t i = i1; i <= i2; i++)
+          {
+            MSB_16_SET(row[i], bitmap[i]);
+          }
+        }
+        bitmap += w + xskip;
+        row += _width;
+      }
+      return;
+    }
     uint16_t color;
     for (int j = 0; j < h; j++)
     {
@@ -504,11 +764,203 @@ void Arduino_Canvas::draw16bitBeRGBBitmap(int16_t x, int16_t y,
   }
 }
 
+static inline int32_t dirty_area(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  return (int32_t)(x2 - x1 + 1) * (y2 - y1 + 1);
+}
+
+// Record [x1, x2] x [y1, y2] (inclusive, already clipped) as changed since the
+// last flush. Rectangles merge when their bounding box wastes at most
+// CANVAS_DIRTY_MERGE_SLACK pixels; when all slots are taken, the one that
+// grows least absorbs the new region.
+void Arduino_Canvas::addDirty(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  if (_dirty_all || (x2 < x1) || (y2 < y1))
+  {
+    return;
+  }
+
+  // Consecutive writes (text, lines, fills) mostly land in the last region
+  if (_dirty_count)
+  {
+    DirtyRect *r = &_dirty[_dirty_last];
+    if ((x1 >= r->x1) && (y1 >= r->y1) && (x2 <= r->x2) && (y2 <= r->y2))
+    {
+      return;
+    }
+  }
+
+  bool merged = true;
+  while (merged)
+  {
+    merged = false;
+    int32_t area = dirty_area(x1, y1, x2, y2);
+    for (uint8_t i = 0; i < _dirty_count; i++)
+    {
+      DirtyRect *r = &_dirty[i];
+      int16_t ux1 = (r->x1 < x1) ? r->x1 : x1;
+      int16_t uy1 = (r->y1 < y1) ? r->y1 : y1;
+      int16_t ux2 = (r->x2 > x2) ? r->x2 : x2;
+      int16_t uy2 = (r->y2 > y2) ? r->y2 : y2;
+      if (dirty_area(ux1, uy1, ux2, uy2) <= area + dirty_area(r->x1, r->y1, r->x2, r->y2) + CANVAS_DIRTY_MERGE_SLACK)
+      {
+        x1 = ux1;
+        y1 = uy1;
+        x2 = ux2;
+        y2 = uy2;
+        _dirty[i] = _dirty[--_dirty_count];
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  if (_dirty_count == CANVAS_DIRTY_RECTS)
+  {
+    uint8_t best = 0;
+    int32_t best_growth = INT32_MAX;
+    for (uint8_t i = 0; i < _dirty_count; i++)
+    {
+      DirtyRect *r = &_dirty[i];
+      int16_t ux1 = (r->x1 < x1) ? r->x1 : x1;
+      int16_t uy1 = (r->y1 < y1) ? r->y1 : y1;
+      int16_t ux2 = (r->x2 > x2) ? r->x2 : x2;
+      int16_t uy2 = (r->y2 > y2) ? r->y2 : y2;
+      int32_t growth = dirty_area(ux1, uy1, ux2, uy2) - dirty_area(r->x1, r->y1, r->x2, r->y2);
+      if (growth < best_growth)
+      {
+        best_growth = growth;
+        best = i;
+      }
+    }
+    DirtyRect r = _dirty[best];
+    _dirty[best] = _dirty[--_dirty_count];
+    // The grown rectangle may now reach the others; one slot is free, so this
+    // does not come back here
+    addDirty((r.x1 < x1) ? r.x1 : x1, (r.y1 < y1) ? r.y1 : y1,
+             (r.x2 > x2) ? r.x2 : x2, (r.y2 > y2) ? r.y2 : y2);
+    return;
+  }
+
+  _dirty_last = _dirty_count;
+  _dirty[_dirty_count++] = {x1, y1, x2, y2};
+}
+
+void Arduino_Canvas::markDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  int16_t x2 = x + w - 1;
+  int16_t y2 = y + h - 1;
+  if (x < 0)
+  {
+    x = 0;
+  }
+  if (y < 0)
+  {
+    y = 0;
+  }
+  if (x2 > _max_x)
+  {
+    x2 = _max_x;
+  }
+  if (y2 > _max_y)
+  {
+    y2 = _max_y;
+  }
+  addDirty(x, y, x2, y2);
+}
+
+void Arduino_Canvas::markAllDirty(void)
+{
+  _dirty_all = true;
+  _dirty_count = 0;
+}
+
 void Arduino_Canvas::flush()
 {
+  // On a queued bus (Arduino_ESP32SPIDMA::setAsyncBuffers) this returns once
+  // the last chunk is queued; chunks are copied out, so drawing can resume
   if (_output)
   {
-    _output->draw16bitRGBBitmap(_output_x, _output_y, _framebuffer, _width, _height);
+    int32_t dirty_pixels = 0;
+    for (uint8_t i = 0; i < _dirty_count; i++)
+    {
+      dirty_pixels += dirty_area(_dirty[i].x1, _dirty[i].y1, _dirty[i].x2, _dirty[i].y2);
+    }
+
+    if (_dirty_all || (dirty_pixels >= (int32_t)_width * _height))
+    {
+      if (_circular)
+      {
+        flushRegion(0, 0, _max_x, _max_y);
+      }
+      else
+      {
+        _output->draw16bitRGBBitmap(_output_x, _output_y, _framebuffer, _width, _height);
+      }
+    }
+    else
+    {
+      for (uint8_t i = 0; i < _dirty_count; i++)
+      {
+        flushRegion(_dirty[i].x1, _dirty[i].y1, _dirty[i].x2, _dirty[i].y2);
+      }
+    }
+  }
+  _dirty_count = 0;
+  _dirty_all = false;
+}
+
+// Send [x1, x2] x [y1, y2] of the framebuffer. In circular mode each row is
+// cut to its visible span and consecutive rows share a window while the
+// pixels outside the disc it adds stay within CANVAS_DIRTY_MERGE_SLACK;
+// towards the poles, where spans change fast, that is about one row each.
+void Arduino_Canvas::flushRegion(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  if (!_circular)
+  {
+    int16_t w = x2 - x1 + 1;
+    _output->draw16bitRGBBitmapStride(
+        _output_x + x1, _output_y + y1,
+        _framebuffer + ((int32_t)y1 * _width) + x1, w, y2 - y1 + 1, _width - w);
+    return;
+  }
+
+  int16_t y = y1;
+  while (y <= y2)
+  {
+    int16_t bx1 = (x1 > _span_x1[y]) ? x1 : _span_x1[y];
+    int16_t bx2 = (x2 < _span_x2[y]) ? x2 : _span_x2[y];
+    if (bx1 > bx2)
+    {
+      ++y;
+      continue;
+    }
+    int16_t by = y++;
+    int32_t visible = bx2 - bx1 + 1;
+    while (y <= y2)
+    {
+      int16_t rx1 = (x1 > _span_x1[y]) ? x1 : _span_x1[y];
+      int16_t rx2 = (x2 < _span_x2[y]) ? x2 : _span_x2[y];
+      if (rx1 > rx2)
+      {
+        break;
+      }
+      int16_t ux1 = (bx1 < rx1) ? bx1 : rx1;
+      int16_t ux2 = (bx2 > rx2) ? bx2 : rx2;
+      int32_t row_visible = rx2 - rx1 + 1;
+      if (((int32_t)(ux2 - ux1 + 1) * (y - by + 1)) - (visible + row_visible) > CANVAS_DIRTY_MERGE_SLACK)
+      {
+        break;
+      }
+      bx1 = ux1;
+      bx2 = ux2;
+      visible += row_visible;
+      ++y;
+    }
+    int16_t w = bx2 - bx1 + 1;
+    _output->draw16bitRGBBitmapStride(
+        _output_x + bx1, _output_y + by,
+        _framebuffer + ((int32_t)by * _width) + bx1, w, y - by, _width - w);
   }
 }
 
@@ -545,6 +997,9 @@ void Arduino_Canvas::flushQuad(void)
 
 uint16_t *Arduino_Canvas::getFramebuffer()
 {
+  // The caller may write anywhere; without markDirty() calls the next flush
+  // has to send everything
+  markAllDirty();
   return _framebuffer;
 }
 
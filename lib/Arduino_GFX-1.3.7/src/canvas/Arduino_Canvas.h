@@ -6,6 +6,17 @@
 
 #include "../Arduino_GFX.h"
 
+// Damaged rectangles kept between flushes; past this, the closest pair merges
+#ifndef CANVAS_DIRTY_RECTS
+#define CANVAS_DIRTY_RECTS 8
+#endif
+
+// Pixels two rectangles may waste when merged into their bounding box
+// (roughly what an extra address window costs on SPI)
+#ifndef CANVAS_DIRTY_MERGE_SLACK
+#define CANVAS_DIRTY_MERGE_SLACK 64
+#endif
+
 class Arduino_Canvas : public Arduino_GFX
 {
 public:
@@ -17,6 +28,7 @@ public:
   void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
   void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
   void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void writePixelAlpha(int16_t x, int16_t y, uint16_t color, uint8_t alpha) override;
   void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip = 0) override;
   void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, uint8_t chroma_key, int16_t w, int16_t h, int16_t x_skip = 0) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
@@ -27,12 +39,41 @@ public:
 
   uint16_t *getFramebuffer();
 
+  // For writes that bypass the drawing functions (e.g. straight into getFramebuffer())
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  void markAllDirty(void);
+
+  // Round panels: clip drawing (bitmaps included) to the disc inscribed in the
+  // canvas and flush only the visible span of each row
+  void setCircularMask(bool enable);
+  bool isVisible(int16_t x, int16_t y);
+
 protected:
+  void addDirty(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+  bool buildCircularSpans(void);
+  bool maskedSpan(int16_t y, int16_t x, int16_t w, int16_t *i1, int16_t *i2);
+  void flushRegion(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+
   uint16_t *_framebuffer = nullptr;
   uint16_t *_rowBuf = nullptr;
   Arduino_G *_output = nullptr;
   int16_t _output_x, _output_y;
 
+  // Inclusive corners of the regions changed since the last flush
+  struct DirtyRect
+  {
+    int16_t x1, y1, x2, y2;
+  };
+  DirtyRect _dirty[CANVAS_DIRTY_RECTS];
+  uint8_t _dirty_count = 0;
+  uint8_t _dirty_last = 0;
+  bool _dirty_all = true;
+
+  // Visible columns [_span_x1[y], _span_x2[y]] of each row in circular mode
+  bool _circular = false;
+  int16_t *_span_x1 = nullptr;
+  int16_t *_span_x2 = nullptr;
+
 private:
 };
 
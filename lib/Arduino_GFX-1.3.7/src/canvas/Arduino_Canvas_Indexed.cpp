@@ -13,6 +13,7 @@ Arduino_Canvas_Indexed::Arduino_Canvas_Indexed(int16_t w, int16_t h, Arduino_G *
   }
   _current_mask_level = mask_level;
   _color_mask = mask_level_list[_current_mask_level];
+  clear_color_hash();
 }
 
 Arduino_Canvas_Indexed::~Arduino_Canvas_Indexed()
@@ -336,9 +337,21 @@ void Arduino_Canvas_Indexed::setDirectUseColorIndex(bool isEnable)
   _isDirectUseColorIndex = isEnable;
 }
 
+static inline uint16_t color_hash(uint16_t color)
+{
+  return ((uint32_t)color * 2654435761u) >> (32 - 9); // 9 bits = COLOR_HASH_SIZE
+}
+
+void Arduino_Canvas_Indexed::clear_color_hash()
+{
+  memset(_color_hash, 0, sizeof(_color_hash));
+  _last_valid = false;
+}
+
 uint8_t Arduino_Canvas_Indexed::get_color_index(uint16_t color)
 {
   color &= _color_mask;
+#if CANVAS_INDEXED_LINEAR_LOOKUP
   for (uint8_t i = 0; i < _indexed_size; i++)
   {
     if (_color_index[i] == color)
@@ -346,15 +359,52 @@ uint8_t Arduino_Canvas_Indexed::get_color_index(uint16_t color)
       return i;
     }
   }
+#else
+  if (_last_valid && (_last_color == color))
+  {
+    return _last_index;
+  }
+  uint16_t h = color_hash(color);
+  uint8_t slot;
+  while ((slot = _color_hash[h]) != 0)
+  {
+    if (_color_index[slot - 1] == color)
+    {
+      _last_color = color;
+      _last_index = slot - 1;
+      _last_valid = true;
+      return _last_index;
+    }
+    h = (h + 1) & (COLOR_HASH_SIZE - 1);
+  }
+#endif
   if (_indexed_size == (COLOR_IDX_SIZE - 1)) // overflowed
   {
+    uint8_t level = _current_mask_level;
     raise_mask_level();
+    if (_current_mask_level != level)
+    {
+      // Coarser mask: the color may now match an existing entry
+      return get_color_index(color);
+    }
+    // Last mask level: take the last slot and start reusing from 0, as the
+    // linear scan did
+    _color_index[_indexed_size] = color;
+    _indexed_size = 0;
+    clear_color_hash();
+    return COLOR_IDX_SIZE - 1;
   }
   _color_index[_indexed_size] = color;
   // Serial.print("color_index[");
   // Serial.print(_indexed_size);
   // Serial.print("] = ");
   // Serial.println(color);
+#if !CANVAS_INDEXED_LINEAR_LOOKUP
+  _color_hash[h] = _indexed_size + 1; // h stopped at the first empty slot
+  _last_color = color;
+  _last_index = _indexed_size;
+  _last_valid = true;
+#endif
   return _indexed_size++;
 }
 
@@ -371,6 +421,7 @@ void Arduino_Canvas_Indexed::raise_mask_level()
     uint8_t old_indexed_size = _indexed_size;
     uint8_t new_color;
     _indexed_size = 0;
+    clear_color_hash();
     _color_mask = mask_level_list[++_current_mask_level];
     Serial.print("Raised mask level: ");
     Serial.println(_current_mask_level);
@@ -8,6 +8,15 @@
 
 #define COLOR_IDX_SIZE 256
 
+// Open-addressing table from (masked) color to palette slot; twice the
+// palette size keeps probes short even with a full palette
+#define COLOR_HASH_SIZE 512
+
+// 1: previous linear scan of the palette in get_color_index(), for comparison
+#ifndef CANVAS_INDEXED_LINEAR_LOOKUP
+#define CANVAS_INDEXED_LINEAR_LOOKUP 0
+#endif
+
 class Arduino_Canvas_Indexed : public Arduino_GFX
 {
 public:
@@ -31,6 +40,8 @@ public:
   void raise_mask_level();
 
 protected:
+  void clear_color_hash();
+
   uint8_t *_framebuffer = nullptr;
   Arduino_G *_output = nullptr;
   int16_t _output_x, _output_y;
@@ -38,6 +49,13 @@ protected:
   uint8_t _indexed_size = 0;
   bool _isDirectUseColorIndex = false;
 
+  // Palette slot + 1 for each hashed color, 0 = empty
+  uint8_t _color_hash[COLOR_HASH_SIZE];
+  // Consecutive pixels mostly share a color
+  uint16_t _last_color;
+  uint8_t _last_index;
+  bool _last_valid = false;
+
   uint8_t _current_mask_level;
   uint16_t _color_mask;
 #define MAXMASKLEVEL 3
@@ -44,6 +44,40 @@ Arduino_ESP32SPIDMA::Arduino_ESP32SPIDMA(
 #endif
 }
 
+/**
+ * @brief ~Arduino_ESP32SPIDMA
+ *
+ * Waits for queued transfers, then releases everything begin() took, so a
+ * bus whose panel failed to start can be deleted without leaking the DMA
+ * buffers or the SPI host.
+ */
+Arduino_ESP32SPIDMA::~Arduino_ESP32SPIDMA()
+{
+  if (_handle)
+  {
+    waitIdle();
+    if (!_is_shared_interface)
+    {
+      spi_device_release_bus(_handle);
+    }
+    spi_bus_remove_device(_handle);
+    _handle = nullptr;
+  }
+  if (_bus_initialized)
+  {
+    spi_bus_free((spi_host_device_t)_spi_num);
+    _bus_initialized = false;
+  }
+  for (uint8_t i = 0; i < SPI_DMA_MAX_QUEUED; i++)
+  {
+    if (_async_buf[i])
+    {
+      heap_caps_free(_async_buf[i]);
+      _async_buf[i] = nullptr;
+    }
+  }
+}
+
 /**
  * @brief begin
  *
@@ -108,6 +142,25 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
     _csPortClr = (PORTreg_t)&GPIO.out_w1tc;
   }
 
+  if (_async_count)
+  {
+    for (uint8_t i = 0; i < _async_count; i++)
+    {
+      _async_buf[i] = (uint32_t *)heap_caps_malloc(SPI_MAX_PIXELS_AT_ONCE * 2, MALLOC_CAP_DMA);
+      if (!_async_buf[i])
+      {
+        log_w("Not enough DMA memory for %d async buffers, using polling", _async_count);
+        for (uint8_t j = 0; j < i; j++)
+        {
+          heap_caps_free(_async_buf[j]);
+          _async_buf[j] = nullptr;
+        }
+        _async_count = 0;
+        break;
+      }
+    }
+  }
+
   spi_bus_config_t buscfg = {
       .mosi_io_num = _mosi,
       .miso_io_num = _miso,
@@ -122,6 +175,7 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
     ESP_ERROR_CHECK(ret);
     return false;
   }
+  _bus_initialized = true;
 
   spi_device_interface_config_t devcfg = {
       .command_bits = 0,
@@ -135,7 +189,9 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
       .input_delay_ns = 0,
       .spics_io_num = -1, // avoid use system CS control
       .flags = (_miso < 0) ? (uint32_t)SPI_DEVICE_NO_DUMMY : 0,
-      .queue_size = 1,
+      .queue_size = (_async_count > 0) ? _async_count : 1,
+      .pre_cb = nullptr,
+      .post_cb = async_done_cb,
   };
   ret = spi_bus_add_device((spi_host_device_t)_spi_num, &devcfg, &_handle);
   if (ret != ESP_OK)
@@ -160,6 +216,9 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
  */
 void Arduino_ESP32SPIDMA::beginWrite()
 {
+  // previous frame may still be on the bus
+  waitIdle();
+
   _data_buf_bit_idx = 0;
   _buffer[0] = 0;
 
@@ -186,12 +245,49 @@ void Arduino_ESP32SPIDMA::endWrite()
     flush_data_buf();
   }
 
-  if (_is_shared_interface)
+  if (_async_queued)
   {
-    spi_device_release_bus(_handle);
+    // CS and the bus are released by the next fence
+    _end_pending = true;
+    return;
   }
 
-  CS_HIGH();
+  finish_write();
+}
+
+/**
+ * @brief setAsyncBuffers
+ *
+ * @param buffer_count
+ */
+void Arduino_ESP32SPIDMA::setAsyncBuffers(uint8_t buffer_count)
+{
+  _async_count = (buffer_count > SPI_DMA_MAX_QUEUED) ? SPI_DMA_MAX_QUEUED : buffer_count;
+}
+
+/**
+ * @brief waitIdle
+ *
+ */
+void Arduino_ESP32SPIDMA::waitIdle()
+{
+  async_drain();
+
+  if (_end_pending)
+  {
+    _end_pending = false;
+    finish_write();
+  }
+}
+
+/**
+ * @brief isBusy
+ *
+ * @return true while queued transfers are still on the bus
+ */
+bool Arduino_ESP32SPIDMA::isBusy()
+{
+  return _async_done != _async_sent;
 }
 
 /**
@@ -553,6 +649,34 @@ void Arduino_ESP32SPIDMA::writePixels(uint16_t *data, uint32_t len)
 
     uint32_t l, l2;
     uint16_t p1, p2;
+
+    if (_async_count)
+    {
+      uint32_t *buf;
+      while (len)
+      {
+        l = (len > SPI_MAX_PIXELS_AT_ONCE) ? SPI_MAX_PIXELS_AT_ONCE : len;
+        l2 = l >> 1;
+        buf = async_buffer();
+        for (uint32_t i = 0; i < l2; ++i)
+        {
+          p1 = *data++;
+          p2 = *data++;
+          MSB_32_16_16_SET(buf[i], p1, p2);
+        }
+        if (l & 1)
+        {
+          p1 = *data++;
+          MSB_16_SET(((uint16_t *)buf)[l - 1], p1);
+        }
+
+        async_queue(l << 4);
+
+        len -= l;
+      }
+      return;
+    }
+
     while (len)
     {
       l = (len > SPI_MAX_PIXELS_AT_ONCE) ? SPI_MAX_PIXELS_AT_ONCE : len;
@@ -776,6 +900,84 @@ void Arduino_ESP32SPIDMA::flush_data_buf()
   _data_buf_bit_idx = 0;
 }
 
+/**
+ * @brief async_buffer
+ *
+ * @return next free DMA buffer, waiting for the oldest transfer if all are queued
+ */
+uint32_t *Arduino_ESP32SPIDMA::async_buffer()
+{
+  if (_async_queued == _async_count)
+  {
+    // results come back in queue order, so this frees _async_buf[_async_next]
+    spi_transaction_t *done;
+    spi_device_get_trans_result(_handle, &done, portMAX_DELAY);
+    --_async_queued;
+  }
+  return _async_buf[_async_next];
+}
+
+/**
+ * @brief async_queue
+ *
+ * @param bits
+ */
+void Arduino_ESP32SPIDMA::async_queue(uint32_t bits)
+{
+  spi_transaction_t *t = &_async_tran[_async_next];
+  memset(t, 0, sizeof(spi_transaction_t));
+  t->tx_buffer = _async_buf[_async_next];
+  t->length = bits;
+  t->user = this;
+
+  ++_async_sent;
+  spi_device_queue_trans(_handle, t, portMAX_DELAY);
+  ++_async_queued;
+  _async_next = (_async_next + 1) % _async_count;
+}
+
+/**
+ * @brief async_drain
+ *
+ */
+void Arduino_ESP32SPIDMA::async_drain()
+{
+  spi_transaction_t *done;
+  while (_async_queued)
+  {
+    spi_device_get_trans_result(_handle, &done, portMAX_DELAY);
+    --_async_queued;
+  }
+}
+
+/**
+ * @brief finish_write
+ *
+ */
+void Arduino_ESP32SPIDMA::finish_write()
+{
+  if (_is_shared_interface)
+  {
+    spi_device_release_bus(_handle);
+  }
+
+  CS_HIGH();
+}
+
+/**
+ * @brief async_done_cb
+ *
+ * @param t
+ */
+void IRAM_ATTR Arduino_ESP32SPIDMA::async_done_cb(spi_transaction_t *t)
+{
+  // polled transactions leave user empty
+  if (t->user)
+  {
+    ++((Arduino_ESP32SPIDMA *)t->user)->_async_done;
+  }
+}
+
 /**
  * @brief WRITE8BIT
  *
@@ -839,6 +1041,11 @@ INLINE void Arduino_ESP32SPIDMA::DC_HIGH(void)
  */
 INLINE void Arduino_ESP32SPIDMA::DC_LOW(void)
 {
+  // queued pixel data must leave the bus before DC drops
+  if (_async_queued)
+  {
+    async_drain();
+  }
   *_dcPortClr = _dcPinMask;
 }
 
@@ -875,6 +1082,12 @@ INLINE void Arduino_ESP32SPIDMA::CS_LOW(void)
  */
 INLINE void Arduino_ESP32SPIDMA::POLL_START()
 {
+  // the driver does not allow polling while queued transfers are pending
+  if (_async_queued)
+  {
+    async_drain();
+  }
+
   esp_err_t ret = spi_device_polling_start(_handle, &_spi_tran, portMAX_DELAY);
   // if (ret != ESP_OK)
   // {
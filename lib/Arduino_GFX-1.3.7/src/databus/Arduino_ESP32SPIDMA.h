@@ -6,6 +6,7 @@
 #include <driver/spi_master.h>
 
 #define SPI_MAX_PIXELS_AT_ONCE 1024
+#define SPI_DMA_MAX_QUEUED 32
 #define DMA_CHANNEL SPI_DMA_CH_AUTO
 
 class Arduino_ESP32SPIDMA : public Arduino_DataBus
@@ -18,6 +19,7 @@ public:
 #else
   Arduino_ESP32SPIDMA(int8_t dc = GFX_NOT_DEFINED, int8_t cs = GFX_NOT_DEFINED, int8_t sck = GFX_NOT_DEFINED, int8_t mosi = GFX_NOT_DEFINED, int8_t miso = GFX_NOT_DEFINED, uint8_t spi_num = FSPI, bool is_shared_interface = false); // Constructor
 #endif
+  ~Arduino_ESP32SPIDMA();
 
   bool begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = SPI_MODE0) override;
   void beginWrite() override;
@@ -39,8 +41,22 @@ public:
   void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
 
+  // Queued mode: writePixels() byte-swaps each chunk into one of
+  // buffer_count DMA buffers and queues it without waiting, so the CPU only
+  // blocks when all buffers are in flight. endWrite() leaves CS asserted
+  // until the queue drains; any command, polled write, beginWrite() or
+  // waitIdle() is a fence. Must be called before begin(); 0 disables.
+  void setAsyncBuffers(uint8_t buffer_count);
+  void waitIdle() override;
+  bool isBusy();
+
 protected:
   void flush_data_buf();
+  uint32_t *async_buffer();
+  void async_queue(uint32_t bits);
+  void async_drain();
+  void finish_write();
+  static void IRAM_ATTR async_done_cb(spi_transaction_t *t);
   INLINE void WRITE8BIT(uint8_t d);
   INLINE void WRITE9BIT(uint32_t d);
   INLINE void DC_HIGH(void);
@@ -64,7 +80,8 @@ private:
   uint32_t _dcPinMask;  ///< Bitmask for data/command
   uint32_t _csPinMask;  ///< Bitmask for chip select
 
-  spi_device_handle_t _handle;
+  bool _bus_initialized = false;
+  spi_device_handle_t _handle = nullptr;
   spi_transaction_t _spi_tran;
   uint8_t _bitOrder = SPI_MSBFIRST;
   union
@@ -74,6 +91,15 @@ private:
     uint32_t _buffer32[SPI_MAX_PIXELS_AT_ONCE / 2];
   };
   uint16_t _data_buf_bit_idx = 0;
+
+  uint8_t _async_count = 0;
+  uint8_t _async_next = 0;
+  uint8_t _async_queued = 0;
+  bool _end_pending = false;
+  uint32_t _async_sent = 0;
+  volatile uint32_t _async_done = 0;
+  uint32_t *_async_buf[SPI_DMA_MAX_QUEUED] = {nullptr};
+  spi_transaction_t _async_tran[SPI_DMA_MAX_QUEUED];
 };
 
 #endif // #if defined(ESP32)
@@ -0,0 +1,443 @@
+#include "Arduino_HostFramebuffer.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include <stdio.h>
+
+// MIPI DCS commands used by the Arduino_TFT drivers to write frame memory
+#define HOSTFB_CASET 0x2A
+#define HOSTFB_RASET 0x2B
+#define HOSTFB_RAMWR 0x2C
+
+Arduino_HostFramebuffer::Arduino_HostFramebuffer(uint16_t width, uint16_t height)
+    : _width(width), _height(height),
+      _command(0), _param_count(0), _pixel_msb_pending(false), _pixel_msb(0),
+      _x1(0), _x2(width - 1), _y1(0), _y2(height - 1), _cur_x(0), _cur_y(0)
+{
+  _framebuffer = (uint16_t *)calloc((size_t)width * height, sizeof(uint16_t));
+  resetStats();
+}
+
+Arduino_HostFramebuffer::~Arduino_HostFramebuffer()
+{
+  free(_framebuffer);
+}
+
+bool Arduino_HostFramebuffer::begin(int32_t, int8_t)
+{
+  return _framebuffer != nullptr;
+}
+
+void Arduino_HostFramebuffer::beginWrite()
+{
+  ++_stats.transactions;
+}
+
+void Arduino_HostFramebuffer::endWrite()
+{
+}
+
+void Arduino_HostFramebuffer::writeCommand(uint8_t c)
+{
+  ++_stats.commands;
+  ++_stats.bytes;
+  _command = c;
+  _param_count = 0;
+  _pixel_msb_pending = false;
+  if ((c == HOSTFB_CASET) || (c == HOSTFB_RASET))
+  {
+    ++_stats.window_changes;
+  }
+  else if (c == HOSTFB_RAMWR)
+  {
+    ++_stats.windows;
+    _cur_x = _x1;
+    _cur_y = _y1;
+  }
+}
+
+void Arduino_HostFramebuffer::writeCommand16(uint16_t)
+{
+  // 16-bit command sets (NT35510 style) are counted, not decoded
+  ++_stats.commands;
+  _stats.bytes += 2;
+  _command = 0;
+  _param_count = 0;
+}
+
+void Arduino_HostFramebuffer::write(uint8_t d)
+{
+  ++_stats.bytes;
+  writeData(d);
+}
+
+void Arduino_HostFramebuffer::write16(uint16_t d)
+{
+  _stats.bytes += 2;
+  if ((_command == HOSTFB_RAMWR) && !_pixel_msb_pending)
+  {
+    writePixel(d);
+  }
+  else
+  {
+    writeData(d >> 8);
+    writeData(d & 0xFF);
+  }
+}
+
+void Arduino_HostFramebuffer::writeRepeat(uint16_t p, uint32_t len)
+{
+  _stats.bytes += (uint64_t)len * 2;
+  if (_command == HOSTFB_RAMWR)
+  {
+    while (len--)
+    {
+      writePixel(p);
+    }
+  }
+}
+
+void Arduino_HostFramebuffer::writePixels(uint16_t *data, uint32_t len)
+{
+  _stats.bytes += (uint64_t)len * 2;
+  if (_command == HOSTFB_RAMWR)
+  {
+    while (len--)
+    {
+      writePixel(*data++);
+    }
+  }
+}
+
+void Arduino_HostFramebuffer::writeBytes(uint8_t *data, uint32_t len)
+{
+  _stats.bytes += len;
+  while (len--)
+  {
+    writeData(*data++);
+  }
+}
+
+void Arduino_HostFramebuffer::writeData(uint8_t d)
+{
+  if ((_command == HOSTFB_CASET) || (_command == HOSTFB_RASET))
+  {
+    if (_param_count < 4)
+    {
+      _params[_param_count++] = d;
+    }
+    if (_param_count == 4)
+    {
+      uint16_t start = (_params[0] << 8) | _params[1];
+      uint16_t end = (_params[2] << 8) | _params[3];
+      if (_command == HOSTFB_CASET)
+      {
+        _x1 = start;
+        _x2 = end;
+      }
+      else
+      {
+        _y1 = start;
+        _y2 = end;
+      }
+    }
+  }
+  else if (_command == HOSTFB_RAMWR)
+  {
+    // pixels go out MSB first
+    if (_pixel_msb_pending)
+    {
+      _pixel_msb_pending = false;
+      writePixel((_pixel_msb << 8) | d);
+    }
+    else
+    {
+      _pixel_msb = d;
+      _pixel_msb_pending = true;
+    }
+  }
+}
+
+void Arduino_HostFramebuffer::writePixel(uint16_t p)
+{
+  ++_stats.pixels;
+  if ((_cur_x < _width) && (_cur_y < _height))
+  {
+    _framebuffer[(uint32_t)_cur_y * _width + _cur_x] = p;
+  }
+  // like the controller: left to right, top to bottom, then back to the window start
+  if (++_cur_x > _x2)
+  {
+    _cur_x = _x1;
+    if (++_cur_y > _y2)
+    {
+      _cur_y = _y1;
+    }
+  }
+}
+
+uint16_t *Arduino_HostFramebuffer::getFramebuffer()
+{
+  return _framebuffer;
+}
+
+uint16_t Arduino_HostFramebuffer::width() const
+{
+  return _width;
+}
+
+uint16_t Arduino_HostFramebuffer::height() const
+{
+  return _height;
+}
+
+void Arduino_HostFramebuffer::fill(uint16_t color)
+{
+  for (uint32_t i = 0; i < (uint32_t)_width * _height; i++)
+  {
+    _framebuffer[i] = color;
+  }
+}
+
+Arduino_HostFramebuffer::Stats Arduino_HostFramebuffer::getStats() const
+{
+  return _stats;
+}
+
+void Arduino_HostFramebuffer::resetStats()
+{
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+/*****************************************************************************
+ * PNG
+ ****************************************************************************/
+
+static uint32_t png_crc(const uint8_t *data, size_t len, uint32_t crc)
+{
+  crc = ~crc;
+  while (len--)
+  {
+    crc ^= *data++;
+    for (uint8_t k = 0; k < 8; k++)
+    {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static void png_put32(uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static uint32_t png_get32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static bool png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+  uint8_t head[8];
+  png_put32(head, len);
+  memcpy(head + 4, type, 4);
+  uint32_t crc = png_crc(data, len, png_crc(head + 4, 4, 0));
+  uint8_t tail[4];
+  png_put32(tail, crc);
+  return (fwrite(head, 1, 8, f) == 8) && (fwrite(data, 1, len, f) == len) && (fwrite(tail, 1, 4, f) == 4);
+}
+
+bool Arduino_HostFramebuffer::writePng(const char *path) const
+{
+  // rows of filter byte 0 + RGB888, in zlib stored blocks of up to 65535 bytes
+  uint32_t raw_len = (uint32_t)_height * (1 + 3 * _width);
+  uint32_t blocks = (raw_len + 65534) / 65535;
+  uint32_t zlen = 2 + raw_len + 5 * blocks + 4;
+  uint8_t *z = (uint8_t *)malloc(zlen);
+  if (!z)
+  {
+    return false;
+  }
+
+  uint8_t *p = z;
+  *p++ = 0x78; // deflate, 32K window
+  *p++ = 0x01; // no preset dictionary, check bits
+  uint32_t a = 1, b = 0; // adler32
+  uint32_t left = 0;
+  for (uint32_t i = 0; i < raw_len; i++)
+  {
+    if (left == 0)
+    {
+      left = ((raw_len - i) > 65535) ? 65535 : (raw_len - i);
+      *p++ = (left == (raw_len - i)) ? 1 : 0; // BFINAL, BTYPE stored
+      *p++ = left;
+      *p++ = left >> 8;
+      *p++ = ~left;
+      *p++ = (~left) >> 8;
+    }
+    uint32_t row = i / (1 + 3 * _width);
+    uint32_t col = i % (1 + 3 * _width);
+    uint8_t v = 0;
+    if (col)
+    {
+      uint16_t c = _framebuffer[row * _width + (col - 1) / 3];
+      switch ((col - 1) % 3)
+      {
+      case 0:
+        v = ((c >> 8) & 0xF8) | (c >> 13);
+        break;
+      case 1:
+        v = ((c >> 3) & 0xFC) | ((c >> 9) & 0x03);
+        break;
+      default:
+        v = ((c << 3) & 0xF8) | ((c >> 2) & 0x07);
+        break;
+      }
+    }
+    *p++ = v;
+    a = (a + v) % 65521;
+    b = (b + a) % 65521;
+    --left;
+  }
+  png_put32(p, (b << 16) | a);
+
+  static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  uint8_t ihdr[13];
+  png_put32(ihdr, _width);
+  png_put32(ihdr + 4, _height);
+  ihdr[8] = 8;  // bit depth
+  ihdr[9] = 2;  // RGB
+  ihdr[10] = 0; // deflate
+  ihdr[11] = 0; // adaptive filtering
+  ihdr[12] = 0; // no interlace
+
+  bool ok = false;
+  FILE *f = fopen(path, "wb");
+  if (f)
+  {
+    ok = (fwrite(signature, 1, 8, f) == 8) &&
+         png_chunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+         png_chunk(f, "IDAT", z, zlen) &&
+         png_chunk(f, "IEND", nullptr, 0);
+    ok = (fclose(f) == 0) && ok;
+  }
+  free(z);
+  return ok;
+}
+
+bool Arduino_HostFramebuffer::readPng(const char *path, uint16_t *pixels) const
+{
+  FILE *f = fopen(path, "rb");
+  if (!f)
+  {
+    return false;
+  }
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *file = (size > 8) ? (uint8_t *)malloc(size) : nullptr;
+  bool ok = file && (fread(file, 1, size, f) == (size_t)size);
+  fclose(f);
+
+  // only what writePng() produces: one IHDR of this size, IDAT with stored blocks, filter 0 rows
+  uint32_t row_len = 1 + 3 * _width;
+  uint32_t raw_len = (uint32_t)_height * row_len;
+  uint8_t *raw = ok ? (uint8_t *)malloc(raw_len) : nullptr;
+  uint8_t *z = ok ? (uint8_t *)malloc(size) : nullptr;
+  uint32_t zlen = 0;
+  bool header = false;
+  ok = raw && z && (memcmp(file, "\x89PNG\r\n\x1A\n", 8) == 0);
+  for (long pos = 8; ok && (pos + 12 <= size);)
+  {
+    uint32_t len = png_get32(file + pos);
+    const uint8_t *type = file + pos + 4;
+    const uint8_t *data = file + pos + 8;
+    if ((uint32_t)(size - pos - 12) < len)
+    {
+      ok = false;
+    }
+    else if (memcmp(type, "IHDR", 4) == 0)
+    {
+      header = (len == 13) && (png_get32(data) == _width) && (png_get32(data + 4) == _height) &&
+               (data[8] == 8) && (data[9] == 2) && (data[12] == 0);
+      ok = header;
+    }
+    else if (memcmp(type, "IDAT", 4) == 0)
+    {
+      memcpy(z + zlen, data, len);
+      zlen += len;
+    }
+    else if (memcmp(type, "IEND", 4) == 0)
+    {
+      break;
+    }
+    pos += 12 + len;
+  }
+
+  uint32_t out = 0;
+  if (ok && header && (zlen > 2) && ((z[0] & 0x0F) == 8))
+  {
+    uint32_t pos = 2;
+    bool last = false;
+    while (ok && !last && (pos + 5 <= zlen))
+    {
+      last = z[pos] & 1;
+      ok = ((z[pos] >> 1) & 3) == 0; // stored
+      uint32_t len = z[pos + 1] | (z[pos + 2] << 8);
+      pos += 5;
+      if (ok && (pos + len <= zlen) && (out + len <= raw_len))
+      {
+        memcpy(raw + out, z + pos, len);
+        out += len;
+        pos += len;
+      }
+      else
+      {
+        ok = false;
+      }
+    }
+  }
+  ok = ok && (out == raw_len);
+
+  for (uint32_t y = 0; ok && (y < _height); y++)
+  {
+    const uint8_t *row = raw + y * row_len;
+    ok = (row[0] == 0);
+    for (uint32_t x = 0; ok && (x < _width); x++)
+    {
+      const uint8_t *rgb = row + 1 + 3 * x;
+      pixels[y * _width + x] = ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+    }
+  }
+
+  free(z);
+  free(raw);
+  free(file);
+  return ok;
+}
+
+int32_t Arduino_HostFramebuffer::comparePng(const char *path) const
+{
+  uint16_t *golden = (uint16_t *)malloc((size_t)_width * _height * sizeof(uint16_t));
+  if (!golden || !readPng(path, golden))
+  {
+    free(golden);
+    return -1;
+  }
+  int32_t diff = 0;
+  for (uint32_t i = 0; i < (uint32_t)_width * _height; i++)
+  {
+    if (golden[i] != _framebuffer[i])
+    {
+      ++diff;
+    }
+  }
+  free(golden);
+  return diff;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,79 @@
+#ifndef _ARDUINO_HOSTFRAMEBUFFER_H_
+#define _ARDUINO_HOSTFRAMEBUFFER_H_
+
+#include "../Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+/// Data bus without hardware: decodes the MIPI DCS column / row address set and memory write
+/// commands into an in-memory RGB565 frame memory and counts the bus traffic, so any
+/// Arduino_TFT driver (and the canvases flushing to it) can run, be measured and be
+/// snapshot-tested on a host.
+/// The frame memory is in controller address space: MADCTL rotation and mirroring are not
+/// applied, which matches the screen for rotation 0.
+class Arduino_HostFramebuffer : public Arduino_DataBus
+{
+public:
+  struct Stats
+  {
+    uint64_t commands;       ///< command bytes / words
+    uint64_t bytes;          ///< everything on the bus: commands + parameters + pixels
+    uint64_t pixels;         ///< pixels written to frame memory
+    uint64_t windows;        ///< memory writes (RAMWR), one per address window pushed
+    uint64_t window_changes; ///< column / row address sets, the window actually moved
+    uint64_t transactions;   ///< beginWrite() calls
+  };
+
+  /// @param width   frame memory columns, include the driver's column offset if any
+  /// @param height  frame memory rows, include the driver's row offset if any
+  Arduino_HostFramebuffer(uint16_t width, uint16_t height);
+  ~Arduino_HostFramebuffer();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+
+  uint16_t *getFramebuffer();
+  uint16_t width() const;
+  uint16_t height() const;
+  void fill(uint16_t color);
+
+  Stats getStats() const;
+  void resetStats();
+
+  /// 8-bit RGB PNG of the frame memory (uncompressed deflate, no dependencies)
+  bool writePng(const char *path) const;
+  /// Loads a PNG written by writePng() into pixels (width() * height()), other encoders are rejected
+  bool readPng(const char *path, uint16_t *pixels) const;
+  /// Pixels that differ from a PNG written by writePng(), -1 if it cannot be read or has another size
+  int32_t comparePng(const char *path) const;
+
+private:
+  void writeData(uint8_t d);
+  void writePixel(uint16_t p);
+
+  uint16_t *_framebuffer;
+  uint16_t _width, _height;
+
+  uint8_t _command;
+  uint8_t _params[4];
+  uint8_t _param_count;
+  bool _pixel_msb_pending;
+  uint8_t _pixel_msb;
+
+  uint16_t _x1, _x2, _y1, _y2; ///< address window
+  uint16_t _cur_x, _cur_y;     ///< memory write position
+
+  Stats _stats;
+};
+
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+#endif // _ARDUINO_HOSTFRAMEBUFFER_H_
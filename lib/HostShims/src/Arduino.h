@@ -0,0 +1,153 @@
+#ifndef HOST_SHIMS_ARDUINO_H
+#define HOST_SHIMS_ARDUINO_H
+
+// =============================================================================
+// Shim de Arduino.h para el env native (Linux)
+// =============================================================================
+// Cubre solo lo que usan los módulos del pipeline que compilan en host:
+// tiempo, log_*, String, Print y Serial. Serial escribe en stderr para que
+// stdout quede libre para el JSON del benchmark. Los GPIO no hacen nada (solo
+// para que compilen los drivers de Arduino_GFX en native-display).
+// =============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+
+// Solo el tipo, para las firmas print(const __FlashStringHelper*) de Arduino_GFX
+class __FlashStringHelper;
+
+// esp32-hal-log: errores y warnings a stderr, el resto se descarta
+#define log_e(fmt, ...) fprintf(stderr, "[E] " fmt "\n", ##__VA_ARGS__)
+#define log_w(fmt, ...) fprintf(stderr, "[W] " fmt "\n", ##__VA_ARGS__)
+#define log_i(fmt, ...) ((void)0)
+#define log_d(fmt, ...) ((void)0)
+
+// -----------------------------------------------------------------------------
+// String (sobre std::string)
+// -----------------------------------------------------------------------------
+
+class String {
+public:
+    String(const char* s = "") : s_(s ? s : "") {}
+    String(const std::string& s) : s_(s) {}
+    String(char c) : s_(1, c) {}
+    String(int v) : s_(std::to_string(v)) {}
+    String(unsigned v) : s_(std::to_string(v)) {}
+    String(long v) : s_(std::to_string(v)) {}
+    String(unsigned long v) : s_(std::to_string(v)) {}
+    String(double v, unsigned decimals = 2);
+
+    const char* c_str() const { return s_.c_str(); }
+    size_t length() const { return s_.size(); }
+    bool isEmpty() const { return s_.empty(); }
+    char operator[](size_t i) const { return s_[i]; }
+
+    bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+    bool endsWith(const String& p) const {
+        return s_.size() >= p.s_.size() &&
+               s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+    }
+    int indexOf(char c, size_t from = 0) const {
+        size_t i = s_.find(c, from);
+        return i == std::string::npos ? -1 : (int)i;
+    }
+    String substring(size_t from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+    String substring(size_t from, size_t to) const {
+        return from < to && from < s_.size() ? String(s_.substr(from, to - from)) : String();
+    }
+    void trim();
+    long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(s_.c_str(), nullptr); }
+
+    String& operator+=(const String& o) { s_ += o.s_; return *this; }
+    String& operator+=(const char* o) { s_ += o; return *this; }
+    String& operator+=(char c) { s_ += c; return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.s_ + b.s_); }
+    bool operator==(const String& o) const { return s_ == o.s_; }
+    bool operator!=(const String& o) const { return s_ != o.s_; }
+
+private:
+    std::string s_;
+};
+
+// -----------------------------------------------------------------------------
+// Print / Serial
+// -----------------------------------------------------------------------------
+
+class Print {
+public:
+    virtual ~Print() {}
+    // Como en el core: las subclases implementan al menos uno de los dos
+    virtual size_t write(uint8_t c) { return write(&c, 1); }
+    virtual size_t write(const uint8_t* data, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*data++);
+        return n;
+    }
+
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return printf("%d", v); }
+    size_t print(unsigned v) { return printf("%u", v); }
+    size_t print(long v) { return printf("%ld", v); }
+    size_t print(unsigned long v) { return printf("%lu", v); }
+    size_t print(double v, int decimals = 2) { return printf("%.*f", decimals, v); }
+
+    size_t println() { return print("\n"); }
+    template <typename T>
+    size_t println(const T& v) { return print(v) + println(); }
+    size_t println(double v, int decimals) { return print(v, decimals) + println(); }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HostSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    explicit operator bool() const { return true; }
+    int available() { return 0; }
+    int read() { return -1; }
+    void flush() { fflush(stderr); }
+    size_t write(const uint8_t* data, size_t len) override;
+    using Print::write;
+
+    // El benchmark silencia los logs durante las mediciones
+    void setMuted(bool muted) { muted_ = muted; }
+
+private:
+    bool muted_ = false;
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_SHIMS_ARDUINO_H
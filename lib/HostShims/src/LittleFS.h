@@ -0,0 +1,80 @@
+#ifndef HOST_SHIMS_LITTLEFS_H
+#define HOST_SHIMS_LITTLEFS_H
+
+// =============================================================================
+// Shim de LittleFS para el env native
+// =============================================================================
+// Monta un directorio del host como raíz: "/audio.wav" se resuelve a
+// <raíz>/audio.wav. La raíz es $HOST_FS_ROOT o "data" (el mismo directorio
+// que se sube con uploadfs), así los paths de config.h valen sin cambios.
+// =============================================================================
+
+#include <Arduino.h>
+#include <memory>
+
+namespace fs {
+
+class File : public Print {
+public:
+    File() {}
+
+    explicit operator bool() const { return impl_ != nullptr; }
+    void close() { impl_.reset(); }
+
+    size_t size() const;
+    size_t position() const;
+    bool seek(size_t pos);
+    int available();
+    int read();
+    size_t read(uint8_t* buf, size_t len);
+    String readStringUntil(char terminator);
+    size_t write(const uint8_t* data, size_t len) override;
+    using Print::write;
+    void flush();
+
+    const char* name() const;
+    const char* path() const;
+    bool isDirectory() const;
+    File openNextFile();
+
+private:
+    struct Impl;
+    explicit File(std::shared_ptr<Impl> impl) : impl_(impl) {}
+    std::shared_ptr<Impl> impl_;
+
+    friend class LittleFSFS;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end() {}
+
+    File open(const char* path, const char* mode = "r");
+    File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+    bool mkdir(const char* path);
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+
+    // totalBytes emula la partición spiffs de default.csv (0x160000);
+    // usedBytes suma los archivos reales bajo la raíz
+    size_t totalBytes();
+    size_t usedBytes();
+
+    // Path del host para un path de LittleFS
+    std::string hostPath(const char* path) const;
+};
+
+} // namespace fs
+
+using fs::File;
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // HOST_SHIMS_LITTLEFS_H
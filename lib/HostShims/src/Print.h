@@ -0,0 +1,7 @@
+#ifndef HOST_SHIMS_PRINT_H
+#define HOST_SHIMS_PRINT_H
+
+// Print vive en el shim de Arduino.h
+#include "Arduino.h"
+
+#endif // HOST_SHIMS_PRINT_H
@@ -0,0 +1,21 @@
+#ifndef HOST_SHIMS_SPI_H
+#define HOST_SHIMS_SPI_H
+
+// =============================================================================
+// Shim de SPI.h para el env native-display
+// =============================================================================
+// Los drivers de Arduino_GFX solo usan las constantes de modo; el bus real lo
+// reemplaza el bus de conteo del benchmark.
+// =============================================================================
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#endif // HOST_SHIMS_SPI_H
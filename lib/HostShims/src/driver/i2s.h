@@ -0,0 +1,34 @@
+#ifndef HOST_SHIMS_DRIVER_I2S_H
+#define HOST_SHIMS_DRIVER_I2S_H
+
+// =============================================================================
+// Shim de driver/i2s.h para el env native
+// =============================================================================
+// Solo los tipos que aparecen en la interfaz de Arduino_IIS_DriveBus, para
+// compilar Arduino_ReplayIIS y Arduino_MEMS en host. No hay driver.
+// =============================================================================
+
+typedef enum {
+    I2S_NUM_0 = 0,
+    I2S_NUM_1 = 1,
+    I2S_NUM_MAX,
+} i2s_port_t;
+
+typedef enum {
+    I2S_MODE_MASTER = (1 << 0),
+    I2S_MODE_SLAVE = (1 << 1),
+    I2S_MODE_TX = (1 << 2),
+    I2S_MODE_RX = (1 << 3),
+    I2S_MODE_DAC_BUILT_IN = (1 << 4),
+    I2S_MODE_PDM = (1 << 6),
+} i2s_mode_t;
+
+typedef enum {
+    I2S_CHANNEL_FMT_RIGHT_LEFT,
+    I2S_CHANNEL_FMT_ALL_RIGHT,
+    I2S_CHANNEL_FMT_ALL_LEFT,
+    I2S_CHANNEL_FMT_ONLY_RIGHT,
+    I2S_CHANNEL_FMT_ONLY_LEFT,
+} i2s_channel_fmt_t;
+
+#endif // HOST_SHIMS_DRIVER_I2S_H
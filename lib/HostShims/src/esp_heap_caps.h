@@ -0,0 +1,41 @@
+#ifndef HOST_SHIMS_ESP_HEAP_CAPS_H
+#define HOST_SHIMS_ESP_HEAP_CAPS_H
+
+// =============================================================================
+// Shim de esp_heap_caps.h para el env native
+// =============================================================================
+// Emula dos regiones con la capacidad del T-Circle S3 (PSRAM e interna):
+// una alocación que no entra devuelve nullptr igual que en el dispositivo.
+// Las estadísticas de uso se leen con host_heap_stats() (host_heap.h).
+// =============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MALLOC_CAP_EXEC     (1 << 0)
+#define MALLOC_CAP_32BIT    (1 << 1)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* heap_caps_malloc(size_t size, uint32_t caps);
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps);
+void heap_caps_free(void* ptr);
+
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_SHIMS_ESP_HEAP_CAPS_H
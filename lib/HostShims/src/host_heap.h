@@ -0,0 +1,37 @@
+#ifndef HOST_SHIMS_HOST_HEAP_H
+#define HOST_SHIMS_HOST_HEAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// Contadores de alocación del host (solo env native)
+// =============================================================================
+// heap_caps_* y operator new se cuentan por separado: las alocaciones del
+// pipeline pasan por heap_caps, las de TFLite/STL por new.
+// =============================================================================
+
+// Capacidad emulada de cada región (T-Circle S3: 8 MB OPI PSRAM)
+#ifndef HOST_PSRAM_BYTES
+#define HOST_PSRAM_BYTES (8u * 1024u * 1024u)
+#endif
+#ifndef HOST_DRAM_BYTES
+#define HOST_DRAM_BYTES (320u * 1024u)
+#endif
+
+struct HostHeapStats {
+    uint64_t caps_allocs;       // Llamadas a heap_caps_* exitosas
+    uint64_t caps_bytes;        // Bytes pedidos a heap_caps_*
+    uint64_t new_allocs;        // Llamadas a operator new
+    uint64_t new_bytes;
+    size_t psram_live_bytes;
+    size_t dram_live_bytes;
+    size_t peak_live_bytes;     // Pico PSRAM + interna desde el último reset
+};
+
+HostHeapStats host_heap_stats();
+
+// Reinicia el pico al uso actual (para medir una etapa aislada)
+void host_heap_reset_peak();
+
+#endif // HOST_SHIMS_HOST_HEAP_H
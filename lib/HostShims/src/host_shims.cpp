@@ -0,0 +1,378 @@
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "esp_heap_caps.h"
+#include "host_heap.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================================================================
+// Implementación - Shims de host
+// =============================================================================
+
+HostSerial Serial;
+fs::LittleFSFS LittleFS;
+
+// -----------------------------------------------------------------------------
+// Tiempo
+// -----------------------------------------------------------------------------
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+// -----------------------------------------------------------------------------
+// String / Print
+// -----------------------------------------------------------------------------
+
+String::String(double v, unsigned decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    s_ = buf;
+}
+
+void String::trim() {
+    size_t start = s_.find_first_not_of(" \t\r\n");
+    size_t end = s_.find_last_not_of(" \t\r\n");
+    s_ = start == std::string::npos ? std::string() : s_.substr(start, end - start + 1);
+}
+
+size_t Print::printf(const char* fmt, ...) {
+    char stackBuf[256];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(stackBuf, sizeof(stackBuf), fmt, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(stackBuf)) return write((const uint8_t*)stackBuf, len);
+
+    std::string big(len + 1, '\0');
+    va_start(args, fmt);
+    vsnprintf(&big[0], big.size(), fmt, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), len);
+}
+
+size_t HostSerial::write(const uint8_t* data, size_t len) {
+    if (muted_) return len;
+    return fwrite(data, 1, len, stderr);
+}
+
+// -----------------------------------------------------------------------------
+// heap_caps: dos regiones con capacidad fija y contadores
+// -----------------------------------------------------------------------------
+
+struct CapsBlock {
+    size_t size;
+    bool psram;
+};
+
+static std::mutex heapMutex;
+static std::unordered_map<void*, CapsBlock>& heap_blocks() {
+    static std::unordered_map<void*, CapsBlock>* blocks = new std::unordered_map<void*, CapsBlock>();
+    return *blocks;
+}
+static HostHeapStats heapStats = {};
+static size_t psramMinFree = HOST_PSRAM_BYTES;
+static size_t dramMinFree = HOST_DRAM_BYTES;
+
+// Atómicos aparte: el propio mapa de bloques usa new con heapMutex tomado
+static std::atomic<uint64_t> newAllocs(0);
+static std::atomic<uint64_t> newBytes(0);
+
+// MALLOC_CAP_SPIRAM va a la región PSRAM; el resto a la interna
+static bool caps_wants_psram(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) != 0;
+}
+
+static void* caps_alloc(size_t alignment, size_t size, uint32_t caps) {
+    if (size == 0) return nullptr;
+
+    std::lock_guard<std::mutex> lock(heapMutex);
+    bool psram = caps_wants_psram(caps);
+    size_t& live = psram ? heapStats.psram_live_bytes : heapStats.dram_live_bytes;
+    size_t capacity = psram ? HOST_PSRAM_BYTES : HOST_DRAM_BYTES;
+    if (live + size > capacity) return nullptr;
+
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) return nullptr;
+
+    heap_blocks()[ptr] = {size, psram};
+    live += size;
+    heapStats.caps_allocs++;
+    heapStats.caps_bytes += size;
+
+    size_t total = heapStats.psram_live_bytes + heapStats.dram_live_bytes;
+    if (total > heapStats.peak_live_bytes) heapStats.peak_live_bytes = total;
+    psramMinFree = std::min(psramMinFree, (size_t)HOST_PSRAM_BYTES - heapStats.psram_live_bytes);
+    dramMinFree = std::min(dramMinFree, (size_t)HOST_DRAM_BYTES - heapStats.dram_live_bytes);
+    return ptr;
+}
+
+extern "C" void* heap_caps_malloc(size_t size, uint32_t caps) {
+    return caps_alloc(sizeof(void*), size, caps);
+}
+
+extern "C" void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    if (size != 0 && n > SIZE_MAX / size) return nullptr;
+    void* ptr = caps_alloc(sizeof(void*), n * size, caps);
+    if (ptr) memset(ptr, 0, n * size);
+    return ptr;
+}
+
+extern "C" void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    return caps_alloc(alignment, size, caps);
+}
+
+extern "C" void heap_caps_free(void* ptr) {
+    if (!ptr) return;
+    {
+        std::lock_guard<std::mutex> lock(heapMutex);
+        auto it = heap_blocks().find(ptr);
+        if (it != heap_blocks().end()) {
+            size_t& live = it->second.psram ? heapStats.psram_live_bytes : heapStats.dram_live_bytes;
+            live -= it->second.size;
+            heap_blocks().erase(it);
+        }
+    }
+    free(ptr);
+}
+
+extern "C" size_t heap_caps_get_total_size(uint32_t caps) {
+    return caps_wants_psram(caps) ? HOST_PSRAM_BYTES : HOST_DRAM_BYTES;
+}
+
+extern "C" size_t heap_caps_get_free_size(uint32_t caps) {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    return caps_wants_psram(caps) ? HOST_PSRAM_BYTES - heapStats.psram_live_bytes
+                                  : HOST_DRAM_BYTES - heapStats.dram_live_bytes;
+}
+
+extern "C" size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    return caps_wants_psram(caps) ? psramMinFree : dramMinFree;
+}
+
+extern "C" size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    // Sin fragmentación emulada: el bloque más grande es todo lo libre
+    return heap_caps_get_free_size(caps);
+}
+
+HostHeapStats host_heap_stats() {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    HostHeapStats stats = heapStats;
+    stats.new_allocs = newAllocs.load();
+    stats.new_bytes = newBytes.load();
+    return stats;
+}
+
+void host_heap_reset_peak() {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    heapStats.peak_live_bytes = heapStats.psram_live_bytes + heapStats.dram_live_bytes;
+}
+
+// operator new: solo cantidad y bytes (sin tamaño en delete no hay bytes vivos)
+static void* counted_new(size_t size) {
+    newAllocs++;
+    newBytes += size;
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size) { return counted_new(size); }
+void* operator new[](size_t size) { return counted_new(size); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+// -----------------------------------------------------------------------------
+// LittleFS sobre un directorio del host
+// -----------------------------------------------------------------------------
+
+namespace fs {
+
+struct File::Impl {
+    std::string path;           // Path de LittleFS ("/rec/rec_0001.adp")
+    std::string hostPath;
+    FILE* fp = nullptr;
+    DIR* dir = nullptr;
+
+    ~Impl() {
+        if (fp) fclose(fp);
+        if (dir) closedir(dir);
+    }
+};
+
+size_t File::size() const {
+    if (!impl_ || !impl_->fp) return 0;
+    struct stat st;
+    fflush(impl_->fp);
+    return fstat(fileno(impl_->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+size_t File::position() const {
+    if (!impl_ || !impl_->fp) return 0;
+    long pos = ftell(impl_->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+bool File::seek(size_t pos) {
+    return impl_ && impl_->fp && fseek(impl_->fp, (long)pos, SEEK_SET) == 0;
+}
+
+int File::available() {
+    if (!impl_ || !impl_->fp) return 0;
+    size_t total = size();
+    size_t pos = position();
+    return pos < total ? (int)(total - pos) : 0;
+}
+
+int File::read() {
+    if (!impl_ || !impl_->fp) return -1;
+    int c = fgetc(impl_->fp);
+    return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t* buf, size_t len) {
+    if (!impl_ || !impl_->fp) return 0;
+    return fread(buf, 1, len, impl_->fp);
+}
+
+String File::readStringUntil(char terminator) {
+    std::string out;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) out += (char)c;
+    return String(out);
+}
+
+size_t File::write(const uint8_t* data, size_t len) {
+    if (!impl_ || !impl_->fp) return 0;
+    return fwrite(data, 1, len, impl_->fp);
+}
+
+void File::flush() {
+    if (impl_ && impl_->fp) fflush(impl_->fp);
+}
+
+const char* File::name() const {
+    if (!impl_) return "";
+    size_t slash = impl_->path.find_last_of('/');
+    return impl_->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+const char* File::path() const {
+    return impl_ ? impl_->path.c_str() : "";
+}
+
+bool File::isDirectory() const {
+    return impl_ && impl_->dir;
+}
+
+File File::openNextFile() {
+    if (!impl_ || !impl_->dir) return File();
+
+    struct dirent* ent;
+    while ((ent = readdir(impl_->dir)) != nullptr) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) continue;
+        std::string child = impl_->path;
+        if (child.empty() || child.back() != '/') child += '/';
+        child += ent->d_name;
+        return LittleFS.open(child.c_str(), "r");
+    }
+    return File();
+}
+
+std::string LittleFSFS::hostPath(const char* path) const {
+    const char* root = getenv("HOST_FS_ROOT");
+    std::string out = root && *root ? root : "data";
+    if (path[0] != '/') out += '/';
+    out += path;
+    return out;
+}
+
+bool LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+    struct stat st;
+    return stat(hostPath("/").c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+File LittleFSFS::open(const char* path, const char* mode) {
+    std::shared_ptr<File::Impl> impl = std::make_shared<File::Impl>();
+    impl->path = path;
+    impl->hostPath = hostPath(path);
+
+    struct stat st;
+    if (mode[0] == 'r' && stat(impl->hostPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        impl->dir = opendir(impl->hostPath.c_str());
+        return impl->dir ? File(impl) : File();
+    }
+
+    // Modos de Arduino ("r", "w", "a") en binario, igual que en LittleFS
+    std::string fmode = mode;
+    if (fmode.find('b') == std::string::npos) fmode += 'b';
+    impl->fp = fopen(impl->hostPath.c_str(), fmode.c_str());
+    return impl->fp ? File(impl) : File();
+}
+
+bool LittleFSFS::exists(const char* path) {
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    return ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool LittleFSFS::rename(const char* from, const char* to) {
+    return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool LittleFSFS::mkdir(const char* path) {
+    return ::mkdir(hostPath(path).c_str(), 0755) == 0 || exists(path);
+}
+
+size_t LittleFSFS::totalBytes() {
+    return 0x160000;
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t used = 0;
+    File root = open("/", "r");
+    File entry = root.openNextFile();
+    while (entry) {
+        used += entry.size();
+        entry = root.openNextFile();
+    }
+    return used;
+}
+
+} // namespace fs
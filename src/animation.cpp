@@ -0,0 +1,649 @@
+#include "animation.h"
+#include "config.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "esp_heap_caps.h"
+#include "Arduino_TFT.h"
+
+// =============================================================================
+// Implementación - Animaciones pre-decodificadas
+// =============================================================================
+
+// GIF: delay en centésimas; 0 y 1 se tratan como 100 ms, igual que los
+// navegadores (muchos GIFs los usan sin querer decir "lo más rápido posible")
+#define ANIM_DEFAULT_DELAY_MS 100
+
+#define LZW_MAX_CODES 4096
+
+// Un frame ya compuesto: rectángulo que cambia respecto del frame anterior
+struct AnimFrame {
+    uint16_t x, y, w, h;        // w = 0: igual al anterior, no se manda nada
+    uint16_t delay_ms;
+    uint32_t offset;            // Índices del rectángulo (w * h) en el bloque
+};
+
+struct Animation {
+    bool loaded;
+    uint16_t width;
+    uint16_t height;
+    uint16_t frameCount;
+    uint16_t colors;
+    uint32_t pixelsPerLoop;
+    uint32_t decodeMs;
+    // frameCount + 1 frames (el último vuelve del último frame al primero)
+    // y después los índices; todo en un bloque de PSRAM
+    uint8_t* block;
+    uint32_t blockBytes;
+    AnimFrame* frames;
+    const uint8_t* pixels;
+    // En SRAM interna: writeIndexedPixels la lee por cada píxel
+    uint16_t palette[256];
+};
+
+static Animation assets[ANIM_MAX_ASSETS];
+
+static Arduino_TFT* output = nullptr;
+static int playing = -1;
+static int16_t originX = 0;
+static int16_t originY = 0;
+static uint16_t currentFrame = 0;
+static uint32_t nextFrameMs = 0;
+
+static AnimStats stats = {};
+static uint32_t totalUs = 0;
+
+// -----------------------------------------------------------------------------
+// Decodificación (solo en anim_load)
+// -----------------------------------------------------------------------------
+
+struct GifReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool error;
+};
+
+static uint8_t read8(GifReader& r) {
+    if (r.pos >= r.size) {
+        r.error = true;
+        return 0;
+    }
+    return r.data[r.pos++];
+}
+
+static uint16_t read16(GifReader& r) {
+    uint16_t lo = read8(r);
+    return lo | (read8(r) << 8);
+}
+
+static void skip_sub_blocks(GifReader& r) {
+    uint8_t len;
+    while (!r.error && (len = read8(r)) != 0) r.pos += len;
+}
+
+static void read_color_table(GifReader& r, uint16_t* colors, int count) {
+    for (int i = 0; i < count; i++) {
+        uint8_t red = read8(r);
+        uint8_t green = read8(r);
+        uint8_t blue = read8(r);
+        colors[i] = RGB565(red, green, blue);
+    }
+}
+
+// Tabla LZW: cada código es prefijo + un byte, con el largo del string
+struct LzwTable {
+    uint16_t prefix[LZW_MAX_CODES];
+    uint16_t length[LZW_MAX_CODES];
+    uint8_t suffix[LZW_MAX_CODES];
+    uint8_t first[LZW_MAX_CODES];
+};
+
+// Estado de la composición de un GIF
+struct Decoder {
+    uint16_t width, height;
+    uint8_t* canvas;            // Frame compuesto (índices de la paleta única)
+    uint8_t* shown;             // Lo que ya tiene el panel (frame anterior)
+    uint8_t* first;             // Primer frame, para el delta de la vuelta
+    uint8_t* saved;             // Para disposal 3 (se aloca si hace falta)
+    LzwTable* lzw;
+
+    Animation* anim;            // Paleta única que se va armando
+    const uint16_t* table;      // Tabla de colores del frame (local o global)
+    int tableLen;
+    int16_t remap[256];         // Índice del GIF -> paleta única (-1: sin usar)
+    bool paletteFull;
+
+    // Rectángulo del frame e interlace
+    uint16_t fx, fy, fw, fh;
+    bool interlace;
+    int transparent;            // Índice transparente del GCE, -1 si no hay
+
+    // Deltas (crecen por duplicación mientras se decodifica)
+    AnimFrame* frames;
+    uint32_t frameCount, frameCap;
+    uint8_t* pool;
+    uint32_t poolUsed, poolCap;
+};
+
+static uint8_t palette_index(Decoder& d, uint8_t index) {
+    if (d.remap[index] >= 0) return (uint8_t)d.remap[index];
+    // Fuera de la tabla: negro (el GIF es inválido, pero no vale la pena fallar)
+    uint16_t color = (index < d.tableLen) ? d.table[index] : 0x0000;
+    Animation* a = d.anim;
+    int found = -1;
+    for (int i = 0; i < a->colors; i++) {
+        if (a->palette[i] == color) {
+            found = i;
+            break;
+        }
+    }
+    if (found < 0) {
+        if (a->colors == 256) {
+            d.paletteFull = true;
+            return 0;
+        }
+        found = a->colors++;
+        a->palette[found] = color;
+    }
+    d.remap[index] = found;
+    return (uint8_t)found;
+}
+
+// Fila real de la fila row-ésima de un frame entrelazado (4 pasadas)
+static uint16_t interlaced_row(uint16_t h, uint16_t row) {
+    uint16_t pass = (h + 7) / 8;
+    if (row < pass) return row * 8;
+    row -= pass;
+    pass = (h + 3) / 8;
+    if (row < pass) return row * 8 + 4;
+    row -= pass;
+    pass = (h + 1) / 4;
+    if (row < pass) return row * 4 + 2;
+    row -= pass;
+    return row * 2 + 1;
+}
+
+static inline void put_pixel(Decoder& d, uint32_t p, uint8_t index) {
+    if (p >= (uint32_t)d.fw * d.fh) return;
+    if (index == d.transparent) return;
+    uint16_t x = d.fx + p % d.fw;
+    uint16_t row = p / d.fw;
+    uint16_t y = d.fy + (d.interlace ? interlaced_row(d.fh, row) : row);
+    if (x >= d.width || y >= d.height) return;
+    d.canvas[(uint32_t)y * d.width + x] = palette_index(d, index);
+}
+
+// Descomprime los datos de imagen (sub-bloques LZW) sobre el canvas
+static bool decode_image(GifReader& r, Decoder& d) {
+    LzwTable& t = *d.lzw;
+    uint8_t minCodeSize = read8(r);
+    if (minCodeSize < 1 || minCodeSize > 11) return false;
+
+    uint16_t clearCode = 1 << minCodeSize;
+    uint16_t endCode = clearCode + 1;
+    for (uint16_t i = 0; i < clearCode; i++) {
+        t.prefix[i] = 0xFFFF;
+        t.length[i] = 1;
+        t.suffix[i] = (uint8_t)i;
+        t.first[i] = (uint8_t)i;
+    }
+    uint16_t nextCode = endCode + 1;
+    uint8_t codeSize = minCodeSize + 1;
+    int32_t prev = -1;
+
+    uint32_t out = 0;
+    uint32_t bits = 0;
+    uint8_t bitCount = 0;
+    uint8_t blockLeft = 0;
+
+    while (true) {
+        while (bitCount < codeSize) {
+            if (blockLeft == 0) {
+                blockLeft = read8(r);
+                if (blockLeft == 0 || r.error) return !r.error;  // Sin código de fin
+            }
+            bits |= (uint32_t)read8(r) << bitCount;
+            bitCount += 8;
+            blockLeft--;
+        }
+        uint16_t code = bits & ((1 << codeSize) - 1);
+        bits >>= codeSize;
+        bitCount -= codeSize;
+
+        if (code == clearCode) {
+            nextCode = endCode + 1;
+            codeSize = minCodeSize + 1;
+            prev = -1;
+            continue;
+        }
+        if (code == endCode) break;
+
+        if (prev >= 0) {
+            if (code > nextCode) return false;
+            if (nextCode < LZW_MAX_CODES) {
+                // code == nextCode: el string es prev + su propio primer byte
+                t.prefix[nextCode] = (uint16_t)prev;
+                t.length[nextCode] = t.length[prev] + 1;
+                t.first[nextCode] = t.first[prev];
+                t.suffix[nextCode] = (code == nextCode) ? t.first[prev] : t.first[code];
+                nextCode++;
+                if (nextCode == (1 << codeSize) && codeSize < 12) codeSize++;
+            }
+        } else if (code >= clearCode) {
+            return false;
+        }
+
+        // El string sale de atrás para adelante siguiendo los prefijos
+        uint16_t len = t.length[code];
+        uint16_t c = code;
+        for (int32_t k = len - 1; k >= 0; k--) {
+            put_pixel(d, out + k, t.suffix[c]);
+            c = t.prefix[c];
+        }
+        out += len;
+        prev = code;
+    }
+
+    // Resto del sub-bloque actual y los que queden hasta el terminador
+    r.pos += blockLeft;
+    skip_sub_blocks(r);
+    return !r.error;
+}
+
+static void* grow(void* buf, uint32_t used, uint32_t& cap, uint32_t need) {
+    if (need <= cap) return buf;
+    uint32_t size = cap ? cap : 4096;
+    while (size < need) size *= 2;
+    void* b = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    if (!b) return nullptr;
+    if (buf) {
+        memcpy(b, buf, used);
+        heap_caps_free(buf);
+    }
+    cap = size;
+    return b;
+}
+
+// Guarda el rectángulo en el que canvas difiere de prev
+static bool push_delta(Decoder& d, const uint8_t* prev, uint16_t delayMs) {
+    uint32_t frameBytes = (d.frameCount + 1) * sizeof(AnimFrame);
+    uint32_t frameUsed = d.frameCount * sizeof(AnimFrame);
+    void* frames = grow(d.frames, frameUsed, d.frameCap, frameBytes);
+    if (!frames) return false;
+    d.frames = (AnimFrame*)frames;
+
+    int x1 = d.width, y1 = d.height, x2 = -1, y2 = -1;
+    for (int y = 0; y < d.height; y++) {
+        const uint8_t* a = d.canvas + (uint32_t)y * d.width;
+        const uint8_t* b = prev ? prev + (uint32_t)y * d.width : nullptr;
+        for (int x = 0; x < d.width; x++) {
+            if (!b || a[x] != b[x]) {
+                if (x < x1) x1 = x;
+                if (x > x2) x2 = x;
+                if (y < y1) y1 = y;
+                y2 = y;
+            }
+        }
+    }
+
+    AnimFrame& f = d.frames[d.frameCount];
+    f.delay_ms = delayMs;
+    f.offset = d.poolUsed;
+    if (x2 < 0) {
+        f.x = f.y = f.w = f.h = 0;
+    } else {
+        f.x = x1;
+        f.y = y1;
+        f.w = x2 - x1 + 1;
+        f.h = y2 - y1 + 1;
+        uint32_t bytes = (uint32_t)f.w * f.h;
+        void* pool = grow(d.pool, d.poolUsed, d.poolCap, d.poolUsed + bytes);
+        if (!pool) return false;
+        d.pool = (uint8_t*)pool;
+        for (uint16_t row = 0; row < f.h; row++) {
+            memcpy(d.pool + d.poolUsed + (uint32_t)row * f.w,
+                   d.canvas + (uint32_t)(f.y + row) * d.width + f.x, f.w);
+        }
+        d.poolUsed += bytes;
+    }
+    d.frameCount++;
+    return true;
+}
+
+// Recorre el GIF y deja los deltas en d.frames / d.pool
+static bool decode_gif(GifReader& r, Decoder& d, const char* path) {
+    uint8_t signature[6];
+    for (int i = 0; i < 6; i++) signature[i] = read8(r);
+    if (memcmp(signature, "GIF87a", 6) != 0 && memcmp(signature, "GIF89a", 6) != 0) {
+        Serial.printf("[Anim] ERROR: %s no es un GIF\n", path);
+        return false;
+    }
+    d.width = read16(r);
+    d.height = read16(r);
+    uint8_t flags = read8(r);
+    uint8_t bgIndex = read8(r);
+    read8(r);  // Aspect ratio
+    // Tiene que entrar en su lugar en (ANIM_X, ANIM_Y) sin pisar el heatmap
+    if (d.width == 0 || d.height == 0 || d.width > ANIM_MAX_WIDTH || d.height > ANIM_MAX_HEIGHT) {
+        Serial.printf("[Anim] ERROR: %s mide %ux%u (máximo %dx%d)\n",
+                      path, d.width, d.height, ANIM_MAX_WIDTH, ANIM_MAX_HEIGHT);
+        return false;
+    }
+
+    static uint16_t globalTable[256];
+    static uint16_t localTable[256];
+    int globalLen = 0;
+    if (flags & 0x80) {
+        globalLen = 2 << (flags & 0x07);
+        read_color_table(r, globalTable, globalLen);
+    }
+
+    uint32_t area = (uint32_t)d.width * d.height;
+    d.canvas = (uint8_t*)heap_caps_malloc(area, MALLOC_CAP_SPIRAM);
+    d.shown = (uint8_t*)heap_caps_malloc(area, MALLOC_CAP_SPIRAM);
+    d.first = (uint8_t*)heap_caps_malloc(area, MALLOC_CAP_SPIRAM);
+    d.lzw = (LzwTable*)malloc(sizeof(LzwTable));
+    if (!d.canvas || !d.shown || !d.first || !d.lzw) {
+        Serial.printf("[Anim] ERROR: Sin memoria para decodificar %s\n", path);
+        return false;
+    }
+
+    // El fondo es el color de fondo de la tabla global (negro si no hay)
+    d.table = globalTable;
+    d.tableLen = globalLen;
+    memset(d.remap, 0xFF, sizeof(d.remap));
+    uint8_t background = palette_index(d, (bgIndex < globalLen) ? bgIndex : 0);
+    memset(d.canvas, background, area);
+
+    int disposal = 0;
+    int transparent = -1;
+    uint16_t delayMs = ANIM_DEFAULT_DELAY_MS;
+    // Disposal del frame anterior, que se aplica antes de dibujar el siguiente
+    int pendingDisposal = 0;
+    uint16_t px = 0, py = 0, pw = 0, ph = 0;
+
+    while (!r.error) {
+        uint8_t block = read8(r);
+        if (block == 0x3B) break;  // Trailer
+
+        if (block == 0x21) {
+            uint8_t label = read8(r);
+            if (label == 0xF9) {
+                // Graphic Control Extension: disposal, delay y transparencia
+                uint8_t size = read8(r);
+                size_t end = r.pos + size;
+                uint8_t packed = read8(r);
+                uint16_t delayCs = read16(r);
+                uint8_t tindex = read8(r);
+                r.pos = end;
+                disposal = (packed >> 2) & 0x07;
+                transparent = (packed & 0x01) ? tindex : -1;
+                delayMs = (delayCs <= 1) ? ANIM_DEFAULT_DELAY_MS : delayCs * 10;
+            }
+            skip_sub_blocks(r);
+            continue;
+        }
+
+        if (block != 0x2C) {
+            Serial.printf("[Anim] ERROR: Bloque 0x%02X inesperado en %s\n", block, path);
+            return false;
+        }
+
+        // Image Descriptor
+        d.fx = read16(r);
+        d.fy = read16(r);
+        d.fw = read16(r);
+        d.fh = read16(r);
+        uint8_t imageFlags = read8(r);
+        d.interlace = imageFlags & 0x40;
+        if (imageFlags & 0x80) {
+            d.tableLen = 2 << (imageFlags & 0x07);
+            read_color_table(r, localTable, d.tableLen);
+            d.table = localTable;
+        } else {
+            d.tableLen = globalLen;
+            d.table = globalTable;
+        }
+        memset(d.remap, 0xFF, sizeof(d.remap));
+        d.transparent = transparent;
+
+        if (pendingDisposal == 2) {
+            for (uint16_t y = py; y < py + ph && y < d.height; y++) {
+                uint16_t w = (px + pw > d.width) ? d.width - px : pw;
+                if (px < d.width) memset(d.canvas + (uint32_t)y * d.width + px, background, w);
+            }
+        } else if (pendingDisposal == 3 && d.saved) {
+            memcpy(d.canvas, d.saved, area);
+        }
+        if (disposal == 3) {
+            if (!d.saved) d.saved = (uint8_t*)heap_caps_malloc(area, MALLOC_CAP_SPIRAM);
+            if (!d.saved) {
+                Serial.printf("[Anim] ERROR: Sin memoria para decodificar %s\n", path);
+                return false;
+            }
+            memcpy(d.saved, d.canvas, area);
+        }
+
+        if (!decode_image(r, d)) {
+            Serial.printf("[Anim] ERROR: Datos LZW inválidos en %s (frame %u)\n",
+                          path, (unsigned)d.frameCount);
+            return false;
+        }
+        if (d.paletteFull) {
+            Serial.printf("[Anim] ERROR: %s usa más de 256 colores\n", path);
+            return false;
+        }
+
+        if (!push_delta(d, d.frameCount ? d.shown : nullptr, delayMs)) {
+            Serial.printf("[Anim] ERROR: Sin memoria para los frames de %s\n", path);
+            return false;
+        }
+        if (d.frameCount == 1) memcpy(d.first, d.canvas, area);
+        memcpy(d.shown, d.canvas, area);
+
+        pendingDisposal = disposal;
+        px = d.fx;
+        py = d.fy;
+        pw = d.fw;
+        ph = d.fh;
+        disposal = 0;
+        transparent = -1;
+        delayMs = ANIM_DEFAULT_DELAY_MS;
+    }
+
+    if (r.error || d.frameCount == 0) {
+        Serial.printf("[Anim] ERROR: %s está truncado o no tiene frames\n", path);
+        return false;
+    }
+
+    // Vuelta: del último frame al primero (el delay es el del primero)
+    memcpy(d.canvas, d.first, area);
+    if (!push_delta(d, d.shown, d.frames[0].delay_ms)) {
+        Serial.printf("[Anim] ERROR: Sin memoria para los frames de %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+static void free_decoder(Decoder& d) {
+    heap_caps_free(d.canvas);
+    heap_caps_free(d.shown);
+    heap_caps_free(d.first);
+    heap_caps_free(d.saved);
+    heap_caps_free(d.frames);
+    heap_caps_free(d.pool);
+    free(d.lzw);
+}
+
+// -----------------------------------------------------------------------------
+// Reproducción
+// -----------------------------------------------------------------------------
+
+static void draw_frame(const Animation& a, const AnimFrame& f) {
+    if (f.w == 0) return;
+
+    uint32_t startUs = micros();
+    output->drawIndexedBitmap(originX + f.x, originY + f.y, (uint8_t*)a.pixels + f.offset,
+                              (uint16_t*)a.palette, f.w, f.h);
+
+    uint32_t elapsedUs = micros() - startUs;
+    totalUs += elapsedUs;
+    stats.frames++;
+    stats.avg_us = totalUs / stats.frames;
+    if (elapsedUs > stats.max_us) stats.max_us = elapsedUs;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+int anim_load(const char* path) {
+    int id = -1;
+    for (int i = 0; i < ANIM_MAX_ASSETS; i++) {
+        if (!assets[i].loaded) {
+            id = i;
+            break;
+        }
+    }
+    if (id < 0) {
+        Serial.printf("[Anim] ERROR: Ya hay %d animaciones cargadas\n", ANIM_MAX_ASSETS);
+        return -1;
+    }
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("[Anim] ERROR: No se pudo montar LittleFS");
+        return -1;
+    }
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("[Anim] No existe %s\n", path);
+        return -1;
+    }
+
+    uint32_t startMs = millis();
+
+    // Una sola lectura secuencial: el decoder trabaja sobre PSRAM
+    size_t size = file.size();
+    uint8_t* data = (uint8_t*)heap_caps_malloc(size ? size : 1, MALLOC_CAP_SPIRAM);
+    if (!data) {
+        Serial.printf("[Anim] ERROR: Sin memoria para leer %s (%u bytes)\n", path, (unsigned)size);
+        file.close();
+        return -1;
+    }
+    size_t got = file.read(data, size);
+    file.close();
+
+    Animation& a = assets[id];
+    memset(&a, 0, sizeof(a));
+    Decoder d = {};
+    d.anim = &a;
+    GifReader r = {data, got, 0, got != size};
+
+    bool ok = decode_gif(r, d, path);
+    heap_caps_free(data);
+
+    if (ok) {
+        // Bloque final compacto: frames y después los índices
+        uint32_t frameBytes = d.frameCount * sizeof(AnimFrame);
+        a.blockBytes = frameBytes + d.poolUsed;
+        a.block = (uint8_t*)heap_caps_malloc(a.blockBytes, MALLOC_CAP_SPIRAM);
+        if (a.block) {
+            memcpy(a.block, d.frames, frameBytes);
+            if (d.poolUsed) memcpy(a.block + frameBytes, d.pool, d.poolUsed);
+            a.frames = (AnimFrame*)a.block;
+            a.pixels = a.block + frameBytes;
+            a.frameCount = d.frameCount - 1;
+            a.width = d.width;
+            a.height = d.height;
+            for (uint16_t i = 1; i <= a.frameCount; i++) {
+                a.pixelsPerLoop += (uint32_t)a.frames[i].w * a.frames[i].h;
+            }
+        } else {
+            Serial.printf("[Anim] ERROR: Sin memoria para los frames de %s\n", path);
+            ok = false;
+        }
+    }
+    free_decoder(d);
+
+    if (!ok) {
+        memset(&a, 0, sizeof(a));
+        return -1;
+    }
+
+    a.decodeMs = millis() - startMs;
+    a.loaded = true;
+    Serial.printf("[Anim] OK: %s %ux%u, %u frames, %u colores, %.1f KB en PSRAM (%u ms)\n",
+                  path, a.width, a.height, a.frameCount, a.colors,
+                  a.blockBytes / 1024.0f, (unsigned)a.decodeMs);
+    return id;
+}
+
+bool anim_get_info(int id, AnimInfo& info) {
+    if (id < 0 || id >= ANIM_MAX_ASSETS || !assets[id].loaded) return false;
+    const Animation& a = assets[id];
+    info.width = a.width;
+    info.height = a.height;
+    info.frames = a.frameCount;
+    info.colors = a.colors;
+    info.bytes = a.blockBytes;
+    info.pixels_per_loop = a.pixelsPerLoop;
+    info.decode_ms = a.decodeMs;
+    return true;
+}
+
+void anim_play(int id, Arduino_TFT* panel, int16_t x, int16_t y) {
+    anim_stop();
+    if (!panel || id < 0 || id >= ANIM_MAX_ASSETS || !assets[id].loaded) return;
+
+    output = panel;
+    originX = x;
+    originY = y;
+    playing = id;
+    currentFrame = 0;
+    stats = {};
+    totalUs = 0;
+
+    // El frame 0 es el frame completo (delta contra nada)
+    const Animation& a = assets[id];
+    draw_frame(a, a.frames[0]);
+    nextFrameMs = millis() + a.frames[0].delay_ms;
+}
+
+void anim_tick(uint32_t now_ms) {
+    if (playing < 0) return;
+    if ((int32_t)(now_ms - nextFrameMs) < 0) return;
+
+    const Animation& a = assets[playing];
+    currentFrame++;
+    if (currentFrame == a.frameCount) {
+        currentFrame = 0;
+        draw_frame(a, a.frames[a.frameCount]);
+    } else {
+        draw_frame(a, a.frames[currentFrame]);
+    }
+
+    uint16_t delayMs = a.frames[currentFrame].delay_ms;
+    nextFrameMs += delayMs;
+    if ((int32_t)(now_ms - nextFrameMs) >= 0) nextFrameMs = now_ms + delayMs;
+}
+
+void anim_stop() {
+    playing = -1;
+    output = nullptr;
+}
+
+bool anim_is_playing() {
+    return playing >= 0;
+}
+
+AnimStats anim_get_stats() {
+    return stats;
+}
+
+void anim_unload_all() {
+    anim_stop();
+    for (int i = 0; i < ANIM_MAX_ASSETS; i++) {
+        heap_caps_free(assets[i].block);
+        memset(&assets[i], 0, sizeof(assets[i]));
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// Animaciones pre-decodificadas (GIF -> frames indexados en PSRAM)
+// =============================================================================
+// anim_load() lee el GIF de LittleFS de una sola vez y lo decodifica entero al
+// arrancar: compone cada frame (transparencia, disposal, paletas locales) y
+// guarda solo el rectángulo que cambia respecto del frame anterior, como
+// índices de 8 bits sobre una paleta RGB565 única por animación. Los frames
+// quedan en un bloque de PSRAM; la paleta en SRAM interna.
+//
+// Durante la reproducción no hay LZW ni acceso a flash: anim_tick() manda el
+// rectángulo del frame con drawIndexedBitmap() cuando vence su delay. Un frame
+// sin cambios no manda nada.
+//
+//   int idle = anim_load("/anim_idle.gif");
+//   anim_play(idle, panel, x, y);
+//   ... anim_tick(millis()) seguido (p.ej. desde audio_set_poll_callback) ...
+//   anim_stop();
+//
+// Las animaciones se repiten siempre (se ignora el loop count del GIF).
+// =============================================================================
+
+class Arduino_TFT;
+
+// Animaciones cargadas a la vez (idle, escucha y margen)
+#ifndef ANIM_MAX_ASSETS
+#define ANIM_MAX_ASSETS 4
+#endif
+
+struct AnimInfo {
+    uint16_t width;
+    uint16_t height;
+    uint16_t frames;
+    uint16_t colors;           // Entradas usadas de la paleta
+    uint32_t bytes;            // Bloque en PSRAM (frames + índices)
+    uint32_t pixels_per_loop;  // Píxeles que se mandan en una vuelta completa
+    uint32_t decode_ms;        // Lectura + decodificación en anim_load()
+};
+
+struct AnimStats {
+    uint32_t frames;           // Frames mandados desde anim_play()
+    uint32_t avg_us;           // Por frame mandado (blit al panel)
+    uint32_t max_us;
+};
+
+// Decodifica el GIF (path de LittleFS). Retorna el id (>= 0) o -1 si falla:
+// archivo ausente, más grande que ANIM_MAX_WIDTH x ANIM_MAX_HEIGHT (config.h),
+// más de 256 colores en total o sin memoria
+int anim_load(const char* path);
+
+// false si el id no es una animación cargada
+bool anim_get_info(int id, AnimInfo& info);
+
+// Manda el primer frame completo con la esquina en (x, y) y deja la
+// animación corriendo. Reemplaza a la que estuviera corriendo
+void anim_play(int id, Arduino_TFT* panel, int16_t x, int16_t y);
+
+// Avanza al siguiente frame si ya venció su delay. Los frames son deltas y no
+// se pueden saltear: si se atrasó, el delay del siguiente cuenta desde ahora.
+// Firma de AudioPollCallback: audio_set_poll_callback(anim_tick)
+void anim_tick(uint32_t now_ms);
+
+// Deja el último frame en pantalla y no avanza más
+void anim_stop();
+
+bool anim_is_playing();
+
+AnimStats anim_get_stats();
+
+// Libera todas las animaciones (y detiene la que corre)
+void anim_unload_all();
+
+#endif // ANIMATION_H
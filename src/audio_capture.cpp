@@ -1,8 +1,15 @@
 #include "audio_capture.h"
 #include "config.h"
+#include "profiler.h"
 #include <Arduino.h>
+#ifdef ARDUINO
 #include "pin_config.h"
 #include "Arduino_DriveBus_Library.h"
+#else
+// En host no hay Wire ni driver I2S: solo la capa IIS del DriveBus
+#include "Arduino_IIS.h"
+#include "iis_chip/Arduino_MEMS.h"
+#endif
 
 // =============================================================================
 // Implementación - Captura de Audio I2S
@@ -10,11 +17,22 @@
 
 #define I2S_DATA_BIT 16
 
-static std::shared_ptr<Arduino_IIS_DriveBus> i2s_bus =
-    std::make_shared<Arduino_HWIIS>(I2S_NUM_0, MSM261_BCLK, MSM261_WS, MSM261_DATA);
-static std::unique_ptr<Arduino_IIS> microphone(new Arduino_MEMS(i2s_bus));
+static std::shared_ptr<Arduino_IIS_DriveBus> i2s_bus;
+static std::unique_ptr<Arduino_IIS> microphone;
+static AudioPollCallback pollCallback = nullptr;
 
+#ifdef ARDUINO
 bool audio_init() {
+    return audio_init_bus(
+        std::make_shared<Arduino_HWIIS>(I2S_NUM_0, MSM261_BCLK, MSM261_WS, MSM261_DATA));
+}
+#endif
+
+bool audio_init_bus(std::shared_ptr<Arduino_IIS_DriveBus> bus) {
+    if (microphone) microphone->end();
+    i2s_bus = bus;
+    microphone.reset(new Arduino_MEMS(i2s_bus));
+
     bool success = microphone->begin(
         I2S_MODE_MASTER,
         AD_IIS_DATA_IN,
@@ -33,12 +51,15 @@ bool audio_init() {
 }
 
 bool audio_capture(int16_t* buffer) {
-    Serial.println("[Audio] Grabando...");
+    if (!microphone) return false;
+
+    PROFILE_LOG("[Audio] Grabando...\n");
 
     size_t samples_captured = 0;
     unsigned long start_time = millis();
     unsigned long duration_ms = AUDIO_DURATION_SEC * 1000;
     int last_second = -1;
+    unsigned long last_poll_ms = start_time;
 
     while (millis() - start_time < duration_ms) {
         int16_t sample;
@@ -48,15 +69,23 @@ bool audio_capture(int16_t* buffer) {
             }
         }
 
+        if (pollCallback) {
+            unsigned long now = millis();
+            if (now != last_poll_ms) {
+                last_poll_ms = now;
+                pollCallback(now);
+            }
+        }
+
         // Progreso cada segundo
         int current_second = (millis() - start_time) / 1000;
         if (current_second > last_second && current_second <= AUDIO_DURATION_SEC) {
-            Serial.printf("[Audio] %d/%d seg\n", current_second, AUDIO_DURATION_SEC);
+            PROFILE_LOG("[Audio] %d/%d seg\n", current_second, AUDIO_DURATION_SEC);
             last_second = current_second;
         }
     }
 
-    Serial.printf("[Audio] Capturados: %d samples\n", samples_captured);
+    PROFILE_LOG("[Audio] Capturados: %d samples\n", samples_captured);
 
     if (samples_captured < AUDIO_SAMPLES * 0.9) {
         Serial.printf("[Audio] WARNING: Solo %.1f%% capturado\n",
@@ -66,55 +95,6 @@ bool audio_capture(int16_t* buffer) {
     return samples_captured > 0;
 }
 
-float audio_normalize(int16_t* buffer, float target_db) {
-    // Encontrar pico máximo
-    int16_t max_abs = 0;
-    for (int i = 0; i < AUDIO_SAMPLES; i++) {
-        int16_t abs_val = abs(buffer[i]);
-        if (abs_val > max_abs) max_abs = abs_val;
-    }
-
-    if (max_abs == 0) {
-        Serial.println("[Audio] WARNING: Silencio total");
-        return 1.0f;
-    }
-
-    // Calcular ganancia para alcanzar target_db
-    float target_linear = pow(10.0f, target_db / 20.0f);
-    int16_t target_peak = (int16_t)(target_linear * 32767);
-    float gain = (float)target_peak / max_abs;
-
-    // Aplicar ganancia con protección de clipping
-    for (int i = 0; i < AUDIO_SAMPLES; i++) {
-        int32_t scaled = (int32_t)(buffer[i] * gain);
-        buffer[i] = (int16_t)constrain(scaled, -32768, 32767);
-    }
-
-    Serial.printf("[Audio] Normalizado: pico %d -> %d (x%.2f)\n", max_abs, target_peak, gain);
-
-    return gain;
-}
-
-AudioStats audio_get_stats(const int16_t* buffer) {
-    AudioStats stats = {0, INT16_MIN, INT16_MAX, 0};
-    int64_t sum_squared = 0;
-    int16_t prev_sample = 0;
-
-    for (int i = 0; i < AUDIO_SAMPLES; i++) {
-        int16_t sample = buffer[i];
-        sum_squared += (int64_t)sample * sample;
-
-        if (sample > stats.peak_pos) stats.peak_pos = sample;
-        if (sample < stats.peak_neg) stats.peak_neg = sample;
-
-        // Zero crossing
-        if (i > 0 && ((prev_sample >= 0 && sample < 0) || (prev_sample < 0 && sample >= 0))) {
-            stats.zero_crossings++;
-        }
-        prev_sample = sample;
-    }
-
-    stats.rms = sqrt(sum_squared / (double)AUDIO_SAMPLES);
-
-    return stats;
+void audio_set_poll_callback(AudioPollCallback callback) {
+    pollCallback = callback;
 }
@@ -2,6 +2,9 @@
 #define AUDIO_CAPTURE_H
 
 #include <stdint.h>
+#include <memory>
+
+class Arduino_IIS_DriveBus;
 
 // =============================================================================
 // Captura de Audio I2S
@@ -14,15 +17,30 @@ struct AudioStats {
     int zero_crossings;
 };
 
-// Inicializa el micrófono I2S
+// Inicializa el micrófono I2S (solo en el dispositivo)
 // Retorna true si OK
 bool audio_init();
 
+// Igual que audio_init() pero sobre un bus dado (p.ej. Arduino_ReplayIIS en
+// host). Si ya había un bus, lo detiene y lo reemplaza
+bool audio_init_bus(std::shared_ptr<Arduino_IIS_DriveBus> bus);
+
 // Captura audio del micrófono y lo escribe en el buffer
 // El buffer debe tener espacio para AUDIO_SAMPLES muestras
 // Retorna true si la captura fue exitosa
 bool audio_capture(int16_t* buffer);
 
+// Se llama desde audio_capture() como mucho una vez por milisegundo mientras
+// graba, p.ej. para avanzar una animación (anim_tick). Corre entre lecturas
+// del I2S: tiene que volver antes de que se llenen los buffers DMA del
+// micrófono. nullptr la desactiva
+typedef void (*AudioPollCallback)(uint32_t now_ms);
+void audio_set_poll_callback(AudioPollCallback callback);
+
+// -----------------------------------------------------------------------------
+// Acondicionamiento (audio_conditioning.cpp, sin dependencia del I2S)
+// -----------------------------------------------------------------------------
+
 // Normaliza el audio a un nivel target en dB (ej: -1.0f)
 // Modifica el buffer in-place
 // Retorna el factor de ganancia aplicado
@@ -0,0 +1,63 @@
+#include "audio_capture.h"
+#include "config.h"
+#include "profiler.h"
+#include <Arduino.h>
+
+// =============================================================================
+// Implementación - Acondicionamiento de Audio
+// =============================================================================
+// Normalización y estadísticas. Separado de audio_capture.cpp porque no
+// depende del I2S y compila también en host (env native).
+
+float audio_normalize(int16_t* buffer, float target_db) {
+    // Encontrar pico máximo
+    int16_t max_abs = 0;
+    for (int i = 0; i < AUDIO_SAMPLES; i++) {
+        int16_t abs_val = abs(buffer[i]);
+        if (abs_val > max_abs) max_abs = abs_val;
+    }
+
+    if (max_abs == 0) {
+        Serial.println("[Audio] WARNING: Silencio total");
+        return 1.0f;
+    }
+
+    // Calcular ganancia para alcanzar target_db
+    float target_linear = pow(10.0f, target_db / 20.0f);
+    int16_t target_peak = (int16_t)(target_linear * 32767);
+    float gain = (float)target_peak / max_abs;
+
+    // Aplicar ganancia con protección de clipping
+    for (int i = 0; i < AUDIO_SAMPLES; i++) {
+        int32_t scaled = (int32_t)(buffer[i] * gain);
+        buffer[i] = (int16_t)constrain(scaled, -32768, 32767);
+    }
+
+    PROFILE_LOG("[Audio] Normalizado: pico %d -> %d (x%.2f)\n", max_abs, target_peak, gain);
+
+    return gain;
+}
+
+AudioStats audio_get_stats(const int16_t* buffer) {
+    AudioStats stats = {0, INT16_MIN, INT16_MAX, 0};
+    int64_t sum_squared = 0;
+    int16_t prev_sample = 0;
+
+    for (int i = 0; i < AUDIO_SAMPLES; i++) {
+        int16_t sample = buffer[i];
+        sum_squared += (int64_t)sample * sample;
+
+        if (sample > stats.peak_pos) stats.peak_pos = sample;
+        if (sample < stats.peak_neg) stats.peak_neg = sample;
+
+        // Zero crossing
+        if (i > 0 && ((prev_sample >= 0 && sample < 0) || (prev_sample < 0 && sample >= 0))) {
+            stats.zero_crossings++;
+        }
+        prev_sample = sample;
+    }
+
+    stats.rms = sqrt(sum_squared / (double)AUDIO_SAMPLES);
+
+    return stats;
+}
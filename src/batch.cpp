@@ -0,0 +1,287 @@
+#include "batch.h"
+#include "audio_capture.h"
+#include "mfcc_extractor.h"
+#include "wav_file.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "esp_heap_caps.h"
+
+// =============================================================================
+// Implementación - Modo batch
+// =============================================================================
+
+// Subdirectorios que se recorren dentro de BATCH_DIR (uno por emoción)
+static constexpr int MAX_DIR_DEPTH = 2;
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static bool ends_with_wav(const char* path) {
+    size_t len = strlen(path);
+    return len > 4 && strcasecmp(path + len - 4, ".wav") == 0;
+}
+
+// true si path[start, end) es exactamente el nombre de la emoción
+static bool matches_label(const char* start, const char* end, const char* label) {
+    size_t len = strlen(label);
+    return (size_t)(end - start) == len && strncasecmp(start, label, len) == 0;
+}
+
+static float elapsed_ms(unsigned long startUs) {
+    return (micros() - startUs) / 1000.0f;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+int batch_expected_label(const char* path) {
+    // Se prueba cada componente del path; en el nombre de archivo solo cuenta
+    // el prefijo hasta '_', '-', '.' o espacio
+    const char* component = path;
+    while (*component) {
+        while (*component == '/') component++;
+        const char* end = component;
+        while (*end && *end != '/') end++;
+
+        const char* prefixEnd = component;
+        while (prefixEnd < end && *prefixEnd != '_' && *prefixEnd != '-' &&
+               *prefixEnd != '.' && *prefixEnd != ' ') {
+            prefixEnd++;
+        }
+
+        for (int i = 0; i < NUM_EMOTIONS; i++) {
+            if (matches_label(component, end, EMOTION_LABELS[i]) ||
+                matches_label(component, prefixEnd, EMOTION_LABELS[i])) {
+                return i;
+            }
+        }
+        component = end;
+    }
+    return -1;
+}
+
+bool batch_process_file(const char* path, int16_t* audio, float* mfcc,
+                        uint32_t iteration, PipelineMetrics& metrics,
+                        BatchFileResult& result) {
+    metrics = {};
+    metrics.iteration = iteration;
+    metrics.timestamp_ms = millis();
+    metrics.psram_free_kb = heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024;
+    metrics.psram_used_kb = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / 1024 - metrics.psram_free_kb;
+    metrics.dram_free_kb = heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024;
+    metrics.emotion_index = -1;
+    metrics.peak_stage_dram = -1;
+    metrics.peak_stage_psram = -1;
+    metrics.cpu0_busy_pct = -1.0f;
+    metrics.cpu1_busy_pct = -1.0f;
+    metrics.context_switches = -1;
+
+    result = {};
+    result.samples = -1;
+    result.expected_index = batch_expected_label(path);
+    result.prediction.index = -1;
+
+    unsigned long startUs = micros();
+
+    // Lectura (ocupa el lugar de la captura)
+    WavInfo wav = {};
+    int32_t samples = wav_read_pcm16(path, audio, AUDIO_SAMPLES, &wav);
+    result.time_read_ms = elapsed_ms(startUs);
+    metrics.time_capture_ms = (unsigned long)result.time_read_ms;
+    result.sample_rate = wav.sample_rate;
+
+    if (samples <= 0) return false;
+    if (wav.sample_rate != (uint32_t)SAMPLE_RATE) {
+        // Sin resampleo: los MFCCs solo son válidos a la tasa del entrenamiento
+        Serial.printf("[Batch] %s: %u Hz (se espera %d Hz), se omite\n",
+                      path, (unsigned)wav.sample_rate, SAMPLE_RATE);
+        return false;
+    }
+    result.samples = samples;
+
+    unsigned long t = micros();
+    audio_normalize(audio);
+    result.time_normalize_ms = elapsed_ms(t);
+    metrics.time_normalize_ms = (unsigned long)result.time_normalize_ms;
+
+    AudioStats stats = audio_get_stats(audio);
+    metrics.audio_rms = stats.rms;
+    metrics.audio_peak_pos = stats.peak_pos;
+    metrics.audio_peak_neg = stats.peak_neg;
+
+    t = micros();
+    mfcc_extract(audio, mfcc);
+    result.time_mfcc_ms = elapsed_ms(t);
+    metrics.time_mfcc_ms = (unsigned long)result.time_mfcc_ms;
+
+    t = micros();
+    result.prediction = model_predict(mfcc);
+    result.time_inference_ms = elapsed_ms(t);
+    metrics.time_inference_ms = (unsigned long)result.time_inference_ms;
+
+    result.time_total_ms = elapsed_ms(startUs);
+    metrics.time_total_ms = (unsigned long)result.time_total_ms;
+
+    MfccFrameTiming frameTiming = mfcc_get_frame_timing();
+    metrics.mfcc_frame_avg_us = frameTiming.avg_us;
+    metrics.mfcc_frame_max_us = frameTiming.max_us;
+    metrics.invoke_us = model_get_last_invoke_us();
+
+    // model_predict indica el error con la etiqueta "error"
+    if (!result.prediction.label || strcmp(result.prediction.label, "error") == 0) {
+        result.samples = -1;
+        return false;
+    }
+
+    metrics.emotion_index = result.prediction.index;
+    metrics.confidence = result.prediction.confidence;
+    return true;
+}
+
+void batch_write_results_header(Print& out) {
+    out.println("iteration,file,samples,sample_rate,expected,predicted,confidence,correct,"
+                "time_read_ms,time_normalize_ms,time_mfcc_ms,time_inference_ms,time_total_ms");
+}
+
+void batch_write_result_row(Print& out, uint32_t iteration, const char* path,
+                            const BatchFileResult& result) {
+    const char* expected = result.expected_index >= 0 ? EMOTION_LABELS[result.expected_index] : "";
+    const char* predicted = result.samples >= 0 ? EMOTION_LABELS[result.prediction.index] : "error";
+    int correct = result.expected_index >= 0 && result.samples >= 0
+                      ? (result.expected_index == result.prediction.index ? 1 : 0)
+                      : -1;
+
+    out.printf("%u,%s,%d,%u,%s,%s,%.4f,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+               iteration, path, result.samples, (unsigned)result.sample_rate,
+               expected, predicted, result.prediction.confidence, correct,
+               result.time_read_ms, result.time_normalize_ms, result.time_mfcc_ms,
+               result.time_inference_ms, result.time_total_ms);
+}
+
+void batch_summary_add(BatchSummary& summary, const BatchFileResult& result) {
+    summary.files++;
+    if (result.samples < 0) {
+        summary.failed++;
+        return;
+    }
+
+    summary.audio_sec += (double)result.samples / SAMPLE_RATE;
+    summary.pipeline_ms += result.time_total_ms;
+
+    if (result.expected_index >= 0) {
+        summary.labeled++;
+        summary.confusion[result.expected_index][result.prediction.index]++;
+        if (result.expected_index == result.prediction.index) summary.correct++;
+    }
+}
+
+void batch_print_summary(Print& out, const BatchSummary& summary, double wall_ms) {
+    uint32_t processed = summary.files - summary.failed;
+
+    out.println("\n========== BATCH ==========");
+    out.printf("Archivos:    %u (%u con error)\n", summary.files, summary.failed);
+    if (summary.labeled > 0) {
+        out.printf("Accuracy:    %.2f%% (%u/%u con etiqueta)\n",
+                   100.0 * summary.correct / summary.labeled, summary.correct, summary.labeled);
+    } else {
+        out.println("Accuracy:    - (ningún path con etiqueta)");
+    }
+    if (wall_ms > 0 && processed > 0) {
+        out.printf("Throughput:  %.2f archivos/s, %.1fx tiempo real\n",
+                   processed * 1000.0 / wall_ms, summary.audio_sec * 1000.0 / wall_ms);
+        out.printf("Pipeline:    %.1f ms/archivo promedio\n", summary.pipeline_ms / processed);
+    }
+
+    if (summary.labeled == 0) return;
+
+    // Matriz de confusión: filas = esperada, columnas = predicha
+    out.printf("\n%-10s", "");
+    for (int p = 0; p < NUM_EMOTIONS; p++) out.printf(" %8.8s", EMOTION_LABELS[p]);
+    out.println();
+    for (int e = 0; e < NUM_EMOTIONS; e++) {
+        out.printf("%-10s", EMOTION_LABELS[e]);
+        for (int p = 0; p < NUM_EMOTIONS; p++) out.printf(" %8u", summary.confusion[e][p]);
+        out.println();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Dispositivo: recorrido secuencial de LittleFS
+// -----------------------------------------------------------------------------
+
+struct DeviceBatch {
+    int16_t* audio;
+    float* mfcc;
+    File results;
+    BatchSummary summary;
+    uint32_t iteration;
+};
+
+static void run_dir(DeviceBatch& batch, const char* dir, int depth) {
+    File root = LittleFS.open(dir);
+    if (!root || !root.isDirectory()) return;
+
+    File entry = root.openNextFile();
+    while (entry) {
+        String path = entry.path();
+        bool isDir = entry.isDirectory();
+        entry.close();
+
+        if (isDir) {
+            if (depth < MAX_DIR_DEPTH) run_dir(batch, path.c_str(), depth + 1);
+        } else if (ends_with_wav(path.c_str())) {
+            PipelineMetrics metrics;
+            BatchFileResult result;
+            batch.iteration++;
+            batch_process_file(path.c_str(), batch.audio, batch.mfcc,
+                               batch.iteration, metrics, result);
+
+            if (batch.results) {
+                batch_write_result_row(batch.results, batch.iteration, path.c_str(), result);
+            }
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
+            if (result.samples >= 0) profiler_log_iteration(metrics);
+#endif
+            batch_summary_add(batch.summary, result);
+
+            Serial.printf("[Batch] #%u %s -> %s (%.1f%%)\n", batch.iteration, path.c_str(),
+                          result.samples >= 0 ? result.prediction.label : "error",
+                          result.prediction.confidence * 100);
+        }
+        entry = root.openNextFile();
+    }
+}
+
+int batch_run_dir(const char* dir, int16_t* audio, float* mfcc) {
+    if (!LittleFS.begin(true)) {
+        Serial.println("[Batch] ERROR: No se pudo montar LittleFS");
+        return 0;
+    }
+    if (!LittleFS.exists(dir)) {
+        Serial.printf("[Batch] ERROR: No existe %s (subir WAVs con uploadfs)\n", dir);
+        return 0;
+    }
+
+    DeviceBatch batch = {};
+    batch.audio = audio;
+    batch.mfcc = mfcc;
+    batch.results = LittleFS.open(BATCH_RESULTS_FILENAME, "w");
+    if (batch.results) {
+        batch_write_results_header(batch.results);
+    } else {
+        Serial.printf("[Batch] WARNING: No se pudo crear %s\n", BATCH_RESULTS_FILENAME);
+    }
+
+    Serial.printf("[Batch] Procesando %s...\n", dir);
+    unsigned long startMs = millis();
+    run_dir(batch, dir, 0);
+    unsigned long wallMs = millis() - startMs;
+
+    if (batch.results) batch.results.close();
+
+    batch_print_summary(Serial, batch.summary, wallMs);
+    Serial.printf("[Batch] Resultados en %s\n", BATCH_RESULTS_FILENAME);
+    return (int)batch.summary.files;
+}
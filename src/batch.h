@@ -0,0 +1,83 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+#include "emotion_model.h"
+#include "profiler.h"
+
+class Print;
+
+// =============================================================================
+// Modo batch - Pipeline sobre WAVs en vez del micrófono
+// =============================================================================
+// Cada archivo pasa por lectura -> normalización -> MFCC -> inferencia y
+// produce una fila de resultados (predicción vs etiqueta esperada) y un
+// PipelineMetrics con el formato del CSV del profiler. La lectura del WAV
+// ocupa el lugar de STAGE_CAPTURE.
+//
+// La etiqueta esperada sale del path: un directorio o prefijo de archivo con
+// el nombre de una emoción de EMOTION_LABELS (/batch/happy/01.wav,
+// /batch/sad_017.wav). Sin etiqueta el archivo cuenta para throughput pero
+// no para accuracy.
+//
+// Dispositivo: comando 'b' sobre BATCH_DIR (secuencial).
+// Host: env native-batch, un intérprete por hilo (src/host/batch_main.cpp).
+// =============================================================================
+
+// Resultado de un archivo
+struct BatchFileResult {
+    int32_t samples;            // Muestras leídas (-1 = no se pudo procesar)
+    uint32_t sample_rate;
+    int expected_index;         // -1 si el path no tiene etiqueta
+    EmotionResult prediction;
+
+    // Tiempos por etapa (ms con decimales; PipelineMetrics los redondea)
+    float time_read_ms;
+    float time_normalize_ms;
+    float time_mfcc_ms;
+    float time_inference_ms;
+    float time_total_ms;
+};
+
+// Totales de una corrida
+struct BatchSummary {
+    uint32_t files;
+    uint32_t failed;
+    uint32_t labeled;
+    uint32_t correct;
+    double audio_sec;           // Audio procesado (sin el relleno de ceros)
+    double pipeline_ms;         // Suma de los tiempos de pipeline
+    uint32_t confusion[NUM_EMOTIONS][NUM_EMOTIONS];   // [esperada][predicha]
+};
+
+// Etiqueta esperada según el path, -1 si no tiene
+int batch_expected_label(const char* path);
+
+// Procesa un WAV con los buffers dados (AUDIO_SAMPLES y N_MFCC * N_FRAMES).
+// Requiere mfcc_init() y model_load() en el hilo que llama. No usa el estado
+// global del profiler, así que en host puede correr en varios hilos.
+// Retorna false si el archivo no se pudo leer o no es de SAMPLE_RATE Hz
+bool batch_process_file(const char* path, int16_t* audio, float* mfcc,
+                        uint32_t iteration, PipelineMetrics& metrics,
+                        BatchFileResult& result);
+
+// CSV de resultados por archivo
+void batch_write_results_header(Print& out);
+void batch_write_result_row(Print& out, uint32_t iteration, const char* path,
+                            const BatchFileResult& result);
+
+// Acumula un archivo en el resumen
+void batch_summary_add(BatchSummary& summary, const BatchFileResult& result);
+
+// Imprime accuracy, matriz de confusión y throughput
+// wall_ms: tiempo real de la corrida (con varios hilos es menor que pipeline_ms)
+void batch_print_summary(Print& out, const BatchSummary& summary, double wall_ms);
+
+// Dispositivo: procesa todos los .wav de dir en LittleFS, escribe
+// BATCH_RESULTS_FILENAME y registra cada archivo en el CSV del profiler
+// Retorna la cantidad de archivos procesados
+int batch_run_dir(const char* dir, int16_t* audio, float* mfcc);
+
+#endif // BATCH_H
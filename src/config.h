@@ -8,12 +8,15 @@
 // NO modificar sin reentrenar el modelo.
 // =============================================================================
 
+#include "model_embedded.h"
+
 #define VERSION "v5.3-profiling-csv"
 
 // -----------------------------------------------------------------------------
 // Modelo
 // -----------------------------------------------------------------------------
-constexpr const char* MODEL_PATH = "/ser_202601_optimized_int8.tflite";
+// El mismo archivo de data/ que se puede embeber en flash (model_embedded.h)
+constexpr const char* MODEL_PATH = "/" MODEL_FILE_NAME;
 
 // -----------------------------------------------------------------------------
 // Audio (definido por el dataset de entrenamiento)
@@ -43,10 +46,68 @@ constexpr const char* EMOTION_LABELS[] = {
     "anger", "disgust", "fear", "happy", "neutral", "sad", "surprise"
 };
 
+// -----------------------------------------------------------------------------
+// Grabación de ventanas (sets de regresión)
+// -----------------------------------------------------------------------------
+// Cada ventana de 4 s ocupa ~87 KB en IMA-ADPCM (vs 345 KB en PCM)
+constexpr const char* REC_DIR = "/rec";
+constexpr int REC_MAX_FILES = 3;           // Archivos que se conservan (rotación)
+constexpr int REC_WINDOWS_PER_FILE = 4;    // Ventanas por archivo
+
+// -----------------------------------------------------------------------------
+// Modo batch (WAVs desde LittleFS en vez del micrófono, ver batch.h)
+// -----------------------------------------------------------------------------
+constexpr const char* BATCH_DIR = "/batch";
+constexpr const char* BATCH_RESULTS_FILENAME = "/batch_results.csv";
+
+// Estado de los módulos del pipeline (MFCC, intérprete): en host el batch
+// corre un intérprete por hilo; en el ESP32 hay una sola tarea de pipeline
+#ifdef ARDUINO
+#define PIPELINE_THREAD_LOCAL
+#else
+#define PIPELINE_THREAD_LOCAL thread_local
+#endif
+
 // -----------------------------------------------------------------------------
 // Hardware - Micrófono I2S (T-Circle S3)
 // -----------------------------------------------------------------------------
 // Los pines están definidos en pin_config.h:
 // MSM261_BCLK = GPIO7, MSM261_WS = GPIO9, MSM261_DATA = GPIO8
 
+// -----------------------------------------------------------------------------
+// Pantalla - GC9D01N redondo 160x160 (T-Circle S3)
+// -----------------------------------------------------------------------------
+// Heatmap de los MFCCs en vivo (ver mfcc_heatmap.h). Apagado por defecto: cada
+// columna se manda por SPI desde mfcc_extract() y entraría en los tiempos de
+// MFCC. Lo prende el env t-circle-s3-RV-display
+#ifndef DISPLAY_HEATMAP
+#define DISPLAY_HEATMAP 0
+#endif
+
+// Esquina del heatmap (N_FRAMES x N_MFCC píxeles) dentro del disco visible
+constexpr int HEATMAP_X = 30;
+constexpr int HEATMAP_Y = 60;
+
+// Rango de los MFCCs normalizados que cubre la paleta; fuera se satura
+constexpr float HEATMAP_MIN = -2.5f;
+constexpr float HEATMAP_MAX = 2.5f;
+
+// Animaciones de espera y de escucha (ver animation.h): GIFs de LittleFS que
+// se decodifican una vez al arrancar y se reproducen desde PSRAM. Si falta un
+// archivo esa animación no se muestra
+#ifndef DISPLAY_ANIMATIONS
+#define DISPLAY_ANIMATIONS DISPLAY_HEATMAP
+#endif
+constexpr const char* ANIM_IDLE_PATH = "/anim_idle.gif";
+constexpr const char* ANIM_LISTEN_PATH = "/anim_listen.gif";
+
+// Lugar de las animaciones: arriba del heatmap y dentro del disco visible.
+// anim_load() rechaza los GIFs más grandes (tools/gen_anim_gifs.py genera
+// los de data/)
+constexpr int ANIM_X = 56;
+constexpr int ANIM_Y = 8;
+constexpr int ANIM_MAX_WIDTH = 48;
+constexpr int ANIM_MAX_HEIGHT = 48;
+static_assert(ANIM_Y + ANIM_MAX_HEIGHT <= HEATMAP_Y, "Las animaciones pisan el heatmap");
+
 #endif // CONFIG_H
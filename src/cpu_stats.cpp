@@ -0,0 +1,283 @@
+#include "cpu_stats.h"
+#include <string.h>
+
+// =============================================================================
+// Implementación - CPU Stats
+// =============================================================================
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+
+struct TaskSnapshot {
+    TaskHandle_t handle;
+    uint32_t runtime;
+};
+
+static TaskStatus_t statusBuffer[CPU_STATS_MAX_TASKS];
+static TaskSnapshot baseline[CPU_STATS_MAX_TASKS];
+static UBaseType_t baselineCount = 0;
+static uint32_t baselineTotal = 0;
+
+bool cpu_stats_begin() {
+    uint32_t total = 0;
+    baselineCount = uxTaskGetSystemState(statusBuffer, CPU_STATS_MAX_TASKS, &total);
+    baselineTotal = total;
+
+    for (UBaseType_t i = 0; i < baselineCount; i++) {
+        baseline[i].handle = statusBuffer[i].xHandle;
+        baseline[i].runtime = statusBuffer[i].ulRunTimeCounter;
+    }
+
+    return baselineCount > 0;
+}
+
+void cpu_stats_end(CpuStats& stats) {
+    uint32_t total = 0;
+    UBaseType_t count = uxTaskGetSystemState(statusBuffer, CPU_STATS_MAX_TASKS, &total);
+
+    // El contador de run-time es de 32 bits en us: la resta sin signo cubre un wrap
+    uint32_t window = total - baselineTotal;
+
+    stats.window_us = window;
+    stats.context_switches = -1;  // FreeRTOS no lo expone sin trace hooks
+    stats.task_count = 0;
+    for (int c = 0; c < CPU_STATS_NUM_CORES; c++) {
+        stats.core_busy_pct[c] = -1.0f;
+    }
+
+    if (window == 0) return;
+
+    TaskHandle_t idleTasks[CPU_STATS_NUM_CORES];
+    for (int c = 0; c < CPU_STATS_NUM_CORES; c++) {
+        idleTasks[c] = xTaskGetIdleTaskHandleForCPU(c);
+    }
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t& status = statusBuffer[i];
+
+        // Tareas creadas dentro de la ventana arrancan en 0
+        uint32_t previous = 0;
+        for (UBaseType_t j = 0; j < baselineCount; j++) {
+            if (baseline[j].handle == status.xHandle) {
+                previous = baseline[j].runtime;
+                break;
+            }
+        }
+
+        float pct = (status.ulRunTimeCounter - previous) * 100.0f / window;
+
+        for (int c = 0; c < CPU_STATS_NUM_CORES; c++) {
+            if (status.xHandle == idleTasks[c]) {
+                stats.core_busy_pct[c] = 100.0f - pct;
+            }
+        }
+
+        TaskCpuStats& task = stats.tasks[stats.task_count++];
+        strlcpy(task.name, status.pcTaskName, sizeof(task.name));
+        BaseType_t affinity = xTaskGetAffinity(status.xHandle);
+        task.core = (affinity == tskNO_AFFINITY) ? -1 : (int8_t)affinity;
+        task.busy_pct = pct;
+        task.stack_free_bytes = status.usStackHighWaterMark;
+    }
+}
+
+#else
+
+// Sin run-time stats en el sdkconfig: solo se reporta la ventana
+static unsigned long baselineMicros = 0;
+
+bool cpu_stats_begin() {
+    baselineMicros = micros();
+    return false;
+}
+
+void cpu_stats_end(CpuStats& stats) {
+    stats.window_us = micros() - baselineMicros;
+    stats.context_switches = -1;
+    stats.task_count = 0;
+    for (int c = 0; c < CPU_STATS_NUM_CORES; c++) {
+        stats.core_busy_pct[c] = -1.0f;
+    }
+}
+
+#endif
+
+#else  // Host (Linux)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/resource.h>
+
+struct CoreTimes {
+    uint64_t busy;
+    uint64_t total;
+};
+
+struct ThreadSnapshot {
+    int tid;
+    uint64_t ticks;
+};
+
+static CoreTimes baselineCores[CPU_STATS_NUM_CORES];
+static ThreadSnapshot baselineThreads[CPU_STATS_MAX_TASKS];
+static int baselineThreadCount = 0;
+static long baselineSwitches = 0;
+static uint64_t baselineNs = 0;
+
+static uint64_t now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static long read_context_switches() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+// Lee las líneas cpuN de /proc/stat (en jiffies)
+static void read_core_times(CoreTimes* cores) {
+    memset(cores, 0, sizeof(CoreTimes) * CPU_STATS_NUM_CORES);
+
+    FILE* f = fopen("/proc/stat", "r");
+    if (!f) return;
+
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        int core;
+        unsigned long long user, nice, system, idle, iowait, irq, softirq, steal;
+        if (sscanf(line, "cpu%d %llu %llu %llu %llu %llu %llu %llu %llu", &core,
+                   &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal) != 9) {
+            continue;
+        }
+        if (core < 0 || core >= CPU_STATS_NUM_CORES) continue;
+
+        uint64_t busy = user + nice + system + irq + softirq + steal;
+        cores[core].busy = busy;
+        cores[core].total = busy + idle + iowait;
+    }
+    fclose(f);
+}
+
+// Lee utime + stime, nombre y último núcleo de un thread del proceso
+static bool read_thread(int tid, TaskCpuStats* task, uint64_t* ticks) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    char buffer[512];
+    size_t len = fread(buffer, 1, sizeof(buffer) - 1, f);
+    fclose(f);
+    buffer[len] = '\0';
+
+    // El nombre va entre paréntesis y puede contener espacios
+    char* open = strchr(buffer, '(');
+    char* close = strrchr(buffer, ')');
+    if (!open || !close) return false;
+
+    size_t nameLen = close - open - 1;
+    if (nameLen >= sizeof(task->name)) nameLen = sizeof(task->name) - 1;
+    memcpy(task->name, open + 1, nameLen);
+    task->name[nameLen] = '\0';
+
+    // Campos a partir de "state" (campo 3): utime = 14, stime = 15, processor = 39
+    unsigned long long utime = 0, stime = 0;
+    int processor = -1;
+    char* field = close + 2;
+    for (int index = 3; field && *field; index++) {
+        if (index == 14) utime = strtoull(field, nullptr, 10);
+        if (index == 15) stime = strtoull(field, nullptr, 10);
+        if (index == 39) {
+            processor = atoi(field);
+            break;
+        }
+        field = strchr(field, ' ');
+        if (field) field++;
+    }
+
+    *ticks = utime + stime;
+    task->core = (int8_t)processor;
+    task->stack_free_bytes = 0;
+    return true;
+}
+
+template <typename Fn>
+static void for_each_thread(Fn fn) {
+    DIR* dir = opendir("/proc/self/task");
+    if (!dir) return;
+
+    dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        int tid = atoi(entry->d_name);
+        if (tid > 0) fn(tid);
+    }
+    closedir(dir);
+}
+
+bool cpu_stats_begin() {
+    read_core_times(baselineCores);
+    baselineSwitches = read_context_switches();
+    baselineNs = now_ns();
+
+    baselineThreadCount = 0;
+    for_each_thread([](int tid) {
+        if (baselineThreadCount >= CPU_STATS_MAX_TASKS) return;
+        TaskCpuStats task;
+        uint64_t ticks;
+        if (read_thread(tid, &task, &ticks)) {
+            baselineThreads[baselineThreadCount++] = {tid, ticks};
+        }
+    });
+
+    return true;
+}
+
+void cpu_stats_end(CpuStats& stats) {
+    uint64_t windowNs = now_ns() - baselineNs;
+    stats.window_us = (uint32_t)(windowNs / 1000);
+    stats.context_switches = (int32_t)(read_context_switches() - baselineSwitches);
+    stats.task_count = 0;
+
+    CoreTimes cores[CPU_STATS_NUM_CORES];
+    read_core_times(cores);
+    for (int c = 0; c < CPU_STATS_NUM_CORES; c++) {
+        uint64_t total = cores[c].total - baselineCores[c].total;
+        stats.core_busy_pct[c] = total > 0
+            ? (cores[c].busy - baselineCores[c].busy) * 100.0f / total
+            : -1.0f;
+    }
+
+    if (windowNs == 0) return;
+
+    static const double ticksToNs = 1e9 / sysconf(_SC_CLK_TCK);
+    for_each_thread([&](int tid) {
+        if (stats.task_count >= CPU_STATS_MAX_TASKS) return;
+        TaskCpuStats& task = stats.tasks[stats.task_count];
+        uint64_t ticks;
+        if (!read_thread(tid, &task, &ticks)) return;
+
+        uint64_t previous = 0;
+        for (int i = 0; i < baselineThreadCount; i++) {
+            if (baselineThreads[i].tid == tid) {
+                previous = baselineThreads[i].ticks;
+                break;
+            }
+        }
+
+        task.busy_pct = (float)((ticks - previous) * ticksToNs * 100.0 / windowNs);
+        stats.task_count++;
+    });
+}
+
+#endif
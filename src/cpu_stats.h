@@ -0,0 +1,41 @@
+#ifndef CPU_STATS_H
+#define CPU_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// CPU Stats - Carga por núcleo y por tarea
+// =============================================================================
+// En el ESP32-S3 usa las run-time stats de FreeRTOS (requiere
+// configUSE_TRACE_FACILITY y configGENERATE_RUN_TIME_STATS en el sdkconfig).
+// En host usa /proc/stat, /proc/self/task/*/stat y getrusage().
+// Los valores no disponibles se reportan como -1.
+// =============================================================================
+
+constexpr int CPU_STATS_NUM_CORES = 2;
+constexpr int CPU_STATS_MAX_TASKS = 24;
+
+struct TaskCpuStats {
+    char name[16];
+    int8_t core;                // Núcleo fijado (-1 = sin afinidad)
+    float busy_pct;             // % de un núcleo usado en la ventana
+    uint32_t stack_free_bytes;  // High-water mark del stack (0 en host)
+};
+
+struct CpuStats {
+    uint32_t window_us;                         // Duración de la ventana medida
+    float core_busy_pct[CPU_STATS_NUM_CORES];   // 100 - % de la tarea IDLE
+    int32_t context_switches;                   // En la ventana (-1 si no disponible)
+    uint8_t task_count;
+    TaskCpuStats tasks[CPU_STATS_MAX_TASKS];
+};
+
+// Toma la muestra de referencia (inicio de la ventana)
+// Retorna false si las run-time stats no están disponibles
+bool cpu_stats_begin();
+
+// Calcula la carga desde cpu_stats_begin() y la guarda en stats
+void cpu_stats_end(CpuStats& stats);
+
+#endif // CPU_STATS_H
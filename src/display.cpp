@@ -0,0 +1,43 @@
+#include "display.h"
+#include <Arduino.h>
+#include "pin_config.h"
+#include "Arduino_GFX_Library.h"
+
+// =============================================================================
+// Implementación - Pantalla
+// =============================================================================
+
+// Buffers DMA encolados: las escrituras chicas (una columna del heatmap)
+// vuelven apenas se encolan en vez de esperar cada transferencia
+#define DISPLAY_ASYNC_BUFFERS 4
+
+static Arduino_ESP32SPIDMA* bus = nullptr;
+static Arduino_GC9D01N* panel = nullptr;
+
+bool display_init() {
+    if (panel) return true;
+
+    bus = new Arduino_ESP32SPIDMA(LCD_DC, LCD_CS, LCD_SCLK, LCD_MOSI, GFX_NOT_DEFINED);
+    bus->setAsyncBuffers(DISPLAY_ASYNC_BUFFERS);
+
+    Arduino_GC9D01N* gc9d01n = new Arduino_GC9D01N(bus, LCD_RST, 0, false, LCD_WIDTH, LCD_HEIGHT);
+    if (!gc9d01n->begin()) {
+        Serial.println("[Display] ERROR: No se pudo iniciar el GC9D01N");
+        delete gc9d01n;
+        delete bus;
+        bus = nullptr;
+        return false;
+    }
+    gc9d01n->fillScreen(BLACK);
+
+    pinMode(LCD_BL, OUTPUT);
+    digitalWrite(LCD_BL, HIGH);
+
+    panel = gc9d01n;
+    Serial.printf("[Display] OK: GC9D01N %dx%d\n", LCD_WIDTH, LCD_HEIGHT);
+    return true;
+}
+
+Arduino_TFT* display_get() {
+    return panel;
+}
@@ -0,0 +1,19 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+// =============================================================================
+// Pantalla - GC9D01N redondo de la T-Circle S3 sobre SPI con DMA
+// =============================================================================
+// Los pines y el tamaño salen de pin_config.h (LCD_*). El panel queda en
+// negro y con el backlight encendido.
+// =============================================================================
+
+class Arduino_TFT;
+
+// Retorna true si OK (llamadas repetidas no reinician el panel)
+bool display_init();
+
+// Panel ya iniciado, o nullptr
+Arduino_TFT* display_get();
+
+#endif // DISPLAY_H
@@ -1,113 +1,422 @@
 #include "emotion_model.h"
 #include "config.h"
+#include "memory_plan.h"
+#include "op_profiler.h"
+#include "profiler.h"
+#include "esp_nn_kernels.h"
+#include "model_ops.h"
 #include <Arduino.h>
+#include <new>
+#include <type_traits>
 #include <LittleFS.h>
 #include "esp_heap_caps.h"
+#ifdef ARDUINO
 #include "esp_task_wdt.h"
+#endif
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/micro/system_setup.h"
 #include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/schema/schema_utils.h"
 #include "tensorflow/lite/micro/micro_error_reporter.h"
-
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/memory_helpers.h"
+
+// SplitArenaAllocator depende de la API interna de la versión de TFLite Micro
+// fijada en platformio.ini; las posteriores renombran SimpleMemoryAllocator
+#if __has_include("tensorflow/lite/micro/simple_memory_allocator.h")
+#include "tensorflow/lite/micro/simple_memory_allocator.h"
+#else
+#error "TFLite Micro sin SimpleMemoryAllocator: usar la versión de TensorFlowLite_ESP32 fijada en platformio.ini"
+#endif
+
+#ifdef ARDUINO
 // Declaración de función ROM de cache (ESP32-S3)
 extern "C" {
     void Cache_WriteBack_All(void);
 }
+#endif
 
 // =============================================================================
 // Implementación - Modelo TFLite
 // =============================================================================
 
-// Tamaño del tensor arena (con margen de seguridad)
+// Arena para medir el modelo en model_plan_memory() (cota superior)
 static constexpr size_t TENSOR_ARENA_SIZE = 156 * 1024;
 
-// Buffers internos
-static uint8_t* modelBuffer = nullptr;
-static uint8_t* tensorArena = nullptr;
-static size_t modelSize = 0;
+// Margen sobre lo medido: alineación y temporales de AllocateTensors()
+static constexpr size_t ARENA_MARGIN = 2 * 1024;
+
+// Buffers internos (del planner de memoria; uno por hilo en host)
+static PIPELINE_THREAD_LOCAL const uint8_t* modelBuffer = nullptr;   // En flash si está embebido
+static PIPELINE_THREAD_LOCAL uint8_t* arenaPersistent = nullptr;
+static PIPELINE_THREAD_LOCAL uint8_t* arenaScratch = nullptr;
+static PIPELINE_THREAD_LOCAL size_t modelSize = 0;           // Modelo actual
+static PIPELINE_THREAD_LOCAL size_t modelBufferSize = 0;     // Buffer del plan (el mayor modelo planificado)
+static PIPELINE_THREAD_LOCAL char modelPath[48] = "";
+static PIPELINE_THREAD_LOCAL size_t arenaPersistentSize = 0;
+static PIPELINE_THREAD_LOCAL size_t arenaScratchSize = 0;
+
+// Handles en el plan de memoria (-1 = sin declarar)
+static PIPELINE_THREAD_LOCAL int modelHandle = -1;
+static PIPELINE_THREAD_LOCAL int arenaPersistentHandle = -1;
+static PIPELINE_THREAD_LOCAL int arenaScratchHandle = -1;
 
 // TFLite
-static const tflite::Model* model = nullptr;
-static tflite::MicroInterpreter* interpreter = nullptr;
-static TfLiteTensor* inputTensor = nullptr;
-static TfLiteTensor* outputTensor = nullptr;
+static PIPELINE_THREAD_LOCAL const tflite::Model* model = nullptr;
+static PIPELINE_THREAD_LOCAL tflite::MicroInterpreter* interpreter = nullptr;
+static PIPELINE_THREAD_LOCAL TfLiteTensor* inputTensor = nullptr;
+static PIPELINE_THREAD_LOCAL TfLiteTensor* outputTensor = nullptr;
+
+// Un resolver por juego de kernels (se registran al primer uso) con los ops
+// de model_ops.h, generado desde data/*.tflite por tools/gen_op_resolver.py
+typedef tflite::MicroMutableOpResolver<MODEL_OPS_COUNT> OpResolver;
+static PIPELINE_THREAD_LOCAL OpResolver resolvers[KERNELS_COUNT];
+static PIPELINE_THREAD_LOCAL bool opsRegistered[KERNELS_COUNT] = {};
+static PIPELINE_THREAD_LOCAL tflite::MicroErrorReporter errorReporter;
+
+#if MODEL_ESP_NN
+static PIPELINE_THREAD_LOCAL ModelKernels activeKernels = KERNELS_ESP_NN;
+#else
+static PIPELINE_THREAD_LOCAL ModelKernels activeKernels = KERNELS_REFERENCE;
+#endif
+
+static const char* KERNELS_NAMES[KERNELS_COUNT] = {"reference", "esp-nn"};
 
-// Resolver con las operaciones necesarias
-static tflite::MicroMutableOpResolver<11> resolver;
-static tflite::MicroErrorReporter errorReporter;
+// Duración del último Invoke() (us)
+static PIPELINE_THREAD_LOCAL uint32_t lastInvokeUs = 0;
 
 // -----------------------------------------------------------------------------
-// API pública
+// Arena dividido
 // -----------------------------------------------------------------------------
+// TFLite Micro usa la cola del arena para lo persistente (estructuras del
+// intérprete, datos de los ops) y la cabeza para activaciones y scratch, que
+// solo importan dentro de Invoke(). Esta versión de la librería no separa las
+// dos zonas, así que SimpleMemoryAllocator queda con la cabeza sobre el
+// scratch y AllocateFromTail() se desvía a un bloque aparte. Así el scratch
+// se declara en el plan con vida STAGE_INFERENCE y puede compartir memoria.
+
+class SplitArenaAllocator : public tflite::SimpleMemoryAllocator {
+public:
+    SplitArenaAllocator(tflite::ErrorReporter* reporter,
+                        uint8_t* scratch, size_t scratchSize,
+                        uint8_t* persistent, size_t persistentSize)
+        : tflite::SimpleMemoryAllocator(reporter, scratch, scratchSize),
+          reporter_(reporter),
+          persistentStart_(persistent),
+          persistentEnd_(persistent + persistentSize),
+          persistentTail_(persistentEnd_) {}
+
+    uint8_t* AllocateFromTail(size_t size, size_t alignment) override {
+        size_t available = persistentTail_ - persistentStart_;
+        uint8_t* aligned = size <= available
+                               ? tflite::AlignPointerDown(persistentTail_ - size, alignment)
+                               : nullptr;
+        if (!aligned || aligned < persistentStart_) {
+            TF_LITE_REPORT_ERROR(reporter_, "Arena persistente: faltan %d bytes",
+                                 (int)(size - available));
+            return nullptr;
+        }
+        persistentTail_ = aligned;
+        return aligned;
+    }
 
-bool model_load(const char* path) {
-    Serial.printf("[Model] Cargando %s...\n", path);
+    // 0 si la librería nunca llamó a AllocateFromTail(): todo quedó en el scratch
+    size_t GetPersistentUsedBytes() const {
+        return persistentEnd_ - persistentTail_;
+    }
 
-    // Montar LittleFS
-    if (!LittleFS.begin(true)) {
-        Serial.println("[Model] ERROR: No se pudo montar LittleFS");
+private:
+    tflite::ErrorReporter* reporter_;
+    uint8_t* persistentStart_;
+    uint8_t* persistentEnd_;
+    uint8_t* persistentTail_;
+};
+
+// model_load() pasa el allocator y el profiler por el constructor de la
+// versión fijada en platformio.ini; las posteriores lo cambian
+static_assert(std::is_constructible<tflite::MicroInterpreter, const tflite::Model*,
+                                    const tflite::MicroOpResolver&, tflite::MicroAllocator*,
+                                    tflite::ErrorReporter*, tflite::MicroResourceVariables*,
+                                    tflite::MicroProfiler*>::value,
+              "MicroInterpreter sin el constructor esperado: usar TensorFlowLite_ESP32 de platformio.ini");
+
+// Storage del intérprete y su allocator (placement new en model_load)
+alignas(SplitArenaAllocator) static PIPELINE_THREAD_LOCAL uint8_t arenaAllocatorStorage[sizeof(SplitArenaAllocator)];
+alignas(tflite::MicroInterpreter) static PIPELINE_THREAD_LOCAL uint8_t interpreterStorage[sizeof(tflite::MicroInterpreter)];
+static PIPELINE_THREAD_LOCAL SplitArenaAllocator* arenaAllocator = nullptr;
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static bool kernels_available(ModelKernels kernels) {
+    return kernels == KERNELS_REFERENCE || (kernels == KERNELS_ESP_NN && MODEL_ESP_NN);
+}
+
+#if MODEL_ESP_NN
+// Registra la versión ESP-NN del op si existe
+static bool add_esp_nn_op(OpResolver& resolver, tflite::BuiltinOperator op) {
+    switch (op) {
+        case tflite::BuiltinOperator_CONV_2D:
+            return resolver.AddConv2D(esp_nn_kernels::Register_CONV_2D()) == kTfLiteOk;
+        case tflite::BuiltinOperator_MAX_POOL_2D:
+            return resolver.AddMaxPool2D(esp_nn_kernels::Register_MAX_POOL_2D()) == kTfLiteOk;
+        case tflite::BuiltinOperator_AVERAGE_POOL_2D:
+            return resolver.AddAveragePool2D(esp_nn_kernels::Register_AVERAGE_POOL_2D()) == kTfLiteOk;
+        case tflite::BuiltinOperator_FULLY_CONNECTED:
+            return resolver.AddFullyConnected(esp_nn_kernels::Register_FULLY_CONNECTED()) == kTfLiteOk;
+        case tflite::BuiltinOperator_ADD:
+            return resolver.AddAdd(esp_nn_kernels::Register_ADD()) == kTfLiteOk;
+        default:
+            return false;
+    }
+}
+#endif
+
+static OpResolver& register_ops(ModelKernels kernels) {
+    OpResolver& resolver = resolvers[kernels];
+    if (opsRegistered[kernels]) return resolver;
+
+#if MODEL_ESP_NN
+#define REGISTER_OP(code, method) \
+    if (kernels != KERNELS_ESP_NN || !add_esp_nn_op(resolver, tflite::BuiltinOperator_##code)) { \
+        resolver.Add##method(); \
+    }
+#else
+#define REGISTER_OP(code, method) resolver.Add##method();
+#endif
+    MODEL_OPS(REGISTER_OP)
+#undef REGISTER_OP
+
+    opsRegistered[kernels] = true;
+    return resolver;
+}
+
+// Verifica que todos los ops de los subgrafos estén en model_ops.h. Un
+// modelo con ops nuevos falla acá con el nombre del op, no en
+// AllocateTensors() (regenerar con tools/gen_op_resolver.py)
+static bool check_model_ops(const tflite::Model* model) {
+#define OP_CODE(code, method) tflite::BuiltinOperator_##code,
+    static const tflite::BuiltinOperator registered[] = {MODEL_OPS(OP_CODE)};
+#undef OP_CODE
+
+    bool ok = true;
+    const auto* opcodes = model->operator_codes();
+    const auto* subgraphs = model->subgraphs();
+    for (size_t s = 0; subgraphs && s < subgraphs->size(); s++) {
+        const auto* operators = subgraphs->Get(s)->operators();
+        for (size_t i = 0; operators && i < operators->size(); i++) {
+            tflite::BuiltinOperator op = tflite::GetBuiltinCode(opcodes->Get(operators->Get(i)->opcode_index()));
+
+            bool found = false;
+            for (size_t r = 0; r < MODEL_OPS_COUNT && !found; r++) {
+                found = registered[r] == op;
+            }
+            if (!found) {
+                Serial.printf("[Model] ERROR: Op %s (subgrafo %u, op %u) no está en model_ops.h\n",
+                              tflite::EnumNameBuiltinOperator(op), (unsigned)s, (unsigned)i);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+// Flatbuffer embebido si path es el modelo de model_embedded.h (los demás
+// modelos se leen de LittleFS)
+static const uint8_t* embedded_model(const char* path) {
+#if MODEL_EMBEDDED
+    if (strcmp(path, MODEL_PATH) == 0) return model_embedded_data;
+#endif
+    (void)path;
+    return nullptr;
+}
+
+// Tamaño del .tflite (o del embebido)
+static bool model_file_size(const char* path, size_t& size) {
+#if MODEL_EMBEDDED
+    if (embedded_model(path)) {
+        size = model_embedded_size;
+        return true;
+    }
+#endif
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("[Model] ERROR: No se pudo abrir %s\n", path);
         return false;
     }
+    size = file.size();
+    file.close();
+    return true;
+}
 
-    // Abrir archivo
+// Lee el modelo completo en buffer (de tamaño modelSize)
+static bool read_model_file(const char* path, uint8_t* buffer) {
     File file = LittleFS.open(path, "r");
     if (!file) {
         Serial.printf("[Model] ERROR: No se pudo abrir %s\n", path);
         return false;
     }
+    bool ok = file.size() == modelSize && file.read(buffer, modelSize) == modelSize;
+    file.close();
+    if (!ok) Serial.printf("[Model] ERROR: %s cambió desde el plan de memoria\n", path);
+    return ok;
+}
+
+// AllocateTensors() sobre un arena temporal: mide cuánto usan la cola
+// (persistente) y la cabeza (activaciones). Se mide con cada juego de
+// kernels disponible y se toma el máximo: ESP-NN pide scratch propio en la
+// cabeza y los kernels se pueden cambiar sin rehacer el plan
+static bool measure_arena(const char* path) {
+    const uint8_t* embedded = embedded_model(path);
+    uint8_t* probeModel = embedded ? nullptr : (uint8_t*)heap_caps_aligned_alloc(16, modelSize, MALLOC_CAP_SPIRAM);
+    uint8_t* probeArena = (uint8_t*)heap_caps_aligned_alloc(16, TENSOR_ARENA_SIZE, MALLOC_CAP_SPIRAM);
+    bool ok = probeArena && (embedded || (probeModel && read_model_file(path, probeModel)));
+
+    if (ok) {
+        const tflite::Model* probe = tflite::GetModel(embedded ? embedded : probeModel);
+        if (probe->version() != TFLITE_SCHEMA_VERSION) {
+            Serial.println("[Model] ERROR: Versión de modelo incompatible");
+            ok = false;
+        } else if (!check_model_ops(probe)) {
+            ok = false;
+        }
+
+        arenaPersistentSize = 0;
+        arenaScratchSize = 0;
+        for (int k = 0; ok && k < KERNELS_COUNT; k++) {
+            if (!kernels_available((ModelKernels)k)) continue;
+
+            OpResolver& resolver = register_ops((ModelKernels)k);
+            tflite::SimpleMemoryAllocator memory(&errorReporter, probeArena, TENSOR_ARENA_SIZE);
+            tflite::MicroAllocator* allocator = tflite::MicroAllocator::Create(&memory, &errorReporter);
+            tflite::MicroInterpreter probeInterpreter(probe, resolver, allocator, &errorReporter);
+
+            if (probeInterpreter.AllocateTensors() != kTfLiteOk) {
+                Serial.printf("[Model] ERROR: El modelo no entra en %u KB de arena\n",
+                              (unsigned)(TENSOR_ARENA_SIZE / 1024));
+                ok = false;
+            } else {
+                size_t tail = memory.GetTailUsedBytes() + ARENA_MARGIN;
+                size_t head = memory.GetHeadUsedBytes() + ARENA_MARGIN;
+                if (tail > arenaPersistentSize) arenaPersistentSize = tail;
+                if (head > arenaScratchSize) arenaScratchSize = head;
+            }
+        }
+    }
 
-    modelSize = file.size();
-    Serial.printf("[Model] Tamaño: %.1f KB\n", modelSize / 1024.0f);
+    if (probeModel) heap_caps_free(probeModel);
+    if (probeArena) heap_caps_free(probeArena);
+    return ok;
+}
 
-    // Alocar buffer para el modelo en PSRAM
-    modelBuffer = (uint8_t*)heap_caps_aligned_alloc(16, modelSize, MALLOC_CAP_SPIRAM);
-    if (!modelBuffer) {
-        Serial.println("[Model] ERROR: No se pudo alocar modelBuffer");
-        file.close();
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+bool model_plan_memory(const char* path, const char* alt_path) {
+    // Montar LittleFS
+    if (!LittleFS.begin(true)) {
+        Serial.println("[Model] ERROR: No se pudo montar LittleFS");
         return false;
     }
 
-    // Leer modelo
-    file.read(modelBuffer, modelSize);
-    file.close();
+    // Con dos modelos (A/B) los buffers se dimensionan para el mayor de
+    // cada uno, así cualquiera de los dos carga sin rehacer el plan
+    const char* paths[2] = {path, alt_path};
+    size_t persistentSize = 0;
+    size_t scratchSize = 0;
+    modelBufferSize = 0;
+    for (int i = 0; i < 2; i++) {
+        if (!paths[i]) continue;
+        if (!model_file_size(paths[i], modelSize) || !measure_arena(paths[i])) return false;
+
+        if (!embedded_model(paths[i]) && modelSize > modelBufferSize) modelBufferSize = modelSize;
+        if (arenaPersistentSize > persistentSize) persistentSize = arenaPersistentSize;
+        if (arenaScratchSize > scratchSize) scratchSize = arenaScratchSize;
+    }
+    arenaPersistentSize = persistentSize;
+    arenaScratchSize = scratchSize;
+
+    // El flatbuffer y la cola del arena viven mientras el modelo esté
+    // cargado; el scratch (activaciones de cada op) solo dentro de Invoke(),
+    // donde es la memoria más recorrida: la política lo pone en SRAM si entra
+    // y si no queda en PSRAM compartiendo el bloque del audio. El modelo
+    // embebido se usa desde flash y no ocupa RAM
+    modelHandle = modelBufferSize > 0 ? memory_plan_add_persistent("model", modelBufferSize, HEAT_WARM) : -1;
+    arenaPersistentHandle = memory_plan_add_persistent("arena_persistent", arenaPersistentSize, HEAT_WARM);
+    arenaScratchHandle = memory_plan_add("arena_scratch", arenaScratchSize,
+                                         STAGE_INFERENCE, STAGE_INFERENCE, HEAT_HOT);
+    return (modelBufferSize == 0 || modelHandle >= 0) && arenaPersistentHandle >= 0 && arenaScratchHandle >= 0;
+}
+
+bool model_load(const char* path) {
+    // Recargar (p.ej. con otros kernels) reconstruye el intérprete
+    model_unload();
+
+    Serial.printf("[Model] Cargando %s (kernels %s)...\n", path, KERNELS_NAMES[activeKernels]);
 
-    // Alocar tensor arena en PSRAM
-    tensorArena = (uint8_t*)heap_caps_aligned_alloc(16, TENSOR_ARENA_SIZE, MALLOC_CAP_SPIRAM);
-    if (!tensorArena) {
-        Serial.println("[Model] ERROR: No se pudo alocar tensorArena");
+    const uint8_t* embedded = embedded_model(path);
+    uint8_t* fileBuffer = embedded ? nullptr : (uint8_t*)memory_plan_get(modelHandle);
+    arenaPersistent = (uint8_t*)memory_plan_get(arenaPersistentHandle);
+    arenaScratch = (uint8_t*)memory_plan_get(arenaScratchHandle);
+    if ((!embedded && !fileBuffer) || !arenaPersistent || !arenaScratch) {
+        Serial.println("[Model] ERROR: Buffers sin planificar (model_plan_memory + memory_plan_commit)");
         return false;
     }
 
+    if (!model_file_size(path, modelSize)) return false;
+    if (!embedded && modelSize > modelBufferSize) {
+        Serial.printf("[Model] ERROR: %s (%.1f KB) no entra en el buffer del plan (%.1f KB); rehacer el plan con este modelo\n",
+                      path, modelSize / 1024.0f, modelBufferSize / 1024.0f);
+        return false;
+    }
+    Serial.printf("[Model] Tamaño: %.1f KB%s\n", modelSize / 1024.0f, embedded ? " (embebido en flash)" : "");
+
+    // Leer modelo (el embebido se usa en el lugar)
+    if (fileBuffer && !read_model_file(path, fileBuffer)) return false;
+    modelBuffer = embedded ? embedded : fileBuffer;
+
     // Verificar modelo
     model = tflite::GetModel(modelBuffer);
     if (model->version() != TFLITE_SCHEMA_VERSION) {
         Serial.println("[Model] ERROR: Versión de modelo incompatible");
         return false;
     }
-
-    // Agregar operaciones al resolver
-    resolver.AddConv2D();
-    resolver.AddMaxPool2D();
-    resolver.AddAveragePool2D();
-    resolver.AddMean();
-    resolver.AddFullyConnected();
-    resolver.AddSoftmax();
-    resolver.AddReshape();
-    resolver.AddQuantize();
-    resolver.AddDequantize();
-    resolver.AddMul();
-    resolver.AddAdd();
-
-    // Crear intérprete
-    static tflite::MicroInterpreter staticInterpreter(
-        model, resolver, tensorArena, TENSOR_ARENA_SIZE, &errorReporter
+    if (!check_model_ops(model)) return false;
+
+    OpResolver& resolver = register_ops(activeKernels);
+
+    // Crear intérprete sobre el arena dividido (con tiempos por op si hay
+    // profiling). Se construyen en storage propio para poder destruirlos en
+    // model_unload() y volver a cargar
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
+    tflite::MicroProfiler* profiler = op_profiler_get();
+#else
+    tflite::MicroProfiler* profiler = nullptr;
+#endif
+    arenaAllocator = new (arenaAllocatorStorage) SplitArenaAllocator(
+        &errorReporter, arenaScratch, arenaScratchSize, arenaPersistent, arenaPersistentSize
+    );
+    interpreter = new (interpreterStorage) tflite::MicroInterpreter(
+        model, resolver, tflite::MicroAllocator::Create(arenaAllocator, &errorReporter), &errorReporter,
+        nullptr, profiler
     );
-    interpreter = &staticInterpreter;
 
     // Alocar tensores
     if (interpreter->AllocateTensors() != kTfLiteOk) {
-        Serial.println("[Model] ERROR: No se pudo alocar tensores");
+        Serial.println("[Model] ERROR: No se pudo alocar tensores (¿arena planificado con otro modelo?)");
+        model_unload();
+        return false;
+    }
+
+    // Si la librería no pasa por AllocateFromTail() (otra versión de TFLite
+    // Micro) lo persistente termina en el scratch, que el plan comparte con
+    // otras etapas: no seguir
+    if (arenaAllocator->GetPersistentUsedBytes() == 0) {
+        Serial.println("[Model] ERROR: El arena persistente quedó vacío (¿TFLite Micro distinto al de platformio.ini?)");
+        model_unload();
         return false;
     }
 
@@ -120,6 +429,16 @@ bool model_load(const char* path) {
                   inputTensor->type == kTfLiteInt8 ? "INT8" : "FLOAT");
     Serial.printf("[Model] Output: [%d, %d]\n",
                   outputTensor->dims->data[0], outputTensor->dims->data[1]);
+    const PlannedBuffer* persistentBuf = memory_plan_buffer(arenaPersistentHandle);
+    const PlannedBuffer* scratchBuf = memory_plan_buffer(arenaScratchHandle);
+    Serial.printf("[Model] Arena: %.1f/%.1f KB persistente (%s) + %.1f KB scratch (%s)\n",
+                  arenaAllocator->GetPersistentUsedBytes() / 1024.0f,
+                  arenaPersistentSize / 1024.0f, memory_plan_region_name(persistentBuf->region),
+                  arenaScratchSize / 1024.0f, memory_plan_region_name(scratchBuf->region));
+    if (path != modelPath) {
+        strncpy(modelPath, path, sizeof(modelPath) - 1);
+        modelPath[sizeof(modelPath) - 1] = '\0';
+    }
     Serial.println("[Model] Cargado OK");
 
     return true;
@@ -147,19 +466,25 @@ EmotionResult model_predict(const float* mfcc_in) {
         }
     }
 
-    // Preparar para inferencia
+    // Preparar para inferencia (en host no hay watchdog ni cache que vaciar)
+#ifdef ARDUINO
     esp_task_wdt_init(120, false);
     Cache_WriteBack_All();
     delay(50);
+#endif
 
     // Ejecutar inferencia
-    Serial.println("[Model] Ejecutando inferencia...");
-    unsigned long startTime = millis();
+    PROFILE_LOG("[Model] Ejecutando inferencia...\n");
+    unsigned long startUs = micros();
+    op_profiler_begin_invoke();
 
     TfLiteStatus status = interpreter->Invoke();
 
-    unsigned long elapsed = millis() - startTime;
+    op_profiler_end_invoke();
+    lastInvokeUs = micros() - startUs;
+#ifdef ARDUINO
     esp_task_wdt_init(5, true);
+#endif
 
     if (status != kTfLiteOk) {
         Serial.println("[Model] ERROR: Invoke() falló");
@@ -167,7 +492,7 @@ EmotionResult model_predict(const float* mfcc_in) {
         return result;
     }
 
-    Serial.printf("[Model] Inferencia: %lu ms\n", elapsed);
+    PROFILE_LOG("[Model] Inferencia: %lu ms\n", (unsigned long)(lastInvokeUs / 1000));
 
     // Procesar salida
     float outputScale = outputTensor->params.scale;
@@ -195,23 +520,52 @@ EmotionResult model_predict(const float* mfcc_in) {
 }
 
 void model_unload() {
-    if (modelBuffer) {
-        heap_caps_free(modelBuffer);
-        modelBuffer = nullptr;
-    }
-    if (tensorArena) {
-        heap_caps_free(tensorArena);
-        tensorArena = nullptr;
-    }
+    // La memoria es del plan (memory_plan_reset la libera)
+    if (interpreter) interpreter->~MicroInterpreter();
+    if (arenaAllocator) arenaAllocator->~SplitArenaAllocator();
+    modelBuffer = nullptr;
+    arenaPersistent = nullptr;
+    arenaScratch = nullptr;
+    arenaAllocator = nullptr;
     interpreter = nullptr;
     inputTensor = nullptr;
     outputTensor = nullptr;
 }
 
+bool model_set_kernels(ModelKernels kernels) {
+    if (kernels >= KERNELS_COUNT || !kernels_available(kernels)) return false;
+    activeKernels = kernels;
+    return true;
+}
+
+ModelKernels model_get_kernels() {
+    return activeKernels;
+}
+
+bool model_kernels_available(ModelKernels kernels) {
+    return kernels < KERNELS_COUNT && kernels_available(kernels);
+}
+
+const char* model_kernels_name(ModelKernels kernels) {
+    return kernels < KERNELS_COUNT ? KERNELS_NAMES[kernels] : "?";
+}
+
+const char* model_get_path() {
+    return modelPath;
+}
+
+bool model_is_embedded() {
+    return modelBuffer && modelBuffer == embedded_model(modelPath);
+}
+
 size_t model_get_size_bytes() {
     return modelSize;
 }
 
 size_t model_get_arena_size_bytes() {
-    return TENSOR_ARENA_SIZE;
+    return arenaPersistentSize + arenaScratchSize;
+}
+
+uint32_t model_get_last_invoke_us() {
+    return lastInvokeUs;
 }
@@ -8,6 +8,13 @@
 // Modelo de Reconocimiento de Emociones (TFLite)
 // =============================================================================
 
+// Juego de kernels del intérprete (ver esp_nn_kernels.h)
+enum ModelKernels : uint8_t {
+    KERNELS_REFERENCE = 0,      // Kernels de referencia de TFLite Micro
+    KERNELS_ESP_NN,             // ESP-NN (requiere -D MODEL_ESP_NN=1)
+    KERNELS_COUNT
+};
+
 struct EmotionResult {
     const char* label;          // Nombre de la emoción detectada
     float confidence;           // Confianza (0.0 - 1.0)
@@ -15,7 +22,16 @@ struct EmotionResult {
     float probabilities[7];     // Probabilidades de todas las emociones
 };
 
-// Carga el modelo desde LittleFS
+// Declara en el plan de memoria el modelo y el tensor arena, dividido en
+// una parte persistente y el scratch de Invoke(). Mide el arena con un
+// AllocateTensors() de prueba, así que model_load() solo acepta path o
+// alt_path (con alt_path los buffers entran cualquiera de los dos, para A/B)
+// Retorna true si OK
+bool model_plan_memory(const char* path, const char* alt_path = nullptr);
+
+// Carga el modelo desde LittleFS sobre los buffers del plan ya confirmado,
+// con los kernels de model_set_kernels(). Si ya había uno cargado lo
+// descarga primero
 // path: ruta del archivo .tflite (ej: "/modelo.tflite")
 // Retorna true si OK
 bool model_load(const char* path);
@@ -25,13 +41,30 @@ bool model_load(const char* path);
 // Retorna el resultado de la inferencia
 EmotionResult model_predict(const float* mfcc_in);
 
-// Libera memoria del modelo (opcional)
+// Destruye el intérprete (la memoria es del plan). model_load() lo llama
+// antes de cargar, así que cambiar de modelo no deja estado colgado
 void model_unload();
 
+// Path del último modelo cargado ("" si ninguno)
+const char* model_get_path();
+
+// Kernels para el próximo model_load() (por defecto ESP-NN si está compilado)
+// Retorna false si ese juego no está compilado
+bool model_set_kernels(ModelKernels kernels);
+ModelKernels model_get_kernels();
+bool model_kernels_available(ModelKernels kernels);
+const char* model_kernels_name(ModelKernels kernels);
+
+// true si el modelo cargado se usa desde flash (MODEL_EMBEDDED)
+bool model_is_embedded();
+
 // Retorna el tamaño del modelo en bytes
 size_t model_get_size_bytes();
 
-// Retorna el tamaño del tensor arena en bytes
+// Retorna el tamaño del tensor arena en bytes (persistente + scratch)
 size_t model_get_arena_size_bytes();
 
+// Duración del último Invoke() en microsegundos (sin cuantizar la entrada)
+uint32_t model_get_last_invoke_us();
+
 #endif // EMOTION_MODEL_H
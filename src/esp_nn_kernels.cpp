@@ -0,0 +1,334 @@
+#include "esp_nn_kernels.h"
+
+#if MODEL_ESP_NN
+
+#ifdef ARDUINO
+#include "sdkconfig.h"      // CONFIG_IDF_TARGET_ESP32S3 para esp_nn.h
+#endif
+// API con structs (data_dims_t, conv_params_t) de la versión de ESP-NN y
+// kernels de TFLite Micro fijados en platformio.ini
+#if !__has_include("esp_nn_defs.h")
+#error "ESP-NN sin esp_nn_defs.h: usar la versión fijada en platformio.ini"
+#endif
+#if !__has_include("tensorflow/lite/micro/kernels/conv.h")
+#error "TFLite Micro sin kernels/conv.h (OpDataConv): usar la versión fijada en platformio.ini"
+#endif
+#include "esp_nn.h"
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/kernels/conv.h"
+#include "tensorflow/lite/micro/kernels/fully_connected.h"
+#include "tensorflow/lite/micro/kernels/pooling.h"
+#include "tensorflow/lite/micro/kernels/add.h"
+
+// =============================================================================
+// Implementación - Kernels ESP-NN
+// =============================================================================
+
+// Registros de referencia (se completan en cada Register_*)
+static TfLiteRegistration refConv = {};
+static TfLiteRegistration refFullyConnected = {};
+static TfLiteRegistration refMaxPool = {};
+static TfLiteRegistration refAvgPool = {};
+static TfLiteRegistration refAdd = {};
+
+// -----------------------------------------------------------------------------
+// Conv2D
+// -----------------------------------------------------------------------------
+
+// El Prepare de referencia castea user_data a OpDataConv: va primero
+struct ConvData {
+    tflite::OpDataConv op;
+    int scratchIndex;       // Scratch de esp_nn_conv_s8 en el arena (-1 = no usa)
+};
+
+static void fill_conv_dims(const TfLiteIntArray* inDims, const TfLiteIntArray* filterDims,
+                           const TfLiteIntArray* outDims, data_dims_t& input,
+                           data_dims_t& filter, data_dims_t& output) {
+    // NHWC; el filtro es [out_ch, h, w, in_ch]
+    input.width = inDims->data[2];
+    input.height = inDims->data[1];
+    input.channels = inDims->data[3];
+    input.extra = 1;
+    filter.width = filterDims->data[2];
+    filter.height = filterDims->data[1];
+    filter.channels = filterDims->data[3];
+    filter.extra = filterDims->data[0];
+    output.width = outDims->data[2];
+    output.height = outDims->data[1];
+    output.channels = outDims->data[3];
+    output.extra = 1;
+}
+
+static void fill_conv_params(const TfLiteConvParams& params, const tflite::OpDataConv& data,
+                             conv_params_t& conv) {
+    conv.in_offset = -data.input_zero_point;
+    conv.out_offset = data.output_zero_point;
+    conv.stride.width = params.stride_width;
+    conv.stride.height = params.stride_height;
+    conv.padding.width = data.padding.width;
+    conv.padding.height = data.padding.height;
+    conv.dilation.width = 1;
+    conv.dilation.height = 1;
+    conv.activation.min = data.output_activation_min;
+    conv.activation.max = data.output_activation_max;
+}
+
+static bool conv_supported(TfLiteType input, TfLiteType filter, const TfLiteConvParams& params) {
+    return input == kTfLiteInt8 && filter == kTfLiteInt8 &&
+           params.dilation_width_factor == 1 && params.dilation_height_factor == 1;
+}
+
+static void* conv_init(TfLiteContext* context, const char* buffer, size_t length) {
+    (void)buffer;
+    (void)length;
+    return context->AllocatePersistentBuffer(context, sizeof(ConvData));
+}
+
+static TfLiteStatus conv_prepare(TfLiteContext* context, TfLiteNode* node) {
+    TF_LITE_ENSURE_STATUS(refConv.prepare(context, node));
+
+    ConvData* data = static_cast<ConvData*>(node->user_data);
+    data->scratchIndex = -1;
+
+    const TfLiteTensor* input = tflite::GetInput(context, node, 0);
+    const TfLiteTensor* filter = tflite::GetInput(context, node, 1);
+    const TfLiteTensor* output = tflite::GetOutput(context, node, 0);
+    const TfLiteConvParams& params = *static_cast<const TfLiteConvParams*>(node->builtin_data);
+    if (!conv_supported(input->type, filter->type, params)) return kTfLiteOk;
+
+    data_dims_t inDims, filterDims, outDims;
+    conv_params_t conv;
+    fill_conv_dims(input->dims, filter->dims, output->dims, inDims, filterDims, outDims);
+    fill_conv_params(params, data->op, conv);
+
+    int scratchSize = esp_nn_get_conv_scratch_size(&inDims, &filterDims, &outDims, &conv);
+    if (scratchSize > 0) {
+        TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(context, scratchSize,
+                                                                   &data->scratchIndex));
+    }
+    return kTfLiteOk;
+}
+
+static TfLiteStatus conv_eval(TfLiteContext* context, TfLiteNode* node) {
+    const TfLiteEvalTensor* input = tflite::micro::GetEvalInput(context, node, 0);
+    const TfLiteEvalTensor* filter = tflite::micro::GetEvalInput(context, node, 1);
+    const TfLiteEvalTensor* bias = node->inputs->size == 3
+                                       ? tflite::micro::GetEvalInput(context, node, 2)
+                                       : nullptr;
+    TfLiteEvalTensor* output = tflite::micro::GetEvalOutput(context, node, 0);
+    const TfLiteConvParams& params = *static_cast<const TfLiteConvParams*>(node->builtin_data);
+
+    if (!conv_supported(input->type, filter->type, params)) {
+        return refConv.invoke(context, node);
+    }
+
+    ConvData* data = static_cast<ConvData*>(node->user_data);
+    if (data->scratchIndex >= 0) {
+        esp_nn_set_conv_scratch_buf(context->GetScratchBuffer(context, data->scratchIndex));
+    }
+
+    data_dims_t inDims, filterDims, outDims;
+    conv_params_t conv;
+    fill_conv_dims(input->dims, filter->dims, output->dims, inDims, filterDims, outDims);
+    fill_conv_params(params, data->op, conv);
+
+    quant_data_t quant;
+    quant.shift = data->op.per_channel_output_shift;
+    quant.mult = data->op.per_channel_output_multiplier;
+
+    const int8_t* inData = tflite::micro::GetTensorData<int8_t>(input);
+    const int8_t* filterData = tflite::micro::GetTensorData<int8_t>(filter);
+    const int32_t* biasData = bias ? tflite::micro::GetTensorData<int32_t>(bias) : nullptr;
+    int8_t* outData = tflite::micro::GetTensorData<int8_t>(output);
+
+    const int batches = input->dims->data[0];
+    const int inSize = inDims.width * inDims.height * inDims.channels;
+    const int outSize = outDims.width * outDims.height * outDims.channels;
+    for (int b = 0; b < batches; b++) {
+        esp_nn_conv_s8(&inDims, inData + b * inSize, &filterDims, filterData, biasData,
+                       &outDims, outData + b * outSize, &conv, &quant);
+    }
+    return kTfLiteOk;
+}
+
+// -----------------------------------------------------------------------------
+// FullyConnected
+// -----------------------------------------------------------------------------
+
+static TfLiteStatus fully_connected_eval(TfLiteContext* context, TfLiteNode* node) {
+    const TfLiteEvalTensor* input = tflite::micro::GetEvalInput(context, node, 0);
+    const TfLiteEvalTensor* filter = tflite::micro::GetEvalInput(context, node, 1);
+    const TfLiteEvalTensor* bias = node->inputs->size == 3
+                                       ? tflite::micro::GetEvalInput(context, node, 2)
+                                       : nullptr;
+    TfLiteEvalTensor* output = tflite::micro::GetEvalOutput(context, node, 0);
+
+    if (input->type != kTfLiteInt8 || filter->type != kTfLiteInt8) {
+        return refFullyConnected.invoke(context, node);
+    }
+
+    const tflite::OpDataFullyConnected& data =
+        *static_cast<const tflite::OpDataFullyConnected*>(node->user_data);
+
+    // Filtro [out_ch, accum_depth]; la entrada se aplana en batches x accum_depth
+    const int outChannels = filter->dims->data[0];
+    const int accumDepth = filter->dims->data[filter->dims->size - 1];
+    const int batches = tflite::micro::GetTensorShape(output).FlatSize() / outChannels;
+
+    const int8_t* inData = tflite::micro::GetTensorData<int8_t>(input);
+    const int8_t* filterData = tflite::micro::GetTensorData<int8_t>(filter);
+    const int32_t* biasData = bias ? tflite::micro::GetTensorData<int32_t>(bias) : nullptr;
+    int8_t* outData = tflite::micro::GetTensorData<int8_t>(output);
+
+    for (int b = 0; b < batches; b++) {
+        esp_nn_fully_connected_s8(inData + b * accumDepth, -data.input_zero_point, accumDepth,
+                                  filterData, -data.filter_zero_point, biasData,
+                                  outData + b * outChannels, outChannels, data.output_zero_point,
+                                  data.output_shift, data.output_multiplier,
+                                  data.output_activation_min, data.output_activation_max);
+    }
+    return kTfLiteOk;
+}
+
+// -----------------------------------------------------------------------------
+// MaxPool2D / AveragePool2D
+// -----------------------------------------------------------------------------
+
+typedef void (*PoolFn)(const int8_t*, const uint16_t, const uint16_t, int8_t*,
+                       const uint16_t, const uint16_t, const uint16_t, const uint16_t,
+                       const uint16_t, const uint16_t, const uint16_t, const uint16_t,
+                       const int32_t, const int32_t, const uint16_t);
+
+static TfLiteStatus pool_eval(TfLiteContext* context, TfLiteNode* node,
+                              const TfLiteRegistration& reference, PoolFn pool) {
+    const TfLiteEvalTensor* input = tflite::micro::GetEvalInput(context, node, 0);
+    TfLiteEvalTensor* output = tflite::micro::GetEvalOutput(context, node, 0);
+
+    if (input->type != kTfLiteInt8) return reference.invoke(context, node);
+
+    const TfLitePoolParams& params = *static_cast<const TfLitePoolParams*>(node->builtin_data);
+    const tflite::OpDataPooling& data = *static_cast<const tflite::OpDataPooling*>(node->user_data);
+
+    const int batches = input->dims->data[0];
+    const int inHeight = input->dims->data[1];
+    const int inWidth = input->dims->data[2];
+    const int channels = input->dims->data[3];
+    const int outHeight = output->dims->data[1];
+    const int outWidth = output->dims->data[2];
+
+    const int8_t* inData = tflite::micro::GetTensorData<int8_t>(input);
+    int8_t* outData = tflite::micro::GetTensorData<int8_t>(output);
+
+    for (int b = 0; b < batches; b++) {
+        pool(inData + b * inHeight * inWidth * channels, inWidth, inHeight,
+             outData + b * outHeight * outWidth * channels, outWidth, outHeight,
+             params.stride_width, params.stride_height, params.filter_width, params.filter_height,
+             data.padding.width, data.padding.height, data.activation_min, data.activation_max,
+             channels);
+    }
+    return kTfLiteOk;
+}
+
+static void max_pool_s8(const int8_t* in, const uint16_t inWd, const uint16_t inHt, int8_t* out,
+                        const uint16_t outWd, const uint16_t outHt, const uint16_t strideWd,
+                        const uint16_t strideHt, const uint16_t filterWd, const uint16_t filterHt,
+                        const uint16_t padWd, const uint16_t padHt, const int32_t actMin,
+                        const int32_t actMax, const uint16_t channels) {
+    esp_nn_max_pool_s8(in, inWd, inHt, out, outWd, outHt, strideWd, strideHt,
+                       filterWd, filterHt, padWd, padHt, actMin, actMax, channels);
+}
+
+static void avg_pool_s8(const int8_t* in, const uint16_t inWd, const uint16_t inHt, int8_t* out,
+                        const uint16_t outWd, const uint16_t outHt, const uint16_t strideWd,
+                        const uint16_t strideHt, const uint16_t filterWd, const uint16_t filterHt,
+                        const uint16_t padWd, const uint16_t padHt, const int32_t actMin,
+                        const int32_t actMax, const uint16_t channels) {
+    esp_nn_avg_pool_s8(in, inWd, inHt, out, outWd, outHt, strideWd, strideHt,
+                       filterWd, filterHt, padWd, padHt, actMin, actMax, channels);
+}
+
+static TfLiteStatus max_pool_eval(TfLiteContext* context, TfLiteNode* node) {
+    return pool_eval(context, node, refMaxPool, max_pool_s8);
+}
+
+static TfLiteStatus avg_pool_eval(TfLiteContext* context, TfLiteNode* node) {
+    return pool_eval(context, node, refAvgPool, avg_pool_s8);
+}
+
+// -----------------------------------------------------------------------------
+// Add
+// -----------------------------------------------------------------------------
+
+static TfLiteStatus add_eval(TfLiteContext* context, TfLiteNode* node) {
+    const TfLiteEvalTensor* input1 = tflite::micro::GetEvalInput(context, node, 0);
+    const TfLiteEvalTensor* input2 = tflite::micro::GetEvalInput(context, node, 1);
+    TfLiteEvalTensor* output = tflite::micro::GetEvalOutput(context, node, 0);
+
+    const tflite::OpDataAdd& data = *static_cast<const tflite::OpDataAdd*>(node->user_data);
+
+    // ESP-NN solo suma elemento a elemento con la misma forma
+    if (output->type != kTfLiteInt8 || data.requires_broadcast) {
+        return refAdd.invoke(context, node);
+    }
+
+    esp_nn_add_elementwise_s8(tflite::micro::GetTensorData<int8_t>(input1),
+                              tflite::micro::GetTensorData<int8_t>(input2),
+                              data.input1_offset, data.input2_offset,
+                              data.input1_multiplier, data.input2_multiplier,
+                              data.input1_shift, data.input2_shift, data.left_shift,
+                              tflite::micro::GetTensorData<int8_t>(output),
+                              data.output_offset, data.output_multiplier, data.output_shift,
+                              data.output_activation_min, data.output_activation_max,
+                              tflite::micro::GetTensorShape(output).FlatSize());
+    return kTfLiteOk;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+namespace esp_nn_kernels {
+
+TfLiteRegistration Register_CONV_2D() {
+    refConv = tflite::Register_CONV_2D();
+    TfLiteRegistration registration = refConv;
+    registration.init = conv_init;
+    registration.prepare = conv_prepare;
+    registration.invoke = conv_eval;
+    return registration;
+}
+
+TfLiteRegistration Register_FULLY_CONNECTED() {
+    refFullyConnected = tflite::Register_FULLY_CONNECTED();
+    TfLiteRegistration registration = refFullyConnected;
+    registration.invoke = fully_connected_eval;
+    return registration;
+}
+
+TfLiteRegistration Register_MAX_POOL_2D() {
+    refMaxPool = tflite::Register_MAX_POOL_2D();
+    TfLiteRegistration registration = refMaxPool;
+    registration.invoke = max_pool_eval;
+    return registration;
+}
+
+TfLiteRegistration Register_AVERAGE_POOL_2D() {
+    refAvgPool = tflite::Register_AVERAGE_POOL_2D();
+    TfLiteRegistration registration = refAvgPool;
+    registration.invoke = avg_pool_eval;
+    return registration;
+}
+
+TfLiteRegistration Register_ADD() {
+    refAdd = tflite::Register_ADD();
+    TfLiteRegistration registration = refAdd;
+    registration.invoke = add_eval;
+    return registration;
+}
+
+}  // namespace esp_nn_kernels
+
+#endif // MODEL_ESP_NN
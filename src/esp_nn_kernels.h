@@ -0,0 +1,39 @@
+#ifndef ESP_NN_KERNELS_H
+#define ESP_NN_KERNELS_H
+
+// =============================================================================
+// Kernels int8 de ESP-NN para TFLite Micro
+// =============================================================================
+// Con -D MODEL_ESP_NN=1 (env t-circle-s3-RV-espnn) se linkea ESP-NN y el
+// resolver puede registrar estas versiones de Conv2D, FullyConnected,
+// MaxPool2D, AveragePool2D y Add. En el ESP32-S3 (CONFIG_NN_OPTIMIZED) usan
+// las rutinas SIMD; en host, las versiones en C portable de la misma
+// librería.
+//
+// Cada registro reusa init/prepare/free del kernel de referencia (los datos
+// cuantizados que calcula Prepare son los mismos) y solo cambia invoke. Lo
+// que ESP-NN no cubre (tipos no int8, dilation en Conv2D, Add con broadcast)
+// se delega al invoke de referencia.
+// =============================================================================
+
+#ifndef MODEL_ESP_NN
+#define MODEL_ESP_NN 0
+#endif
+
+#if MODEL_ESP_NN
+
+#include "tensorflow/lite/c/common.h"
+
+namespace esp_nn_kernels {
+
+TfLiteRegistration Register_CONV_2D();
+TfLiteRegistration Register_FULLY_CONNECTED();
+TfLiteRegistration Register_MAX_POOL_2D();
+TfLiteRegistration Register_AVERAGE_POOL_2D();
+TfLiteRegistration Register_ADD();
+
+}  // namespace esp_nn_kernels
+
+#endif // MODEL_ESP_NN
+
+#endif // ESP_NN_KERNELS_H
@@ -0,0 +1,238 @@
+#include "export_link.h"
+#include "config.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+
+// =============================================================================
+// Implementación - Export Link
+// =============================================================================
+
+// Tamaño del buffer de TX del USB-CDC (el default de 256 B limita el throughput)
+static constexpr size_t SERIAL_TX_BUFFER = 16 * 1024;
+
+static constexpr size_t FRAME_HEADER_BYTES = 4;
+static constexpr size_t FRAME_CRC_BYTES = 4;
+static constexpr size_t FRAME_PREFIX_MAX = 24;  // Campos fijos de BEGIN / DATA / END
+static constexpr size_t NAME_MAX_BYTES = 48;
+static constexpr size_t FRAME_MAX_BYTES =
+    FRAME_HEADER_BYTES + FRAME_PREFIX_MAX + NAME_MAX_BYTES + EXPORT_CHUNK_BYTES + FRAME_CRC_BYTES;
+
+// Trama sin codificar y codificada (COBS agrega 1 byte cada 254)
+static uint8_t frameBuffer[FRAME_MAX_BYTES];
+static uint8_t cobsBuffer[FRAME_MAX_BYTES + FRAME_MAX_BYTES / 254 + 2];
+static uint8_t fileChunk[EXPORT_CHUNK_BYTES];
+
+static uint32_t crcTable[256];
+static bool crcTableReady = false;
+
+static uint16_t sequence = 0;
+static uint8_t streamCounter = 0;
+
+struct ExportStream {
+    uint8_t id;
+    uint32_t offset;
+    uint32_t crc;
+};
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static void init_crc_table() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        crcTable[i] = c;
+    }
+    crcTableReady = true;
+}
+
+static size_t put_u16(uint8_t* out, uint16_t value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+    return 2;
+}
+
+static size_t put_u32(uint8_t* out, uint32_t value) {
+    out[0] = value & 0xFF;
+    out[1] = (value >> 8) & 0xFF;
+    out[2] = (value >> 16) & 0xFF;
+    out[3] = value >> 24;
+    return 4;
+}
+
+// Arma, codifica y envía una trama: header | prefix | data | crc32
+static bool send_frame(ExportFrameType type, uint8_t streamId,
+                       const uint8_t* prefix, size_t prefixLen,
+                       const uint8_t* data, size_t dataLen) {
+    size_t len = 0;
+    frameBuffer[len++] = type;
+    frameBuffer[len++] = streamId;
+    len += put_u16(frameBuffer + len, sequence++);
+
+    memcpy(frameBuffer + len, prefix, prefixLen);
+    len += prefixLen;
+    if (dataLen > 0) {
+        memcpy(frameBuffer + len, data, dataLen);
+        len += dataLen;
+    }
+
+    len += put_u32(frameBuffer + len, export_crc32(0, frameBuffer, len));
+
+    size_t encodedLen = export_cobs_encode(frameBuffer, len, cobsBuffer);
+
+    const uint8_t delimiter = 0x00;
+    bool ok = Serial.write(&delimiter, 1) == 1;
+    ok = ok && Serial.write(cobsBuffer, encodedLen) == encodedLen;
+    ok = ok && Serial.write(&delimiter, 1) == 1;
+    return ok;
+}
+
+static bool stream_begin(ExportStream& stream, ExportKind kind, uint32_t totalBytes,
+                         uint32_t iteration, uint32_t param0, uint32_t param1,
+                         const char* name) {
+    stream.id = ++streamCounter;
+    stream.offset = 0;
+    stream.crc = 0;
+
+    uint8_t prefix[FRAME_PREFIX_MAX + NAME_MAX_BYTES];
+    size_t len = 0;
+    prefix[len++] = kind;
+    len += put_u32(prefix + len, totalBytes);
+    len += put_u32(prefix + len, iteration);
+    len += put_u32(prefix + len, param0);
+    len += put_u32(prefix + len, param1);
+
+    size_t nameLen = strnlen(name, NAME_MAX_BYTES);
+    memcpy(prefix + len, name, nameLen);
+    len += nameLen;
+
+    return send_frame(EXPORT_FRAME_BEGIN, stream.id, prefix, len, nullptr, 0);
+}
+
+static bool stream_write(ExportStream& stream, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        size_t chunk = len < EXPORT_CHUNK_BYTES ? len : EXPORT_CHUNK_BYTES;
+
+        uint8_t prefix[4];
+        put_u32(prefix, stream.offset);
+        if (!send_frame(EXPORT_FRAME_DATA, stream.id, prefix, sizeof(prefix), data, chunk)) {
+            return false;
+        }
+
+        stream.crc = export_crc32(stream.crc, data, chunk);
+        stream.offset += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+    return true;
+}
+
+static bool stream_end(ExportStream& stream) {
+    uint8_t prefix[8];
+    put_u32(prefix, stream.offset);
+    put_u32(prefix + 4, stream.crc);
+    bool ok = send_frame(EXPORT_FRAME_END, stream.id, prefix, sizeof(prefix), nullptr, 0);
+    Serial.flush();
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+void export_prepare_serial() {
+    Serial.setTxBufferSize(SERIAL_TX_BUFFER);
+}
+
+bool export_audio(const int16_t* samples, size_t count, uint32_t iteration) {
+    unsigned long start = millis();
+    uint32_t totalBytes = count * sizeof(int16_t);
+
+    ExportStream stream;
+    bool ok = stream_begin(stream, EXPORT_KIND_AUDIO, totalBytes, iteration,
+                           SAMPLE_RATE, 16, "audio");
+    ok = ok && stream_write(stream, (const uint8_t*)samples, totalBytes);
+    ok = ok && stream_end(stream);
+
+    Serial.printf("\n[Export] audio: %u bytes en %lu ms%s\n",
+                  totalBytes, millis() - start, ok ? "" : " (ERROR)");
+    return ok;
+}
+
+bool export_mfcc(const float* mfcc, uint32_t iteration) {
+    unsigned long start = millis();
+    uint32_t totalBytes = N_MFCC * N_FRAMES * sizeof(float);
+
+    ExportStream stream;
+    bool ok = stream_begin(stream, EXPORT_KIND_MFCC, totalBytes, iteration,
+                           N_MFCC, N_FRAMES, "mfcc");
+    ok = ok && stream_write(stream, (const uint8_t*)mfcc, totalBytes);
+    ok = ok && stream_end(stream);
+
+    Serial.printf("\n[Export] mfcc: %u bytes en %lu ms%s\n",
+                  totalBytes, millis() - start, ok ? "" : " (ERROR)");
+    return ok;
+}
+
+bool export_file(const char* path) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("[Export] ERROR: No se pudo abrir %s\n", path);
+        return false;
+    }
+
+    unsigned long start = millis();
+    uint32_t totalBytes = file.size();
+
+    ExportStream stream;
+    bool ok = stream_begin(stream, EXPORT_KIND_FILE, totalBytes, 0, 0, 0, path);
+    while (ok && file.available()) {
+        size_t len = file.read(fileChunk, sizeof(fileChunk));
+        if (len == 0) break;
+        ok = stream_write(stream, fileChunk, len);
+    }
+    ok = ok && stream_end(stream);
+    file.close();
+
+    Serial.printf("\n[Export] %s: %u bytes en %lu ms%s\n",
+                  path, totalBytes, millis() - start, ok ? "" : " (ERROR)");
+    return ok;
+}
+
+uint32_t export_crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    if (!crcTableReady) init_crc_table();
+
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+size_t export_cobs_encode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t outIndex = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1;
+        } else {
+            out[outIndex++] = in[i];
+            code++;
+            if (code == 0xFF) {
+                out[codeIndex] = code;
+                codeIndex = outIndex++;
+                code = 1;
+            }
+        }
+    }
+
+    out[codeIndex] = code;
+    return outIndex;
+}
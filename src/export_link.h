@@ -0,0 +1,58 @@
+#ifndef EXPORT_LINK_H
+#define EXPORT_LINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// Export Link - Exportación binaria por USB-CDC
+// =============================================================================
+// Protocolo de tramas para sacar datos del dispositivo sin pasar por texto:
+//
+//   0x00 | COBS( header | payload | crc32 ) | 0x00
+//
+//   header:  type (u8) | stream_id (u8) | seq (u16 LE)
+//   crc32:   CRC-32 (IEEE, el mismo de zlib) de header + payload, LE
+//
+// Cada exportación es un stream: BEGIN, N tramas DATA y END. El 0x00 inicial
+// separa la trama de cualquier log de texto previo. El receptor host está en
+// tools/export_receiver.py.
+// =============================================================================
+
+// Tipos de trama
+enum ExportFrameType : uint8_t {
+    EXPORT_FRAME_BEGIN = 0x01,  // kind, total_bytes, iteration, param0, param1, nombre
+    EXPORT_FRAME_DATA  = 0x02,  // offset (u32) + datos
+    EXPORT_FRAME_END   = 0x03,  // total_bytes (u32) + crc32 del stream completo (u32)
+};
+
+// Contenido del stream
+enum ExportKind : uint8_t {
+    EXPORT_KIND_AUDIO = 1,      // int16 LE mono; param0 = sample rate, param1 = bits
+    EXPORT_KIND_MFCC  = 2,      // float32 LE [N_MFCC][N_FRAMES]; param0/1 = dimensiones
+    EXPORT_KIND_FILE  = 3,      // Archivo de LittleFS (ej: CSV de métricas)
+};
+
+// Payload máximo de una trama DATA
+constexpr size_t EXPORT_CHUNK_BYTES = 2048;
+
+// Configura el buffer de TX del USB-CDC (llamar antes de Serial.begin())
+void export_prepare_serial();
+
+// Exporta una ventana de audio
+bool export_audio(const int16_t* samples, size_t count, uint32_t iteration);
+
+// Exporta una matriz de MFCCs (N_MFCC * N_FRAMES floats)
+bool export_mfcc(const float* mfcc, uint32_t iteration);
+
+// Exporta un archivo de LittleFS tal cual (ej: /profiling.csv)
+bool export_file(const char* path);
+
+// CRC-32 IEEE incremental (crc = 0 para empezar)
+uint32_t export_crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+// Codifica len bytes con COBS; out debe tener len + len / 254 + 1 bytes
+// Retorna la cantidad de bytes escritos (sin el delimitador 0x00)
+size_t export_cobs_encode(const uint8_t* in, size_t len, uint8_t* out);
+
+#endif // EXPORT_LINK_H
@@ -0,0 +1,207 @@
+#include "../config.h"
+#include "../batch.h"
+#include "../mfcc_extractor.h"
+#include "../emotion_model.h"
+#include "../profiler.h"
+#include "../memory_plan.h"
+#include <Arduino.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+// =============================================================================
+// Modo batch en host (env native-batch)
+// =============================================================================
+// Corre el pipeline sobre todos los .wav de un directorio (recursivo) con un
+// pool de hilos. Cada worker tiene su propio intérprete y buffers de MFCC
+// (PIPELINE_THREAD_LOCAL) y toma el siguiente archivo de una cola compartida.
+//
+//   pio run -e native-batch
+//   .pio/build/native-batch/program dataset/ --jobs=8 --out=results.csv
+//   (--metrics=metrics.csv agrega los PipelineMetrics)
+//
+// results.csv: una fila por archivo (ver batch_write_results_header)
+// metrics.csv: mismo formato que /profiling.csv
+// =============================================================================
+
+// Print sobre un FILE* del host
+class FilePrint : public Print {
+public:
+    explicit FilePrint(FILE* fp) : fp_(fp) {}
+    size_t write(const uint8_t* data, size_t len) override {
+        return fp_ ? fwrite(data, 1, len, fp_) : 0;
+    }
+    using Print::write;
+
+private:
+    FILE* fp_;
+};
+
+struct BatchOptions {
+    std::string dir;
+    std::string model;
+    const char* resultsPath = nullptr;
+    const char* metricsPath = nullptr;
+    unsigned jobs = 0;
+    bool verbose = false;
+};
+
+static void print_usage(const char* argv0) {
+    fprintf(stderr,
+            "Uso: %s <dir> [--jobs=N] [--model=PATH] [--out=results.csv]\n"
+            "          [--metrics=metrics.csv] [--verbose]\n", argv0);
+}
+
+static std::string absolute_path(const char* path) {
+    char buf[PATH_MAX];
+    return realpath(path, buf) ? std::string(buf) : std::string();
+}
+
+static void collect_wavs(const std::string& dir, std::vector<std::string>& out) {
+    DIR* d = opendir(dir.c_str());
+    if (!d) return;
+
+    struct dirent* ent;
+    while ((ent = readdir(d)) != nullptr) {
+        if (ent->d_name[0] == '.') continue;
+        std::string path = dir + "/" + ent->d_name;
+
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            collect_wavs(path, out);
+        } else {
+            size_t len = path.size();
+            if (len > 4 && strcasecmp(path.c_str() + len - 4, ".wav") == 0) out.push_back(path);
+        }
+    }
+    closedir(d);
+}
+
+static bool parse_args(int argc, char** argv, BatchOptions& opts) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--jobs=", 7) == 0) {
+            opts.jobs = (unsigned)atoi(arg + 7);
+        } else if (strncmp(arg, "--model=", 8) == 0) {
+            opts.model = arg + 8;
+        } else if (strncmp(arg, "--out=", 6) == 0) {
+            opts.resultsPath = arg + 6;
+        } else if (strncmp(arg, "--metrics=", 10) == 0) {
+            opts.metricsPath = arg + 10;
+        } else if (strcmp(arg, "--verbose") == 0) {
+            opts.verbose = true;
+        } else if (arg[0] != '-' && opts.dir.empty()) {
+            opts.dir = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opts.dir.empty();
+}
+
+int main(int argc, char** argv) {
+    BatchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    // Paths absolutos del host: LittleFS se monta en "/" para que
+    // wav_read_pcm16 y model_load los acepten tal cual
+    std::string dir = absolute_path(opts.dir.c_str());
+    std::string model = absolute_path(opts.model.empty()
+                                          ? (std::string("data") + MODEL_PATH).c_str()
+                                          : opts.model.c_str());
+    if (dir.empty() || model.empty()) {
+        fprintf(stderr, "[Batch] ERROR: No existe %s\n",
+                dir.empty() ? opts.dir.c_str() : "el modelo (--model)");
+        return 1;
+    }
+    setenv("HOST_FS_ROOT", "/", 1);
+
+    std::vector<std::string> files;
+    collect_wavs(dir, files);
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        fprintf(stderr, "[Batch] ERROR: No hay .wav en %s\n", dir.c_str());
+        return 1;
+    }
+
+    unsigned jobs = opts.jobs ? opts.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<unsigned>(jobs, files.size());
+    fprintf(stderr, "[Batch] %zu archivos, %u hilos, modelo %s\n", files.size(), jobs, model.c_str());
+
+    FILE* resultsFp = opts.resultsPath ? fopen(opts.resultsPath, "w") : nullptr;
+    FILE* metricsFp = opts.metricsPath ? fopen(opts.metricsPath, "w") : nullptr;
+    if ((opts.resultsPath && !resultsFp) || (opts.metricsPath && !metricsFp)) {
+        fprintf(stderr, "[Batch] ERROR: No se pudo crear el archivo de salida\n");
+        return 1;
+    }
+    FilePrint results(resultsFp);
+    FilePrint metricsOut(metricsFp);
+    if (resultsFp) batch_write_results_header(results);
+    if (metricsFp) profiler_write_csv_header(metricsOut);
+
+    // Los logs por archivo de MFCC y modelo tapan el progreso
+    Serial.setMuted(!opts.verbose);
+
+    std::atomic<size_t> nextFile(0);
+    std::atomic<bool> initFailed(false);
+    std::mutex outputMutex;
+    BatchSummary summary = {};
+    unsigned long startMs = millis();
+
+    auto worker = [&]() {
+        // Cada hilo arma su propio plan (el estado del planner es thread_local)
+        PipelineBuffers buffers;
+        if (!memory_plan_pipeline(model.c_str(), buffers) || !mfcc_init() || !model_load(model.c_str())) {
+            initFailed = true;
+        } else {
+            size_t i;
+            while (!initFailed && (i = nextFile++) < files.size()) {
+                PipelineMetrics metrics;
+                BatchFileResult result;
+                uint32_t iteration = (uint32_t)(i + 1);
+                batch_process_file(files[i].c_str(), buffers.audio, buffers.mfcc, iteration, metrics, result);
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                if (resultsFp) batch_write_result_row(results, iteration, files[i].c_str(), result);
+                if (metricsFp && result.samples >= 0) profiler_write_csv_row(metricsOut, metrics);
+                batch_summary_add(summary, result);
+                if (summary.files % 100 == 0) {
+                    fprintf(stderr, "[Batch] %u/%zu\n", summary.files, files.size());
+                }
+            }
+        }
+        model_unload();
+        memory_plan_reset();
+        mfcc_deinit();
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned j = 0; j < jobs; j++) pool.emplace_back(worker);
+    for (std::thread& t : pool) t.join();
+
+    double wallMs = millis() - startMs;
+    Serial.setMuted(false);
+
+    if (resultsFp) fclose(resultsFp);
+    if (metricsFp) fclose(metricsFp);
+
+    if (initFailed) {
+        fprintf(stderr, "[Batch] ERROR: Un worker no pudo inicializar MFCC o el modelo\n");
+        return 1;
+    }
+
+    FilePrint out(stdout);
+    batch_print_summary(out, summary, wallMs);
+    return summary.failed == summary.files ? 1 : 0;
+}
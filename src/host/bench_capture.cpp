@@ -0,0 +1,120 @@
+#include "microbench.h"
+#include "../config.h"
+#include "../audio_capture.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "esp_heap_caps.h"
+#include "hardware/Arduino_ReplayIIS.h"
+
+// =============================================================================
+// Benchmark de la captura I2S en host (env native-capture)
+// =============================================================================
+// Corre audio_capture() sin cambios sobre un Arduino_ReplayIIS que sirve
+// data/audio.wav con el ritmo del DMA real. Cada configuración cambia el
+// tamaño de los buffers DMA, el jitter o la tasa de bloques perdidos; además
+// del CPU por ventana se reportan llamadas a Read(), bytes, bloques perdidos
+// por overrun y el tiempo bloqueado esperando datos.
+//
+//   pio run -e native-capture
+//   .pio/build/native-capture/program --out=capture.json
+//
+// Cada iteración dura AUDIO_DURATION_SEC reales (la captura es en tiempo
+// real). $BENCH_WAV cambia el WAV; si no se puede leer se usa un barrido.
+// =============================================================================
+
+struct CaptureConfig {
+    const char* name;
+    uint16_t dmaBufCount;
+    uint16_t dmaBufLen;
+    uint32_t jitterUs;
+    float dropoutRate;
+};
+
+// La primera es la de Arduino_HWIIS
+static const CaptureConfig CONFIGS[] = {
+    {"capture_dma8x1024",   8, 1024,    0, 0.0f},
+    {"capture_dma4x256",    4,  256,    0, 0.0f},
+    {"capture_dma2x64",     2,   64,    0, 0.0f},
+    {"capture_jitter2ms",   8, 1024, 2000, 0.0f},
+    {"capture_dropout1pct", 8, 1024,    0, 0.01f},
+};
+
+static const char* wavPath = "/audio.wav";
+static int16_t* audioBuffer = nullptr;
+static bool useWav = false;
+
+static void run_capture(BenchState& state, const CaptureConfig& config) {
+    std::shared_ptr<Arduino_ReplayIIS> bus = std::make_shared<Arduino_ReplayIIS>();
+    if (!useWav || !bus->loadWav(LittleFS.hostPath(wavPath).c_str())) {
+        bus->setSynthetic(Arduino_ReplayIIS::SS_SWEEP);
+    }
+    bus->setDmaBuffers(config.dmaBufCount, config.dmaBufLen);
+    bus->setJitter(config.jitterUs);
+    bus->setDropoutRate(config.dropoutRate);
+
+    if (!audio_init_bus(bus)) {
+        state.skipWithError("no se pudo iniciar el bus");
+        return;
+    }
+    // begin() arranca el reloj del DMA: se descartan los bloques acumulados
+    // durante la inicialización
+    bus->resetStats();
+
+    while (state.keepRunning()) {
+        if (!audio_capture(audioBuffer)) {
+            state.skipWithError("captura vacía");
+        }
+    }
+
+    Arduino_ReplayIIS::Stats stats = bus->getStats();
+    double n = state.iterations() ? (double)state.iterations() : 1.0;
+    double samples = stats.bytes_read / n / sizeof(int16_t);
+
+    state.setCounter("read_calls_per_iter", stats.read_calls / n);
+    state.setCounter("bytes_per_iter", stats.bytes_read / n);
+    state.setCounter("samples_captured", samples < AUDIO_SAMPLES ? samples : AUDIO_SAMPLES);
+    state.setCounter("blocks_produced", stats.blocks_produced);
+    state.setCounter("blocks_dropped", stats.blocks_dropped);
+    state.setCounter("dropouts", stats.dropouts);
+    state.setCounter("wait_ms_per_iter", stats.wait_us / n / 1000.0);
+}
+
+template <size_t I>
+static void BM_capture(BenchState& state) {
+    run_capture(state, CONFIGS[I]);
+}
+
+// -----------------------------------------------------------------------------
+// main
+// -----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    const char* envWav = getenv("BENCH_WAV");
+    if (envWav && *envWav) wavPath = envWav;
+
+    audioBuffer = (int16_t*)heap_caps_aligned_alloc(16, AUDIO_SAMPLES * sizeof(int16_t), MALLOC_CAP_SPIRAM);
+    if (!audioBuffer) {
+        fprintf(stderr, "[Bench] ERROR: No se pudo alocar el buffer\n");
+        return 1;
+    }
+
+    useWav = LittleFS.exists(wavPath);
+    if (!useWav) {
+        fprintf(stderr, "[Bench] WARNING: No existe %s, se usa un barrido sintético\n", wavPath);
+    }
+
+    bench_add_context("source", useWav ? wavPath : "sweep");
+    bench_add_context("sample_rate", (double)SAMPLE_RATE);
+    bench_add_context("window_sec", (double)AUDIO_DURATION_SEC);
+
+    bench_register(CONFIGS[0].name, BM_capture<0>);
+    bench_register(CONFIGS[1].name, BM_capture<1>);
+    bench_register(CONFIGS[2].name, BM_capture<2>);
+    bench_register(CONFIGS[3].name, BM_capture<3>);
+    bench_register(CONFIGS[4].name, BM_capture<4>);
+
+    int rc = bench_main(argc, argv);
+
+    heap_caps_free(audioBuffer);
+    return rc;
+}
@@ -0,0 +1,701 @@
+#include "microbench.h"
+#include "../config.h"
+#include "../mfcc_heatmap.h"
+#include "../animation.h"
+#include <Arduino.h>
+#include "Arduino_DataBus.h"
+#include "databus/Arduino_HostFramebuffer.h"
+#include "display/Arduino_GC9D01N.h"
+#include "canvas/Arduino_Canvas.h"
+#include "canvas/Arduino_Canvas_Indexed.h"
+#include "Arduino_GlyphCache.h"
+#include "font/glcdfont.h"
+#include "pin_config.h"
+
+// =============================================================================
+// Benchmark del flush de Arduino_Canvas en host (env native-display)
+// =============================================================================
+// El canvas dibuja sobre el driver real del GC9D01N, y el bus es
+// Arduino_HostFramebuffer: decodifica CASET/RASET/RAMWR en una memoria de
+// frame RGB565 y cuenta lo que saldría por SPI: bytes (comandos + datos),
+// ventanas (RAMWR), cambios de ventana y transacciones. Los bytes por frame
+// son el proxy del tiempo de SPI en el panel; el tiempo medido es CPU de
+// dibujo más la copia de cada píxel a la memoria de frame del host.
+//
+//   pio run -e native-display
+//   .pio/build/native-display/program --out=display.json
+//
+// Snapshots: antes de medir se dibujan escenas fijas (status, heatmap, texto,
+// arcos, bitmaps, animación) en el panel y se comparan contra los PNG de
+// BENCH_GOLDEN_DIR (por defecto test/display_golden, relativo al directorio
+// actual como data/; vacío no compara). El contexto del JSON lleva los píxeles
+// distintos por escena (golden_<escena>, -1 si falta el PNG) y el programa
+// termina con 1 si alguna escena difiere o falta su golden, así una
+// optimización de dibujo que no es pixel-exacta no pasa en silencio.
+// bitmaps_round dibuja bitmaps de Arduino_Canvas sobre la máscara circular y
+// también falla si pinta fuera del disco (bitmaps_round_outside_mask).
+// Con BENCH_SNAPSHOT_DIR=dir se guarda un PNG por escena; para actualizar los
+// goldens después de un cambio de dibujo intencional:
+//   BENCH_SNAPSHOT_DIR=test/display_golden .pio/build/native-display/program --filter=none
+//
+// Escenas, cada una con el canvas cuadrado y con la máscara circular:
+//   full   - frame completo (markAllDirty + flush)
+//   status - UI de estado: etiqueta de emoción + anillo de progreso que avanza
+// Además, heatmap_column: una columna del heatmap de MFCCs (mfcc_heatmap.h)
+//
+// indexed_* miden solo CPU de dibujo sobre Arduino_Canvas_Indexed (sin
+// flush), donde cada color pasa por get_color_index(). Para comparar con la
+// búsqueda lineal anterior:
+//   PLATFORMIO_BUILD_FLAGS=-DCANVAS_INDEXED_LINEAR_LOOKUP=1 pio run -e native-display
+//
+// text_* miden CPU de texto sobre Arduino_Canvas con y sin Arduino_GlyphCache:
+// GFXfont (generado en runtime desde glcdfont, el repo no trae fuentes
+// GFXfont) y u8g2 si el build tiene U8G2_FONT_SUPPORT.
+//
+// tft_text_* dibujan texto directo en el panel (sin canvas), donde cuenta el
+// tráfico del bus: tft_text_chars escribe carácter por carácter (una ventana
+// por carácter con fondo), tft_text imprime cada línea de una vez y
+// Arduino_TFT la manda en una sola ventana; tft_text_transparent sin fondo.
+//
+// arc_* miden CPU de fillArc sobre Arduino_Canvas (anillo de progreso +
+// medidor): arc_float es el rasterizador float anterior (fillArcHelper),
+// arc_int el de enteros con tabla de senos (tramos por fila) y arc_aa el
+// mismo con bordes suavizados. arc_int reporta además los píxeles que
+// difieren del float.
+//
+// bitmap_* dibujan un ícono de 48x48 directo en el panel en RGB565 y
+// indexado (paleta de 16 colores), como las animaciones de la UI.
+//
+// anim_* usan un GIF de LittleFS (raíz $HOST_FS_ROOT o data/; el path sale
+// de BENCH_GIF, por defecto ANIM_LISTEN_PATH): anim_decode es anim_load()
+// completo y reporta decode_us_per_frame, lo que costaba decodificar cada
+// frame con GifClass; anim_frame es un anim_tick() que manda el frame
+// siguiente desde la animación ya decodificada.
+// =============================================================================
+
+static Arduino_HostFramebuffer bus(LCD_WIDTH, LCD_HEIGHT);
+static Arduino_GC9D01N panel(&bus, LCD_RST, 0, false, LCD_WIDTH, LCD_HEIGHT);
+
+static const char* const LABELS[] = {"Neutral", "Feliz", "Triste", "Enojo"};
+
+static void report(BenchState& state) {
+    Arduino_HostFramebuffer::Stats stats = bus.getStats();
+    double n = state.iterations() ? (double)state.iterations() : 1.0;
+    state.setCounter("spi_bytes_per_frame", stats.bytes / n);
+    state.setCounter("windows_per_frame", stats.windows / n);
+    state.setCounter("window_changes_per_frame", stats.window_changes / n);
+    state.setCounter("transactions_per_frame", stats.transactions / n);
+}
+
+static bool init_canvas(BenchState& state, Arduino_Canvas& canvas, bool circular) {
+    canvas.setCircularMask(circular);
+    if (!canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+        state.skipWithError("no se pudo alocar el framebuffer");
+        return false;
+    }
+    canvas.fillScreen(0x0000);
+    canvas.flush();
+    bus.resetStats();
+    return true;
+}
+
+static void run_full(BenchState& state, bool circular) {
+    Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!init_canvas(state, canvas, circular)) return;
+
+    while (state.keepRunning()) {
+        canvas.markAllDirty();
+        canvas.flush();
+    }
+    report(state);
+}
+
+static void draw_status(Arduino_Canvas& canvas, uint32_t frame) {
+    int16_t cx = LCD_WIDTH / 2;
+    int16_t cy = LCD_HEIGHT / 2;
+
+    // Anillo: avanza 6 grados por frame y se limpia al completar la vuelta
+    float start = (frame % 60) * 6.0f;
+    if (start == 0) canvas.fillArc(cx, cy, 78, 70, 0, 360, 0x0000);
+    canvas.fillArc(cx, cy, 78, 70, start, start + 6.0f, 0x07E0);
+
+    // Etiqueta: cambia cada 25 frames (una inferencia)
+    if (frame % 25 == 0) {
+        canvas.fillRect(cx - 48, cy - 8, 96, 16, 0x0000);
+        canvas.setTextSize(2);
+        canvas.setTextColor(0xFFFF);
+        canvas.setCursor(cx - 42, cy - 7);
+        canvas.print(LABELS[(frame / 25) % 4]);
+    }
+}
+
+static void run_status(BenchState& state, bool circular) {
+    Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!init_canvas(state, canvas, circular)) return;
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        draw_status(canvas, frame);
+        canvas.flush();
+        frame++;
+    }
+    report(state);
+}
+
+static void BM_heatmap_column(BenchState& state) {
+    if (!heatmap_init(&panel, HEATMAP_X, HEATMAP_Y)) {
+        state.skipWithError("no se pudo crear el heatmap");
+        return;
+    }
+    float column[N_MFCC];
+    for (int i = 0; i < N_MFCC; i++) column[i] = sinf(i * 0.3f) * 2.0f;
+    bus.resetStats();
+
+    int frame = 0;
+    while (state.keepRunning()) {
+        heatmap_push_column(frame, column);
+        frame = (frame + 1) % N_FRAMES;
+    }
+
+    Arduino_HostFramebuffer::Stats stats = bus.getStats();
+    double n = state.iterations() ? (double)state.iterations() : 1.0;
+    state.setCounter("spi_bytes_per_column", stats.bytes / n);
+    state.setCounter("windows_per_column", stats.windows / n);
+    heatmap_deinit();
+}
+
+// Paleta de 200 colores ya cargada, como en una UI con íconos
+static bool init_indexed(BenchState& state, Arduino_Canvas_Indexed& canvas) {
+    if (!canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+        state.skipWithError("no se pudo alocar el framebuffer");
+        return false;
+    }
+    for (int i = 0; i < 200; i++) {
+        canvas.drawPixel(i % LCD_WIDTH, i / LCD_WIDTH, RGB565(i, 255 - i, (i * 7) & 0xFF));
+    }
+    return true;
+}
+
+static void BM_indexed_fill(BenchState& state) {
+    Arduino_Canvas_Indexed canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!init_indexed(state, canvas)) return;
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        for (int i = 0; i < 64; i++) {
+            int c = (i + frame) % 200;
+            canvas.fillRect((i % 8) * 20, (i / 8) * 20, 20, 20, RGB565(c, 255 - c, (c * 7) & 0xFF));
+        }
+        frame++;
+    }
+}
+
+static void BM_indexed_gradient(BenchState& state) {
+    Arduino_Canvas_Indexed canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!init_indexed(state, canvas)) return;
+
+    while (state.keepRunning()) {
+        for (int16_t y = 0; y < LCD_HEIGHT; y++) {
+            for (int16_t x = 0; x < LCD_WIDTH; x++) {
+                canvas.drawPixel(x, y, RGB565(x + 48, y + 48, 128));
+            }
+        }
+    }
+}
+
+static void BM_indexed_text(BenchState& state) {
+    static const uint16_t COLORS[] = {0xFFFF, 0xF800, 0x07E0, 0x001F, 0xFFE0, 0xF81F, 0x07FF, 0x8410};
+    Arduino_Canvas_Indexed canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!init_indexed(state, canvas)) return;
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        for (int line = 0; line < 8; line++) {
+            canvas.setTextColor(COLORS[(line + frame) % 8], 0x0000);
+            canvas.setCursor(8, 16 + line * 16);
+            canvas.print(LABELS[line % 4]);
+            canvas.print(" 87%");
+        }
+        frame++;
+    }
+}
+
+// glcdfont (5x8 por columnas) convertido a GFXfont (bits por filas)
+static uint8_t text_bitmap[95 * 5];
+static GFXglyph text_glyphs[95];
+static GFXfont text_font = {text_bitmap, text_glyphs, ' ', '~', 10};
+
+static void init_text_font() {
+    for (int c = 0; c < 95; c++) {
+        uint8_t* bits = &text_bitmap[c * 5];
+        int bit = 0;
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 5; x++, bit++) {
+                if (font[(c + ' ') * 5 + x] & (1 << y)) bits[bit >> 3] |= 0x80 >> (bit & 7);
+            }
+        }
+        text_glyphs[c] = {(uint16_t)(c * 5), 5, 8, 6, 0, -7};
+    }
+}
+
+// Pantalla de texto: 8 líneas de etiquetas + porcentaje, como el log de inferencias
+static void run_text(BenchState& state, bool cached, bool u8g2, uint8_t size) {
+    Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+        state.skipWithError("no se pudo alocar el framebuffer");
+        return;
+    }
+    canvas.fillScreen(0x0000);
+    canvas.setFont(&text_font);
+#if defined(U8G2_FONT_SUPPORT)
+    if (u8g2) canvas.setFont(u8g2_font_unifont_t_chinese4);
+#else
+    (void)u8g2;
+#endif
+    canvas.setTextSize(size);
+    canvas.setTextWrap(false);
+
+    Arduino_GlyphCache cache;
+    if (cached) canvas.setGlyphCache(&cache);
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        for (int line = 0; line < 8; line++) {
+            canvas.setTextColor(0xFFFF, 0x0000);
+            canvas.setCursor(4, 16 + line * 18);
+            canvas.print(LABELS[(line + frame) % 4]);
+            canvas.print(" 87%");
+        }
+        frame++;
+    }
+    if (cached) {
+        uint32_t lookups = cache.getHits() + cache.getMisses();
+        state.setCounter("glyph_hit_rate", lookups ? (double)cache.getHits() / lookups : 0.0);
+        state.setCounter("glyph_span_bytes", cache.getSpanBytes());
+    }
+}
+
+static void BM_text_gfxfont(BenchState& state) { run_text(state, false, false, 1); }
+static void BM_text_gfxfont_cached(BenchState& state) { run_text(state, true, false, 1); }
+static void BM_text_gfxfont_x2(BenchState& state) { run_text(state, false, false, 2); }
+static void BM_text_gfxfont_x2_cached(BenchState& state) { run_text(state, true, false, 2); }
+#if defined(U8G2_FONT_SUPPORT)
+static void BM_text_u8g2(BenchState& state) { run_text(state, false, true, 1); }
+static void BM_text_u8g2_cached(BenchState& state) { run_text(state, true, true, 1); }
+#endif
+
+// Tabla de resultados en el panel: 8 líneas de etiqueta + porcentaje
+static void draw_tft_text(uint32_t frame, bool per_char) {
+    char line[24];
+    for (int i = 0; i < 8; i++) {
+        snprintf(line, sizeof(line), "%-8s %3u%%", LABELS[(i + frame) % 4], (unsigned)((i * 13 + frame) % 101));
+        panel.setCursor(24, 16 + i * 16);
+        if (per_char) {
+            for (const char* c = line; *c; c++) panel.write((uint8_t)*c);
+        } else {
+            panel.print(line);
+        }
+    }
+}
+
+static void setup_tft_text(bool opaque) {
+    panel.setFont(nullptr);
+    panel.setTextSize(1);
+    panel.setTextWrap(false);
+    if (opaque) {
+        panel.setTextColor(0xFFFF, 0x0000);
+    } else {
+        panel.setTextColor(0xFFFF);
+    }
+}
+
+static void run_tft_text(BenchState& state, bool per_char, bool opaque) {
+    panel.fillScreen(0x0000);
+    setup_tft_text(opaque);
+    bus.resetStats();
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        draw_tft_text(frame, per_char);
+        frame++;
+    }
+    report(state);
+}
+
+static void BM_tft_text_chars(BenchState& state) { run_tft_text(state, true, true); }
+static void BM_tft_text(BenchState& state) { run_tft_text(state, false, true); }
+static void BM_tft_text_transparent(BenchState& state) { run_tft_text(state, false, false); }
+
+// Anillo de progreso (6 grados que avanzan) + medidor grueso, como la UI de estado
+enum ArcMode { ARC_FLOAT, ARC_INT, ARC_AA };
+
+static void draw_arcs(Arduino_Canvas& canvas, ArcMode mode, uint32_t frame) {
+    int16_t cx = LCD_WIDTH / 2;
+    int16_t cy = LCD_HEIGHT / 2;
+    float start = (frame % 60) * 6.0f;
+    float gauge = 30.0f + (frame % 100) * 2.4f;
+    switch (mode) {
+    case ARC_FLOAT:
+        // fillArc() antes del cambio: normalización + fillArcHelper en float
+        canvas.startWrite();
+        canvas.fillArcHelper(cx, cy, 78, 70, start, start + 6.0f, 0x07E0);
+        canvas.fillArcHelper(cx, cy, 60, 40, 30.0f, gauge, 0xFD20);
+        canvas.endWrite();
+        break;
+    case ARC_INT:
+        canvas.fillArc(cx, cy, 78, 70, start, start + 6.0f, 0x07E0);
+        canvas.fillArc(cx, cy, 60, 40, 30.0f, gauge, 0xFD20);
+        break;
+    case ARC_AA:
+        canvas.fillArcAA(cx, cy, 78, 70, start, start + 6.0f, 0x07E0);
+        canvas.fillArcAA(cx, cy, 60, 40, 30.0f, gauge, 0xFD20);
+        break;
+    }
+}
+
+// Píxeles distintos entre el rasterizador float y el de enteros, en 600 frames
+static uint32_t arc_mismatches() {
+    Arduino_Canvas a(LCD_WIDTH, LCD_HEIGHT, &panel);
+    Arduino_Canvas b(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!a.begin(GFX_SKIP_OUTPUT_BEGIN) || !b.begin(GFX_SKIP_OUTPUT_BEGIN)) return UINT32_MAX;
+    uint32_t diff = 0;
+    for (uint32_t frame = 0; frame < 600; frame++) {
+        a.fillScreen(0x0000);
+        b.fillScreen(0x0000);
+        draw_arcs(a, ARC_FLOAT, frame);
+        draw_arcs(b, ARC_INT, frame);
+        const uint16_t* fa = a.getFramebuffer();
+        const uint16_t* fb = b.getFramebuffer();
+        for (uint32_t i = 0; i < (uint32_t)LCD_WIDTH * LCD_HEIGHT; i++) {
+            if (fa[i] != fb[i]) diff++;
+        }
+    }
+    return diff;
+}
+
+static void run_arc(BenchState& state, ArcMode mode) {
+    Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+    if (!canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+        state.skipWithError("no se pudo alocar el framebuffer");
+        return;
+    }
+    canvas.fillScreen(0x0000);
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        draw_arcs(canvas, mode, frame);
+        frame++;
+    }
+    if (mode == ARC_INT) state.setCounter("pixels_differing_from_float", arc_mismatches());
+}
+
+static void BM_arc_float(BenchState& state) { run_arc(state, ARC_FLOAT); }
+static void BM_arc_int(BenchState& state) { run_arc(state, ARC_INT); }
+static void BM_arc_aa(BenchState& state) { run_arc(state, ARC_AA); }
+
+// Ícono de 48x48: círculos concéntricos con paleta de 16 colores
+#define ICON_SIZE 48
+static uint8_t icon_indexed[ICON_SIZE * ICON_SIZE];
+static uint16_t icon_palette[16];
+static uint16_t icon_rgb565[ICON_SIZE * ICON_SIZE];
+
+static void init_icon() {
+    for (int i = 0; i < 16; i++) icon_palette[i] = RGB565(i * 17, 255 - i * 17, (i * 53) & 0xFF);
+    for (int y = 0; y < ICON_SIZE; y++) {
+        for (int x = 0; x < ICON_SIZE; x++) {
+            int dx = x - ICON_SIZE / 2;
+            int dy = y - ICON_SIZE / 2;
+            uint8_t idx = ((dx * dx + dy * dy) / 40 + (x / 12)) & 0x0F;
+            icon_indexed[y * ICON_SIZE + x] = idx;
+            icon_rgb565[y * ICON_SIZE + x] = icon_palette[idx];
+        }
+    }
+}
+
+static void draw_icon(bool indexed, uint32_t frame) {
+    int16_t x = (frame * 7) % (LCD_WIDTH - ICON_SIZE);
+    int16_t y = (frame * 5) % (LCD_HEIGHT - ICON_SIZE);
+    if (indexed) {
+        panel.drawIndexedBitmap(x, y, icon_indexed, icon_palette, ICON_SIZE, ICON_SIZE);
+    } else {
+        panel.draw16bitRGBBitmap(x, y, icon_rgb565, ICON_SIZE, ICON_SIZE);
+    }
+}
+
+static void run_bitmap(BenchState& state, bool indexed) {
+    panel.fillScreen(0x0000);
+    bus.resetStats();
+
+    uint32_t frame = 0;
+    while (state.keepRunning()) {
+        draw_icon(indexed, frame);
+        frame++;
+    }
+    report(state);
+}
+
+static const char* gifPath = ANIM_LISTEN_PATH;
+
+static void BM_anim_decode(BenchState& state) {
+    AnimInfo info = {};
+    uint64_t totalUs = 0;
+    while (state.keepRunning()) {
+        uint32_t startUs = micros();
+        int id = anim_load(gifPath);
+        totalUs += micros() - startUs;
+        if (id < 0) {
+            state.skipWithError("no se pudo cargar el GIF (BENCH_GIF)");
+            return;
+        }
+        anim_get_info(id, info);
+        anim_unload_all();
+    }
+    double n = state.iterations() ? (double)state.iterations() : 1.0;
+    state.setCounter("frames", info.frames);
+    state.setCounter("decode_us_per_frame", info.frames ? totalUs / n / info.frames : 0.0);
+    state.setCounter("psram_bytes", info.bytes);
+}
+
+static void BM_anim_frame(BenchState& state) {
+    int id = anim_load(gifPath);
+    AnimInfo info;
+    if (id < 0 || !anim_get_info(id, info)) {
+        state.skipWithError("no se pudo cargar el GIF (BENCH_GIF)");
+        return;
+    }
+    panel.fillScreen(0x0000);
+    anim_play(id, &panel, ANIM_X, ANIM_Y);
+    bus.resetStats();
+
+    // Un tick por frame: el tiempo avanza lo justo para que venza el delay
+    uint32_t now = millis();
+    while (state.keepRunning()) {
+        now += 1000;
+        anim_tick(now);
+    }
+    report(state);
+    state.setCounter("pixels_per_loop", info.pixels_per_loop);
+    anim_unload_all();
+}
+
+static void BM_bitmap_rgb565(BenchState& state) { run_bitmap(state, false); }
+static void BM_bitmap_indexed(BenchState& state) { run_bitmap(state, true); }
+
+static void BM_full_square(BenchState& state) { run_full(state, false); }
+static void BM_full_round(BenchState& state) { run_full(state, true); }
+static void BM_status_square(BenchState& state) { run_status(state, false); }
+static void BM_status_round(BenchState& state) { run_status(state, true); }
+
+// -----------------------------------------------------------------------------
+// Snapshots
+// -----------------------------------------------------------------------------
+
+#define BENCH_GOLDEN_DEFAULT_DIR "test/display_golden"
+
+// Escenas que difieren del golden, no lo tienen o no se pudieron dibujar
+static uint32_t snapshotFailures = 0;
+
+static const char* golden_dir() {
+    const char* dir = getenv("BENCH_GOLDEN_DIR");
+    if (!dir) return BENCH_GOLDEN_DEFAULT_DIR;
+    return *dir ? dir : nullptr;
+}
+
+// Guarda y/o compara la memoria de frame del panel con <dir>/<escena>.png
+static void snapshot(const char* scene) {
+    const char* out_dir = getenv("BENCH_SNAPSHOT_DIR");
+    const char* golden = golden_dir();
+    char path[256];
+    if (out_dir) {
+        snprintf(path, sizeof(path), "%s/%s.png", out_dir, scene);
+        if (!bus.writePng(path)) {
+            fprintf(stderr, "[Bench] ERROR: No se pudo escribir %s\n", path);
+        }
+    }
+    if (golden) {
+        snprintf(path, sizeof(path), "%s/%s.png", golden, scene);
+        int32_t diff = bus.comparePng(path);
+        char key[64];
+        snprintf(key, sizeof(key), "golden_%s", scene);
+        bench_add_context(key, (double)diff);
+        if (diff != 0) snapshotFailures++;
+        if (diff < 0) {
+            fprintf(stderr, "[Bench] ERROR: No se pudo leer %s\n", path);
+        } else if (diff > 0) {
+            fprintf(stderr, "[Bench] %s: %ld píxeles distintos del golden\n", scene, (long)diff);
+        }
+    }
+}
+
+static void snapshot_canvas(const char* scene, Arduino_Canvas& canvas) {
+    canvas.markAllDirty();
+    canvas.flush();
+    snapshot(scene);
+}
+
+// Escenas fijas: mismo dibujo que los benchmarks, en frames determinados
+static void run_snapshots() {
+    if (!getenv("BENCH_SNAPSHOT_DIR") && !golden_dir()) return;
+
+    {
+        // Vuelta completa del anillo: las tres etiquetas pasan por el centro
+        Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+        canvas.setCircularMask(true);
+        if (canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+            bus.fill(0x0000);
+            canvas.fillScreen(0x0000);
+            for (uint32_t frame = 0; frame < 60; frame++) {
+                draw_status(canvas, frame);
+                canvas.flush();
+            }
+            snapshot("status");
+        }
+    }
+
+    panel.fillScreen(0x0000);
+    if (heatmap_init(&panel, HEATMAP_X, HEATMAP_Y)) {
+        float column[N_MFCC];
+        for (int frame = 0; frame < N_FRAMES; frame++) {
+            for (int i = 0; i < N_MFCC; i++) column[i] = sinf(i * 0.3f + frame * 0.1f) * 2.0f;
+            heatmap_push_column(frame, column);
+        }
+        snapshot("heatmap");
+        heatmap_deinit();
+    }
+
+    panel.fillScreen(0x0000);
+    setup_tft_text(true);
+    draw_tft_text(3, false);
+    snapshot("tft_text");
+
+    panel.fillScreen(0x0000);
+    setup_tft_text(false);
+    draw_tft_text(3, false);
+    snapshot("tft_text_transparent");
+
+    {
+        Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+        if (canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+            canvas.fillScreen(0x0000);
+            draw_arcs(canvas, ARC_INT, 37);
+            snapshot_canvas("arc_int", canvas);
+            canvas.fillScreen(0x0000);
+            draw_arcs(canvas, ARC_AA, 37);
+            snapshot_canvas("arc_aa", canvas);
+        }
+    }
+
+    panel.fillScreen(0x0000);
+    for (uint32_t frame = 0; frame < 4; frame++) draw_icon(false, frame * 5);
+    for (uint32_t frame = 0; frame < 4; frame++) draw_icon(true, frame * 5 + 2);
+    snapshot("bitmaps");
+
+    {
+        // Los bitmaps del canvas también respetan la máscara: íconos en las
+        // esquinas (fuera del disco) con cada variante de Arduino_Canvas
+        Arduino_Canvas canvas(LCD_WIDTH, LCD_HEIGHT, &panel);
+        canvas.setCircularMask(true);
+        if (canvas.begin(GFX_SKIP_OUTPUT_BEGIN)) {
+            const int16_t far = LCD_WIDTH - ICON_SIZE / 2;
+            // fillScreen() no toca lo que está fuera del disco
+            memset(canvas.getFramebuffer(), 0, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t));
+            canvas.draw16bitRGBBitmap(-ICON_SIZE / 2, -ICON_SIZE / 2, icon_rgb565, ICON_SIZE, ICON_SIZE);
+            canvas.drawIndexedBitmap(far, -ICON_SIZE / 2, icon_indexed, icon_palette, ICON_SIZE, ICON_SIZE);
+            canvas.draw16bitRGBBitmap(-ICON_SIZE / 2, far, icon_rgb565, icon_palette[0], ICON_SIZE, ICON_SIZE);
+            canvas.drawIndexedBitmap(far, far, icon_indexed, icon_palette, (uint8_t)0, ICON_SIZE, ICON_SIZE);
+            canvas.draw16bitBeRGBBitmap((LCD_WIDTH - ICON_SIZE) / 2, -ICON_SIZE / 2, icon_rgb565, ICON_SIZE, ICON_SIZE);
+            canvas.draw16bitRGBBitmap((LCD_WIDTH - ICON_SIZE) / 2, (LCD_HEIGHT - ICON_SIZE) / 2, icon_rgb565, ICON_SIZE, ICON_SIZE);
+
+            uint32_t outside = 0;
+            const uint16_t* fb = canvas.getFramebuffer();
+            for (int16_t y = 0; y < LCD_HEIGHT; y++) {
+                for (int16_t x = 0; x < LCD_WIDTH; x++) {
+                    if (!canvas.isVisible(x, y) && fb[y * LCD_WIDTH + x]) outside++;
+                }
+            }
+            bench_add_context("bitmaps_round_outside_mask", (double)outside);
+            if (outside) {
+                snapshotFailures++;
+                fprintf(stderr, "[Bench] ERROR: bitmaps_round: %u píxeles fuera de la máscara\n", outside);
+            }
+            snapshot_canvas("bitmaps_round", canvas);
+        }
+    }
+
+    // Animación: frame 0 completo más una vuelta y media de deltas
+    int id = anim_load(gifPath);
+    AnimInfo info;
+    if (anim_get_info(id, info)) {
+        panel.fillScreen(0x0000);
+        anim_play(id, &panel, ANIM_X, ANIM_Y);
+        uint32_t now = millis();
+        for (uint32_t frame = 0; frame < info.frames * 3u / 2u; frame++) {
+            now += 1000;
+            anim_tick(now);
+        }
+        snapshot("anim");
+        anim_unload_all();
+    } else {
+        snapshotFailures++;
+        fprintf(stderr, "[Bench] ERROR: No se pudo cargar %s para el snapshot anim\n", gifPath);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// main
+// -----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    if (!panel.begin()) {
+        fprintf(stderr, "[Bench] ERROR: No se pudo iniciar el panel\n");
+        return 1;
+    }
+
+    bench_add_context("panel", "GC9D01N");
+    bench_add_context("width", (double)LCD_WIDTH);
+    bench_add_context("height", (double)LCD_HEIGHT);
+    bench_add_context("full_frame_bytes", (double)LCD_WIDTH * LCD_HEIGHT * 2);
+    bench_add_context("color_lookup", CANVAS_INDEXED_LINEAR_LOOKUP ? "linear" : "hash");
+
+    const char* envGif = getenv("BENCH_GIF");
+    if (envGif && *envGif) gifPath = envGif;
+    bench_add_context("gif", gifPath);
+
+    init_text_font();
+    init_icon();
+    run_snapshots();
+
+    bench_register("display_full_square", BM_full_square);
+    bench_register("display_full_round", BM_full_round);
+    bench_register("display_status_square", BM_status_square);
+    bench_register("display_status_round", BM_status_round);
+    bench_register("heatmap_column", BM_heatmap_column);
+    bench_register("indexed_fill", BM_indexed_fill);
+    bench_register("indexed_gradient", BM_indexed_gradient);
+    bench_register("indexed_text", BM_indexed_text);
+    bench_register("text_gfxfont", BM_text_gfxfont);
+    bench_register("text_gfxfont_cached", BM_text_gfxfont_cached);
+    bench_register("text_gfxfont_x2", BM_text_gfxfont_x2);
+    bench_register("text_gfxfont_x2_cached", BM_text_gfxfont_x2_cached);
+#if defined(U8G2_FONT_SUPPORT)
+    bench_register("text_u8g2", BM_text_u8g2);
+    bench_register("text_u8g2_cached", BM_text_u8g2_cached);
+#endif
+    bench_register("tft_text_chars", BM_tft_text_chars);
+    bench_register("tft_text", BM_tft_text);
+    bench_register("tft_text_transparent", BM_tft_text_transparent);
+    bench_register("arc_float", BM_arc_float);
+    bench_register("arc_int", BM_arc_int);
+    bench_register("arc_aa", BM_arc_aa);
+    bench_register("bitmap_rgb565", BM_bitmap_rgb565);
+    bench_register("bitmap_indexed", BM_bitmap_indexed);
+    bench_register("anim_decode", BM_anim_decode);
+    bench_register("anim_frame", BM_anim_frame);
+
+    int ret = bench_main(argc, argv);
+    if (snapshotFailures) {
+        fprintf(stderr, "[Bench] ERROR: %u snapshots con error (ver arriba)\n", snapshotFailures);
+        return 1;
+    }
+    return ret;
+}
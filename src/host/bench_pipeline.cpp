@@ -0,0 +1,236 @@
+#include "microbench.h"
+#include "../config.h"
+#include "../audio_capture.h"
+#include "../mfcc_extractor.h"
+#include "../emotion_model.h"
+#include "../ima_adpcm.h"
+#include "../wav_file.h"
+#include "../memory_plan.h"
+#include "../op_profiler.h"
+#include "../kernel_compare.h"
+#include "../esp_nn_kernels.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+
+// =============================================================================
+// Benchmark del pipeline en host (env native)
+// =============================================================================
+// Corre cada etapa sobre data/audio.wav con el mismo código que el firmware
+// (salvo la captura I2S, reemplazada por la lectura del WAV) y los kernels de
+// referencia de TFLite Micro.
+//
+//   pio run -e native
+//   .pio/build/native/program --min-time=2 --out=bench.json
+//
+// El env native-kernels agrega ESP-NN (versiones en C portable): inference
+// usa ESP-NN, inference_reference los kernels de referencia, y el contexto
+// lleva la comparación de salidas y el speedup por op.
+//
+// $BENCH_WAV cambia el WAV (path de LittleFS, relativo a $HOST_FS_ROOT).
+// =============================================================================
+
+static const char* wavPath = "/audio.wav";
+
+// Buffers del mismo plan de memoria que main.cpp. El audio comparte memoria
+// con el scratch del arena: las etapas que lo leen corren antes de inference
+static int16_t* rawAudio = nullptr;       // WAV leído, sin tocar
+static int16_t* audioBuffer = nullptr;    // Ventana normalizada
+static float* mfccBuffer = nullptr;
+static uint8_t adpcmBlock[IMA_ADPCM_BLOCK_BYTES];
+
+// -----------------------------------------------------------------------------
+// Benchmarks
+// -----------------------------------------------------------------------------
+
+static void BM_capture_wav(BenchState& state) {
+    while (state.keepRunning()) {
+        if (wav_read_pcm16(wavPath, rawAudio, AUDIO_SAMPLES) < 0) {
+            state.skipWithError("no se pudo leer el WAV");
+        }
+    }
+}
+
+static void BM_normalize(BenchState& state) {
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        memcpy(audioBuffer, rawAudio, AUDIO_SAMPLES * sizeof(int16_t));
+        state.resumeTiming();
+        audio_normalize(audioBuffer, -1.0f);
+    }
+}
+
+static void BM_stats(BenchState& state) {
+    volatile float sink = 0;
+    while (state.keepRunning()) {
+        sink = audio_get_stats(audioBuffer).rms;
+    }
+    (void)sink;
+}
+
+static void BM_mfcc(BenchState& state) {
+    while (state.keepRunning()) {
+        mfcc_extract(audioBuffer, mfccBuffer);
+    }
+
+    MfccFrameTiming timing = mfcc_get_frame_timing();
+    state.setCounter("frame_avg_us", timing.avg_us);
+    state.setCounter("frame_max_us", timing.max_us);
+}
+
+static void BM_inference(BenchState& state) {
+    while (state.keepRunning()) {
+        if (!model_predict(mfccBuffer).label) {
+            state.skipWithError("modelo no cargado");
+        }
+    }
+    state.setCounter("invoke_us", model_get_last_invoke_us());
+
+    // Tiempo por op del último Invoke() (op00_CONV_2D_us, ...)
+    const OpTimings& ops = op_profiler_last();
+    for (int i = 0; i < ops.count; i++) {
+        char name[40];
+        snprintf(name, sizeof(name), "op%02d_%s_us", i, ops.ops[i].tag ? ops.ops[i].tag : "unknown");
+        state.setCounter(name, ops.ops[i].us);
+    }
+}
+
+#if MODEL_ESP_NN
+// Inferencia con los kernels de referencia; vuelve a ESP-NN al terminar
+static void BM_inference_reference(BenchState& state) {
+    model_set_kernels(KERNELS_REFERENCE);
+    if (!model_load(MODEL_PATH)) state.skipWithError("no se pudo cargar el modelo");
+
+    while (state.keepRunning()) {
+        model_predict(mfccBuffer);
+    }
+    state.setCounter("invoke_us", model_get_last_invoke_us());
+
+    model_set_kernels(KERNELS_ESP_NN);
+    model_load(MODEL_PATH);
+}
+
+// Comparación referencia vs ESP-NN en el contexto del JSON
+static void add_kernel_context() {
+    KernelComparison comparison;
+    if (!kernel_compare_run(MODEL_PATH, mfccBuffer, comparison)) {
+        bench_add_context("kernels_compared", "error");
+        return;
+    }
+
+    const OpTimings& ref = comparison.runs[KERNELS_REFERENCE].ops;
+    const OpTimings& opt = comparison.runs[KERNELS_ESP_NN].ops;
+    bench_add_context("kernels", model_kernels_name(model_get_kernels()));
+    bench_add_context("output_bit_equal", comparison.bit_equal ? "true" : "false");
+    bench_add_context("output_max_abs_diff", comparison.max_abs_diff);
+
+    // Speedup por op (op00_CONV_2D_speedup, ...) sobre una sola corrida
+    int count = ref.count < opt.count ? ref.count : opt.count;
+    for (int i = 0; i < count; i++) {
+        char name[48];
+        snprintf(name, sizeof(name), "op%02d_%s_speedup", i, ref.ops[i].tag ? ref.ops[i].tag : "unknown");
+        bench_add_context(name, opt.ops[i].us > 0 ? (double)ref.ops[i].us / opt.ops[i].us : 0.0);
+    }
+}
+#endif
+
+static void BM_adpcm_encode(BenchState& state) {
+    ImaAdpcmState adpcm;
+    while (state.keepRunning()) {
+        ima_adpcm_reset(adpcm);
+        for (size_t offset = 0; offset < AUDIO_SAMPLES; offset += IMA_ADPCM_SAMPLES_PER_BLOCK) {
+            size_t n = AUDIO_SAMPLES - offset;
+            if (n > IMA_ADPCM_SAMPLES_PER_BLOCK) n = IMA_ADPCM_SAMPLES_PER_BLOCK;
+            ima_adpcm_encode_block(adpcm, audioBuffer + offset, n, adpcmBlock);
+        }
+    }
+}
+
+// Ventana completa: WAV -> normalización -> MFCC -> inferencia
+static void BM_pipeline(BenchState& state) {
+    while (state.keepRunning()) {
+        wav_read_pcm16(wavPath, audioBuffer, AUDIO_SAMPLES);
+        audio_normalize(audioBuffer, -1.0f);
+        mfcc_extract(audioBuffer, mfccBuffer);
+        model_predict(mfccBuffer);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// main
+// -----------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    const char* envWav = getenv("BENCH_WAV");
+    if (envWav && *envWav) wavPath = envWav;
+
+    PipelineBuffers buffers;
+    rawAudio = (int16_t*)heap_caps_aligned_alloc(16, AUDIO_SAMPLES * sizeof(int16_t), MALLOC_CAP_SPIRAM);
+    if (!rawAudio || !memory_plan_pipeline(MODEL_PATH, buffers)) {
+        fprintf(stderr, "[Bench] ERROR: No se pudo alocar buffers\n");
+        return 1;
+    }
+    audioBuffer = buffers.audio;
+    mfccBuffer = buffers.mfcc;
+
+    WavInfo wav;
+    int32_t samples = wav_read_pcm16(wavPath, rawAudio, AUDIO_SAMPLES, &wav);
+    if (samples < 0) return 1;
+    if (wav.sample_rate != SAMPLE_RATE) {
+        fprintf(stderr, "[Bench] WARNING: %s es de %u Hz, el pipeline asume %d Hz\n",
+                wavPath, (unsigned)wav.sample_rate, SAMPLE_RATE);
+    }
+
+    if (!mfcc_init() || !model_load(MODEL_PATH)) return 1;
+
+    // Pasada de referencia: deja mfccBuffer listo para inference y registra
+    // la predicción en el contexto. audioBuffer se restaura después porque
+    // la inferencia lo pisa
+    memcpy(audioBuffer, rawAudio, AUDIO_SAMPLES * sizeof(int16_t));
+    audio_normalize(audioBuffer, -1.0f);
+    mfcc_extract(audioBuffer, mfccBuffer);
+    EmotionResult result = model_predict(mfccBuffer);
+    memcpy(audioBuffer, rawAudio, AUDIO_SAMPLES * sizeof(int16_t));
+    audio_normalize(audioBuffer, -1.0f);
+
+    MemoryPlanSummary plan = memory_plan_summary();
+
+    bench_add_context("wav", wavPath);
+    bench_add_context("wav_samples", (double)samples);
+    bench_add_context("sample_rate", (double)wav.sample_rate);
+    bench_add_context("model", MODEL_PATH);
+    bench_add_context("model_bytes", (double)model_get_size_bytes());
+    bench_add_context("arena_bytes", (double)model_get_arena_size_bytes());
+    bench_add_context("plan_internal_bytes", (double)plan.region_bytes[MEM_INTERNAL]);
+    bench_add_context("plan_psram_bytes", (double)plan.region_bytes[MEM_PSRAM]);
+    bench_add_context("plan_saved_bytes", (double)plan.saved_bytes);
+    bench_add_context("plan_policy", plan.force_psram ? "psram-only" : "size/heat");
+    const PlannedBuffer* scratch = memory_plan_buffer(memory_plan_find("arena_scratch"));
+    bench_add_context("arena_scratch_region", scratch ? memory_plan_region_name(scratch->region) : "?");
+    bench_add_context("emotion", result.label ? result.label : "error");
+    bench_add_context("confidence", result.confidence);
+#if MODEL_ESP_NN
+    // La comparación pisa el audio (comparte memoria con el scratch)
+    add_kernel_context();
+    memcpy(audioBuffer, rawAudio, AUDIO_SAMPLES * sizeof(int16_t));
+    audio_normalize(audioBuffer, -1.0f);
+#endif
+
+    bench_register("capture_wav", BM_capture_wav);
+    bench_register("normalize", BM_normalize);
+    bench_register("stats", BM_stats);
+    bench_register("adpcm_encode", BM_adpcm_encode);
+    bench_register("mfcc", BM_mfcc);
+    bench_register("inference", BM_inference);
+#if MODEL_ESP_NN
+    bench_register("inference_reference", BM_inference_reference);
+#endif
+    bench_register("pipeline", BM_pipeline);
+
+    int rc = bench_main(argc, argv);
+
+    model_unload();
+    mfcc_deinit();
+    memory_plan_reset();
+    heap_caps_free(rawAudio);
+    return rc;
+}
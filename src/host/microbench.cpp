@@ -0,0 +1,289 @@
+#include "microbench.h"
+#include "host_heap.h"
+#include <Arduino.h>
+
+#include <string>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+// =============================================================================
+// Implementación - Microbench
+// =============================================================================
+
+struct BenchEntry {
+    std::string name;
+    BenchFn fn;
+};
+
+struct ContextEntry {
+    std::string key;
+    std::string json;           // Valor ya serializado
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;
+    double realNsPerIter;
+    double cpuNsPerIter;
+    double allocsPerIter;
+    double bytesPerIter;
+    size_t peakHeapBytes;
+    long peakRssKb;
+    const char* error;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+static std::vector<BenchEntry>& registry() {
+    static std::vector<BenchEntry> entries;
+    return entries;
+}
+
+static std::vector<ContextEntry>& context() {
+    static std::vector<ContextEntry> entries;
+    return entries;
+}
+
+static uint64_t clock_ns(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static std::string json_string(const char* s) {
+    std::string out = "\"";
+    for (; *s; s++) {
+        char c = *s;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+static uint64_t total_allocs(const HostHeapStats& s) {
+    return s.caps_allocs + s.new_allocs;
+}
+
+static uint64_t total_alloc_bytes(const HostHeapStats& s) {
+    return s.caps_bytes + s.new_bytes;
+}
+
+// -----------------------------------------------------------------------------
+// BenchState
+// -----------------------------------------------------------------------------
+
+void BenchState::startClocks() {
+    HostHeapStats heap = host_heap_stats();
+    allocsStart_ = total_allocs(heap);
+    bytesStart_ = total_alloc_bytes(heap);
+    realStart_ = clock_ns(CLOCK_MONOTONIC);
+    cpuStart_ = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void BenchState::stopClocks() {
+    realNs_ += clock_ns(CLOCK_MONOTONIC) - realStart_;
+    cpuNs_ += clock_ns(CLOCK_THREAD_CPUTIME_ID) - cpuStart_;
+    HostHeapStats heap = host_heap_stats();
+    allocs_ += total_allocs(heap) - allocsStart_;
+    bytes_ += total_alloc_bytes(heap) - bytesStart_;
+}
+
+bool BenchState::keepRunning() {
+    if (error_) return false;
+
+    if (!started_) {
+        started_ = true;
+        startClocks();
+        return true;
+    }
+
+    iterations_++;
+    if (paused_) resumeTiming();
+
+    // Mide hasta acá sin cortar el reloj para decidir si seguir
+    uint64_t elapsed = realNs_ + (clock_ns(CLOCK_MONOTONIC) - realStart_);
+    if (elapsed >= minTimeNs_ || iterations_ >= maxIterations_) {
+        stopClocks();
+        return false;
+    }
+    return true;
+}
+
+void BenchState::pauseTiming() {
+    if (paused_ || !started_) return;
+    stopClocks();
+    paused_ = true;
+}
+
+void BenchState::resumeTiming() {
+    if (!paused_) return;
+    paused_ = false;
+    startClocks();
+}
+
+void BenchState::skipWithError(const char* message) {
+    error_ = message;
+}
+
+void BenchState::setCounter(const char* name, double value) {
+    for (auto& c : counters_) {
+        if (c.first == name) {
+            c.second = value;
+            return;
+        }
+    }
+    counters_.push_back({name, value});
+}
+
+// -----------------------------------------------------------------------------
+// Runner
+// -----------------------------------------------------------------------------
+
+struct BenchRunner {
+    static BenchResult run(const BenchEntry& entry, double minTimeS) {
+        BenchState state;
+        state.minTimeNs_ = minTimeS * 1e9;
+        state.maxIterations_ = 1000000000ull;
+
+        host_heap_reset_peak();
+        Serial.setMuted(true);
+        entry.fn(state);
+        Serial.setMuted(false);
+
+        BenchResult result;
+        result.name = entry.name;
+        result.iterations = state.iterations_;
+        result.error = state.error_;
+        double n = state.iterations_ ? (double)state.iterations_ : 1.0;
+        result.realNsPerIter = state.realNs_ / n;
+        result.cpuNsPerIter = state.cpuNs_ / n;
+        result.allocsPerIter = state.allocs_ / n;
+        result.bytesPerIter = state.bytes_ / n;
+        result.peakHeapBytes = host_heap_stats().peak_live_bytes;
+        result.peakRssKb = bench_peak_rss_kb();
+        result.counters = state.counters_;
+        return result;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+void bench_register(const char* name, BenchFn fn) {
+    registry().push_back({name, fn});
+}
+
+void bench_add_context(const char* key, const char* value) {
+    context().push_back({key, json_string(value)});
+}
+
+void bench_add_context(const char* key, double value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", value);
+    context().push_back({key, buf});
+}
+
+long bench_peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;     // Linux: KB
+}
+
+int bench_main(int argc, char** argv) {
+    double minTime = 1.0;
+    const char* filter = nullptr;
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--min-time=", 11) == 0) {
+            minTime = atof(argv[i] + 11);
+        } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else if (strncmp(argv[i], "--out=", 6) == 0) {
+            outPath = argv[i] + 6;
+        } else {
+            fprintf(stderr, "Uso: %s [--min-time=S] [--filter=TXT] [--out=PATH]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const BenchEntry& entry : registry()) {
+        if (filter && entry.name.find(filter) == std::string::npos) continue;
+        fprintf(stderr, "[Bench] %s...\n", entry.name.c_str());
+        results.push_back(BenchRunner::run(entry, minTime));
+        const BenchResult& r = results.back();
+        fprintf(stderr, "[Bench] %-16s %12.0f ns/op  %8llu it  %6.1f allocs/op\n",
+                r.name.c_str(), r.realNsPerIter, (unsigned long long)r.iterations,
+                r.allocsPerIter);
+    }
+
+    FILE* out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "[Bench] ERROR: No se pudo abrir %s\n", outPath);
+        return 1;
+    }
+
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+    char host[64] = "";
+    gethostname(host, sizeof(host) - 1);
+
+    fprintf(out, "{\n  \"context\": {\n");
+    fprintf(out, "    \"date\": %s,\n", json_string(date).c_str());
+    fprintf(out, "    \"host_name\": %s,\n", json_string(host).c_str());
+    fprintf(out, "    \"executable\": %s,\n", json_string(argv[0]).c_str());
+    fprintf(out, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+#ifdef NDEBUG
+    fprintf(out, "    \"library_build_type\": \"release\",\n");
+#else
+    fprintf(out, "    \"library_build_type\": \"debug\",\n");
+#endif
+    for (const ContextEntry& c : context()) {
+        fprintf(out, "    %s: %s,\n", json_string(c.key.c_str()).c_str(), c.json.c_str());
+    }
+    fprintf(out, "    \"peak_rss_kb\": %ld\n  },\n", bench_peak_rss_kb());
+
+    fprintf(out, "  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(out, "%s\n    {\n", i ? "," : "");
+        fprintf(out, "      \"name\": %s,\n", json_string(r.name.c_str()).c_str());
+        fprintf(out, "      \"run_name\": %s,\n", json_string(r.name.c_str()).c_str());
+        fprintf(out, "      \"run_type\": \"iteration\",\n");
+        fprintf(out, "      \"iterations\": %llu,\n", (unsigned long long)r.iterations);
+        fprintf(out, "      \"real_time\": %.1f,\n", r.realNsPerIter);
+        fprintf(out, "      \"cpu_time\": %.1f,\n", r.cpuNsPerIter);
+        fprintf(out, "      \"time_unit\": \"ns\",\n");
+        fprintf(out, "      \"allocs_per_iter\": %.2f,\n", r.allocsPerIter);
+        fprintf(out, "      \"alloc_bytes_per_iter\": %.1f,\n", r.bytesPerIter);
+        fprintf(out, "      \"peak_heap_bytes\": %zu,\n", r.peakHeapBytes);
+        for (const auto& c : r.counters) {
+            fprintf(out, "      %s: %.6g,\n", json_string(c.first.c_str()).c_str(), c.second);
+        }
+        if (r.error) {
+            fprintf(out, "      \"error_occurred\": true,\n");
+            fprintf(out, "      \"error_message\": %s,\n", json_string(r.error).c_str());
+        }
+        fprintf(out, "      \"peak_rss_kb\": %ld\n    }", r.peakRssKb);
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (outPath) fclose(out);
+
+    for (const BenchResult& r : results) {
+        if (r.error) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// Microbench - Harness mínimo estilo google-benchmark (solo env native)
+// =============================================================================
+// Cada benchmark corre hasta acumular --min-time segundos medidos y reporta
+// ns/op (real y CPU del hilo), alocaciones por iteración (heap_caps + new),
+// pico de heap emulado y pico de RSS del proceso. La salida JSON usa los
+// mismos campos que google-benchmark (--benchmark_format=json) para poder
+// compararla con sus herramientas.
+//
+//   static void BM_algo(BenchState& state) {
+//       while (state.keepRunning()) { ... }
+//   }
+//   bench_register("algo", BM_algo);
+//   return bench_main(argc, argv);
+// =============================================================================
+
+class BenchState {
+public:
+    // true mientras haya que seguir iterando
+    bool keepRunning();
+
+    // Excluye de la medición (tiempo y alocaciones) la preparación de cada
+    // iteración, p.ej. restaurar un buffer
+    void pauseTiming();
+    void resumeTiming();
+
+    // Marca el benchmark como fallido (se reporta con "error_message")
+    void skipWithError(const char* message);
+
+    uint64_t iterations() const { return iterations_; }
+
+    // Contador propio del benchmark; sale como campo extra del resultado,
+    // igual que los user counters de google-benchmark. Repetir el nombre
+    // reemplaza el valor
+    void setCounter(const char* name, double value);
+
+private:
+    friend struct BenchRunner;
+
+    double minTimeNs_ = 0;
+    uint64_t maxIterations_ = 0;
+    uint64_t iterations_ = 0;
+    bool started_ = false;
+    bool paused_ = false;
+    const char* error_ = nullptr;
+    std::vector<std::pair<std::string, double>> counters_;
+
+    uint64_t realStart_ = 0, cpuStart_ = 0;
+    uint64_t realNs_ = 0, cpuNs_ = 0;
+    uint64_t allocsStart_ = 0, bytesStart_ = 0;
+    uint64_t allocs_ = 0, bytes_ = 0;
+
+    void startClocks();
+    void stopClocks();
+};
+
+typedef void (*BenchFn)(BenchState& state);
+
+// Registra un benchmark (se ejecutan en orden de registro)
+void bench_register(const char* name, BenchFn fn);
+
+// Agrega un par clave/valor a "context" en el JSON
+void bench_add_context(const char* key, const char* value);
+void bench_add_context(const char* key, double value);
+
+// Parsea argumentos, corre los benchmarks e imprime el JSON
+//   --min-time=S   segundos medidos por benchmark (default 1.0)
+//   --filter=TXT   solo benchmarks cuyo nombre contiene TXT
+//   --out=PATH     escribe el JSON en PATH en vez de stdout
+// Retorna el código de salida del proceso
+int bench_main(int argc, char** argv);
+
+// Pico de RSS del proceso en KB
+long bench_peak_rss_kb();
+
+#endif // MICROBENCH_H
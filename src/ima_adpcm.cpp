@@ -0,0 +1,115 @@
+#include "ima_adpcm.h"
+
+// =============================================================================
+// Implementación - IMA-ADPCM
+// =============================================================================
+
+static const int16_t STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+
+static const int8_t INDEX_TABLE[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static inline int32_t clamp(int32_t value, int32_t lo, int32_t hi) {
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+// Aplica un nibble al predictor (común a encoder y decoder)
+static inline void apply_nibble(ImaAdpcmState& state, uint8_t nibble) {
+    int32_t step = STEP_TABLE[state.step_index];
+    int32_t diff = step >> 3;
+    if (nibble & 4) diff += step;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 1) diff += step >> 2;
+
+    state.predictor += (nibble & 8) ? -diff : diff;
+    state.predictor = clamp(state.predictor, -32768, 32767);
+    state.step_index = clamp(state.step_index + INDEX_TABLE[nibble], 0, 88);
+}
+
+static inline uint8_t encode_sample(ImaAdpcmState& state, int32_t sample) {
+    int32_t step = STEP_TABLE[state.step_index];
+    int32_t diff = sample - state.predictor;
+
+    uint8_t nibble = 0;
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+    if (diff >= step) {
+        nibble |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        nibble |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        nibble |= 1;
+    }
+
+    apply_nibble(state, nibble);
+    return nibble;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+void ima_adpcm_reset(ImaAdpcmState& state) {
+    state.predictor = 0;
+    state.step_index = 0;
+}
+
+void ima_adpcm_encode_block(ImaAdpcmState& state, const int16_t* in, size_t count, uint8_t* out) {
+    if (count > IMA_ADPCM_SAMPLES_PER_BLOCK) count = IMA_ADPCM_SAMPLES_PER_BLOCK;
+    int16_t last = count > 0 ? in[count - 1] : 0;
+
+    // La primera muestra va sin comprimir en el header
+    state.predictor = count > 0 ? in[0] : 0;
+    out[0] = state.predictor & 0xFF;
+    out[1] = (state.predictor >> 8) & 0xFF;
+    out[2] = (uint8_t)state.step_index;
+    out[3] = 0;
+
+    uint8_t* data = out + IMA_ADPCM_HEADER_BYTES;
+    for (size_t i = 1; i < IMA_ADPCM_SAMPLES_PER_BLOCK; i += 2) {
+        int16_t s0 = i < count ? in[i] : last;
+        int16_t s1 = i + 1 < count ? in[i + 1] : last;
+        uint8_t lo = encode_sample(state, s0);
+        uint8_t hi = encode_sample(state, s1);
+        *data++ = lo | (hi << 4);
+    }
+}
+
+void ima_adpcm_decode_block(const uint8_t* in, int16_t* out) {
+    ImaAdpcmState state;
+    state.predictor = (int16_t)(in[0] | (in[1] << 8));
+    state.step_index = clamp(in[2], 0, 88);
+
+    *out++ = (int16_t)state.predictor;
+
+    const uint8_t* data = in + IMA_ADPCM_HEADER_BYTES;
+    for (size_t i = 1; i < IMA_ADPCM_SAMPLES_PER_BLOCK; i += 2) {
+        uint8_t byte = *data++;
+        apply_nibble(state, byte & 0x0F);
+        *out++ = (int16_t)state.predictor;
+        apply_nibble(state, byte >> 4);
+        *out++ = (int16_t)state.predictor;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef IMA_ADPCM_H
+#define IMA_ADPCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// IMA-ADPCM - Codec 4:1 por bloques (mono, 16 bits)
+// =============================================================================
+// Formato de bloque compatible con WAV IMA-ADPCM (formato 0x11):
+//   int16 primera muestra | uint8 step index | uint8 reservado | nibbles
+// Los nibbles van de a dos por byte, primero el nibble bajo. Cada bloque es
+// independiente: se puede decodificar sin los anteriores.
+// =============================================================================
+
+constexpr size_t IMA_ADPCM_BLOCK_BYTES = 512;
+constexpr size_t IMA_ADPCM_HEADER_BYTES = 4;
+constexpr size_t IMA_ADPCM_SAMPLES_PER_BLOCK = (IMA_ADPCM_BLOCK_BYTES - IMA_ADPCM_HEADER_BYTES) * 2 + 1;  // 1017
+
+// Estado del codificador (se arrastra entre bloques para no resetear el step)
+struct ImaAdpcmState {
+    int32_t predictor;
+    int32_t step_index;
+};
+
+// Inicializa el estado
+void ima_adpcm_reset(ImaAdpcmState& state);
+
+// Codifica hasta IMA_ADPCM_SAMPLES_PER_BLOCK muestras en un bloque completo
+// Si count es menor, el resto del bloque se rellena con la última muestra
+// out debe tener IMA_ADPCM_BLOCK_BYTES bytes
+void ima_adpcm_encode_block(ImaAdpcmState& state, const int16_t* in, size_t count, uint8_t* out);
+
+// Decodifica un bloque completo en IMA_ADPCM_SAMPLES_PER_BLOCK muestras
+void ima_adpcm_decode_block(const uint8_t* in, int16_t* out);
+
+// Cantidad de bloques necesarios para count muestras
+inline size_t ima_adpcm_blocks_for(size_t count) {
+    return (count + IMA_ADPCM_SAMPLES_PER_BLOCK - 1) / IMA_ADPCM_SAMPLES_PER_BLOCK;
+}
+
+#endif // IMA_ADPCM_H
@@ -0,0 +1,89 @@
+#include "kernel_compare.h"
+#include "config.h"
+#include <Arduino.h>
+#include <math.h>
+#include <string.h>
+
+// =============================================================================
+// Implementación - Comparación de kernels
+// =============================================================================
+
+static bool run_with_kernels(const char* model_path, ModelKernels kernels,
+                             const float* mfcc, KernelRun& run) {
+    run = {};
+    if (!model_set_kernels(kernels) || !model_load(model_path)) return false;
+
+    run.result = model_predict(mfcc);
+    run.ok = strcmp(run.result.label, "error") != 0;
+    run.ops = op_profiler_last();
+    return run.ok;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+bool kernel_compare_run(const char* model_path, const float* mfcc, KernelComparison& comparison) {
+    comparison = {};
+    if (!model_kernels_available(KERNELS_ESP_NN)) {
+        Serial.println("[Kernels] ESP-NN no compilado (env t-circle-s3-RV-espnn)");
+        return false;
+    }
+
+    ModelKernels previous = model_get_kernels();
+
+    bool ok = true;
+    for (int k = 0; k < KERNELS_COUNT; k++) {
+        ok = run_with_kernels(model_path, (ModelKernels)k, mfcc, comparison.runs[k]) && ok;
+    }
+
+    // Volver a los kernels de antes
+    model_set_kernels(previous);
+    if (!model_load(model_path)) ok = false;
+
+    if (!ok) {
+        Serial.println("[Kernels] ERROR: Falló alguna de las corridas");
+        return false;
+    }
+
+    const EmotionResult& ref = comparison.runs[KERNELS_REFERENCE].result;
+    const EmotionResult& opt = comparison.runs[KERNELS_ESP_NN].result;
+    comparison.bit_equal = memcmp(ref.probabilities, opt.probabilities, sizeof(ref.probabilities)) == 0;
+    for (int i = 0; i < NUM_EMOTIONS; i++) {
+        float diff = fabsf(ref.probabilities[i] - opt.probabilities[i]);
+        if (diff > comparison.max_abs_diff) comparison.max_abs_diff = diff;
+    }
+    comparison.ok = true;
+    return true;
+}
+
+void kernel_compare_print(const KernelComparison& comparison, Print& out) {
+    if (!comparison.ok) {
+        out.println("[Kernels] Sin comparación");
+        return;
+    }
+
+    const KernelRun& ref = comparison.runs[KERNELS_REFERENCE];
+    const KernelRun& opt = comparison.runs[KERNELS_ESP_NN];
+
+    out.println("\n=== KERNELS: REFERENCIA vs ESP-NN ===");
+    out.printf("  Referencia: %s (%.3f)\n", ref.result.label, ref.result.confidence);
+    out.printf("  ESP-NN:     %s (%.3f)\n", opt.result.label, opt.result.confidence);
+    out.printf("  Salida idéntica: %s (máx. diferencia %.6f)\n",
+               comparison.bit_equal ? "SI" : "NO", comparison.max_abs_diff);
+
+    // Los dos grafos tienen los mismos ops en el mismo orden
+    int count = ref.ops.count < opt.ops.count ? ref.ops.count : opt.ops.count;
+    out.println("   #  Op                 Referencia     ESP-NN  Speedup");
+    for (int i = 0; i < count; i++) {
+        uint32_t refUs = ref.ops.ops[i].us;
+        uint32_t optUs = opt.ops.ops[i].us;
+        out.printf("  %2d  %-18s %8u us %8u us  %5.2fx\n",
+                   i, ref.ops.ops[i].tag ? ref.ops.ops[i].tag : "?",
+                   refUs, optUs, optUs > 0 ? (float)refUs / optUs : 0.0f);
+    }
+    out.printf("  Total ops          %8u us %8u us  %5.2fx\n",
+               ref.ops.invoke_us, opt.ops.invoke_us,
+               opt.ops.invoke_us > 0 ? (float)ref.ops.invoke_us / opt.ops.invoke_us : 0.0f);
+    out.println("=====================================\n");
+}
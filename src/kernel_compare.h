@@ -0,0 +1,46 @@
+#ifndef KERNEL_COMPARE_H
+#define KERNEL_COMPARE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "emotion_model.h"
+#include "op_profiler.h"
+
+class Print;
+
+// =============================================================================
+// Comparación de kernels - Referencia vs ESP-NN sobre los mismos MFCCs
+// =============================================================================
+// Recarga el modelo con cada juego de kernels, corre una inferencia con la
+// misma entrada y guarda la salida y los tiempos por op. Ambos juegos hacen
+// la misma aritmética entera, así que la salida debería ser idéntica bit a
+// bit; cualquier diferencia indica un kernel mal envuelto.
+//
+// Al terminar recarga el modelo con los kernels que estaban activos. Usa el
+// scratch del arena, así que pisa los buffers que lo comparten (el audio).
+//
+// Dispositivo: comando 'n' sobre los últimos MFCCs.
+// Host: contexto del benchmark del env native-kernels.
+// =============================================================================
+
+struct KernelRun {
+    bool ok;
+    EmotionResult result;
+    OpTimings ops;
+};
+
+struct KernelComparison {
+    bool ok;                    // Ambas corridas terminaron
+    bool bit_equal;             // Probabilidades idénticas bit a bit
+    float max_abs_diff;         // Máxima diferencia entre probabilidades
+    KernelRun runs[KERNELS_COUNT];
+};
+
+// Corre la comparación sobre mfcc (N_MFCC * N_FRAMES floats)
+// Retorna false si ESP-NN no está compilado o alguna carga/inferencia falló
+bool kernel_compare_run(const char* model_path, const float* mfcc, KernelComparison& comparison);
+
+// Resultado y tiempo por op de ambos juegos, con el speedup de cada op
+void kernel_compare_print(const KernelComparison& comparison, Print& out);
+
+#endif // KERNEL_COMPARE_H
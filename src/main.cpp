@@ -5,17 +5,33 @@
 #include "mfcc_extractor.h"
 #include "emotion_model.h"
 #include "profiler.h"
+#include "export_link.h"
+#include "recorder.h"
+#include "batch.h"
+#include "memory_plan.h"
+#include "kernel_compare.h"
+#include "model_swap.h"
+#if DISPLAY_HEATMAP
+#include "display.h"
+#include "mfcc_heatmap.h"
+#endif
+#if DISPLAY_ANIMATIONS
+#include "display.h"
+#include "animation.h"
+#endif
 
 // =============================================================================
 // MoodLink - Test 5.3: Pipeline con Profiling y CSV
 // =============================================================================
 // Pipeline de reconocimiento de emociones con métricas de memoria y tiempo.
 // Los datos se guardan en /profiling.csv para exportar y analizar.
+// El nivel de detalle se elige con PROFILE_LEVEL (ver profiler.h).
 // =============================================================================
 
 #define CSV_FILENAME "/profiling.csv"
 
-// Buffers del pipeline (alocados en PSRAM)
+// Buffers del pipeline (del planner de memoria, ver memory_plan.h)
+static PipelineBuffers pipeline_buffers;
 static int16_t* audio_buffer = nullptr;
 static float* mfcc_buffer = nullptr;
 
@@ -25,6 +41,12 @@ static uint32_t iteration_count = 0;
 // Perfil de memoria de inicialización
 static InitMemoryProfile init_memory;
 
+#if DISPLAY_ANIMATIONS
+// Animaciones cargadas (-1 si no hay GIF)
+static int anim_idle = -1;
+static int anim_listen = -1;
+#endif
+
 // -----------------------------------------------------------------------------
 // Prototipos
 // -----------------------------------------------------------------------------
@@ -42,15 +64,13 @@ static uint32_t get_psram_free_kb() {
     return heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024;
 }
 
-static uint32_t get_psram_total_kb() {
-    return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / 1024;
-}
-
 static uint32_t get_dram_free_kb() {
     return heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024;
 }
 
+// Tabla por iteración: solo con PROFILE_FULL (en producción no hay Serial por ventana)
 static void print_result(const EmotionResult& result) {
+#if PROFILE_LEVEL >= PROFILE_FULL
     Serial.println("\n  Emocion      | Probabilidad");
     Serial.println("  -------------|-------------");
 
@@ -63,6 +83,9 @@ static void print_result(const EmotionResult& result) {
     }
 
     Serial.printf("\n  >> %s (%.1f%%)\n", result.label, result.confidence * 100);
+#else
+    (void)result;
+#endif
 }
 
 // -----------------------------------------------------------------------------
@@ -70,43 +93,46 @@ static void print_result(const EmotionResult& result) {
 // -----------------------------------------------------------------------------
 
 void setup() {
+    export_prepare_serial();
     Serial.begin(115200);
     delay(2000);
 
     print_separator();
     Serial.println("MoodLink - Test 5.3: Pipeline con Profiling");
     Serial.printf("Version: %s\n", VERSION);
+    Serial.printf("Profile level: %d\n", PROFILE_LEVEL);
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
     Serial.printf("CSV Output: %s\n", CSV_FILENAME);
+#endif
     print_separator();
 
     // Guardar PSRAM inicial
     init_memory.psram_initial_kb = get_psram_free_kb();
-    Serial.printf("\n[MEMORIA] PSRAM inicial: %u KB\n", init_memory.psram_initial_kb);
+    init_memory.dram_initial_kb = get_dram_free_kb();
+    Serial.printf("\n[MEMORIA] PSRAM inicial: %u KB  |  DRAM inicial: %u KB\n",
+                  init_memory.psram_initial_kb, init_memory.dram_initial_kb);
 
     // -------------------------------------------------------------------------
-    // 1. Alocar buffers del pipeline
+    // 1. Planificar y alocar la memoria de todo el pipeline
     // -------------------------------------------------------------------------
-    Serial.println("\n[1/5] Alocando buffers...");
+    Serial.println("\n[1/5] Planificando memoria...");
 
     size_t audio_size = AUDIO_SAMPLES * sizeof(int16_t);
     size_t mfcc_size = N_MFCC * N_FRAMES * sizeof(float);
 
-    audio_buffer = (int16_t*)heap_caps_aligned_alloc(
-        16, audio_size, MALLOC_CAP_SPIRAM);
-
-    mfcc_buffer = (float*)heap_caps_aligned_alloc(
-        16, mfcc_size, MALLOC_CAP_SPIRAM);
-
-    if (!audio_buffer || !mfcc_buffer) {
-        Serial.println("ERROR: No se pudieron alocar buffers");
+    if (!memory_plan_pipeline(MODEL_PATH, pipeline_buffers)) {
+        Serial.println("ERROR: No se pudo planificar la memoria");
         while (1) delay(1000);
     }
+    audio_buffer = pipeline_buffers.audio;
+    mfcc_buffer = pipeline_buffers.mfcc;
 
     init_memory.audio_buffer_kb = audio_size / 1024.0f;
     init_memory.mfcc_buffer_kb = mfcc_size / 1024.0f;
 
     Serial.printf("  audio_buffer: %.1f KB\n", init_memory.audio_buffer_kb);
     Serial.printf("  mfcc_buffer:  %.1f KB\n", init_memory.mfcc_buffer_kb);
+    memory_plan_print(Serial);
 
     // -------------------------------------------------------------------------
     // 2. Inicializar módulos
@@ -117,6 +143,9 @@ void setup() {
         while (1) delay(1000);
     }
 
+    // No es fatal: sin LittleFS solo se pierde la grabación opcional
+    recorder_init();
+
     Serial.println("\n[3/5] Inicializando MFCC...");
     if (!mfcc_init()) {
         Serial.println("ERROR: Fallo mfcc_init()");
@@ -125,23 +154,53 @@ void setup() {
     init_memory.mfcc_internal_kb = mfcc_get_internal_memory_bytes() / 1024.0f;
     Serial.printf("  MFCC internal: %.1f KB\n", init_memory.mfcc_internal_kb);
 
+#if DISPLAY_HEATMAP
+    // No es fatal: sin pantalla el pipeline sigue igual
+    if (display_init() && heatmap_init(display_get(), HEATMAP_X, HEATMAP_Y)) {
+        mfcc_set_column_callback(heatmap_push_column);
+    }
+#endif
+
+#if DISPLAY_ANIMATIONS
+    // Se decodifican ahora para que la captura no toque LittleFS ni el LZW
+    if (display_init()) {
+        anim_idle = anim_load(ANIM_IDLE_PATH);
+        anim_listen = anim_load(ANIM_LISTEN_PATH);
+        audio_set_poll_callback(anim_tick);
+    }
+#endif
+
     Serial.println("\n[4/5] Cargando modelo...");
     if (!model_load(MODEL_PATH)) {
         Serial.println("ERROR: Fallo model_load()");
         while (1) delay(1000);
     }
-    init_memory.model_buffer_kb = model_get_size_bytes() / 1024.0f;
+    // El modelo embebido está en flash, no ocupa RAM
+    init_memory.model_buffer_kb = model_is_embedded() ? 0.0f : model_get_size_bytes() / 1024.0f;
     init_memory.tensor_arena_kb = model_get_arena_size_bytes() / 1024.0f;
     Serial.printf("  Model: %.1f KB  |  Arena: %.1f KB\n",
                   init_memory.model_buffer_kb, init_memory.tensor_arena_kb);
 
     // Calcular memoria total
     init_memory.psram_after_init_kb = get_psram_free_kb();
-    init_memory.total_allocated_kb = init_memory.psram_initial_kb - init_memory.psram_after_init_kb;
+    init_memory.dram_after_init_kb = get_dram_free_kb();
+    init_memory.total_allocated_kb = (init_memory.psram_initial_kb - init_memory.psram_after_init_kb) +
+                                     (init_memory.dram_initial_kb - init_memory.dram_after_init_kb);
+    init_memory.psram_min_free_kb = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM) / 1024;
+    init_memory.dram_min_free_kb = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL) / 1024;
+
+    MemoryPlanSummary plan = memory_plan_summary();
+    init_memory.plan_internal_kb = plan.region_bytes[MEM_INTERNAL] / 1024.0f;
+    init_memory.plan_psram_kb = plan.region_bytes[MEM_PSRAM] / 1024.0f;
+    init_memory.plan_declared_kb = plan.declared_bytes / 1024.0f;
+    init_memory.plan_saved_kb = plan.saved_bytes / 1024.0f;
+    init_memory.plan_demoted = plan.demoted;
+    init_memory.plan_force_psram = plan.force_psram;
 
     // -------------------------------------------------------------------------
     // 5. Inicializar profiler
     // -------------------------------------------------------------------------
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
     Serial.println("\n[5/5] Inicializando profiler...");
     if (!profiler_init(CSV_FILENAME)) {
         Serial.println("ERROR: Fallo profiler_init()");
@@ -150,10 +209,17 @@ void setup() {
 
     // Guardar y mostrar perfil de memoria inicial
     profiler_log_init_memory(init_memory);
+#if PROFILE_LEVEL >= PROFILE_FULL
     profiler_print_init_memory(init_memory);
+#endif
+#else
+    Serial.println("\n[5/5] Profiler deshabilitado (PROFILE_LEVEL=0)");
+#endif
 
     Serial.println("\n========== SISTEMA LISTO ==========");
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
     Serial.printf("Iteraciones previas en CSV: %d\n", profiler_get_row_count());
+#endif
     print_help();
 }
 
@@ -163,9 +229,21 @@ void setup() {
 
 static void print_help() {
     Serial.println("\n=== COMANDOS DISPONIBLES ===");
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
     Serial.println("  d, dump   - Exportar CSV al Serial");
     Serial.println("  r, reset  - Borrar CSV y empezar de nuevo");
     Serial.println("  c, count  - Mostrar cantidad de iteraciones");
+#endif
+    Serial.println("  w, wav    - Exportar último audio (binario, ver tools/export_receiver.py)");
+    Serial.println("  f, feat   - Exportar últimos MFCCs (binario)");
+    Serial.println("  x, export - Exportar CSVs de métricas (binario)");
+    Serial.println("  e, every  - Exportar audio crudo y MFCCs en cada iteración");
+    Serial.println("  g, grabar - Grabar cada ventana en LittleFS (IMA-ADPCM)");
+    Serial.println("  k, bench  - Benchmark del encoder IMA-ADPCM con el último audio");
+    Serial.println("  b, batch  - Procesar los WAV de /batch (accuracy y throughput)");
+    Serial.println("  n, nn     - Comparar kernels de referencia y ESP-NN con los últimos MFCCs");
+    Serial.println("  m [path]  - Cambiar de modelo (sin path: listar los .tflite)");
+    Serial.println("  a [path]  - A/B entre el modelo actual y path (sin path: terminar)");
     Serial.println("  s, skip   - Saltar espera e iniciar grabación");
     Serial.println("  h, help   - Mostrar esta ayuda");
     Serial.println("  p, pause  - Pausar/reanudar el loop");
@@ -173,12 +251,38 @@ static void print_help() {
 }
 
 static bool paused = false;
+static bool export_every_iteration = false;
+
+// Argumento de un comando: el resto de la línea, sin espacios alrededor
+static void read_command_arg(char* arg, size_t size) {
+    size_t len = 0;
+    unsigned long start = millis();
+    while (millis() - start < 500) {
+        if (!Serial.available()) {
+            delay(1);
+            continue;
+        }
+        char c = Serial.read();
+        if (c == '\n' || c == '\r') break;
+        if (len == 0 && c == ' ') continue;
+        if (len < size - 1) arg[len++] = c;
+    }
+    while (len > 0 && arg[len - 1] == ' ') len--;
+    arg[len] = '\0';
+}
+
+// Los buffers del pipeline cambian al rehacer el plan
+static void update_pipeline_pointers() {
+    audio_buffer = pipeline_buffers.audio;
+    mfcc_buffer = pipeline_buffers.mfcc;
+}
 
 static void handle_serial_commands() {
     while (Serial.available()) {
         char cmd = Serial.read();
 
         switch (cmd) {
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
             case 'd':
                 profiler_dump_csv();
                 break;
@@ -189,6 +293,77 @@ static void handle_serial_commands() {
             case 'c':
                 Serial.printf("[Profiler] Iteraciones en CSV: %d\n", profiler_get_row_count());
                 break;
+#endif
+            case 'w':
+                // Con aliasing el audio se pisa durante la inferencia
+                if (memory_plan_is_shared(pipeline_buffers.audio_handle)) {
+                    Serial.println("[Export] El buffer de audio se reutiliza en la inferencia; usar 'e'");
+                } else {
+                    export_audio(audio_buffer, AUDIO_SAMPLES, iteration_count);
+                }
+                break;
+            case 'f':
+                export_mfcc(mfcc_buffer, iteration_count);
+                break;
+            case 'x':
+                export_file(CSV_FILENAME);
+                export_file(TASKS_CSV_FILENAME);
+                export_file(OPS_CSV_FILENAME);
+                export_file(AB_CSV_FILENAME);
+                export_file(BATCH_RESULTS_FILENAME);
+                recorder_for_each_file([](const char* path) { export_file(path); });
+                break;
+            case 'g':
+                recorder_set_enabled(!recorder_is_enabled());
+                Serial.printf("[Recorder] Grabación: %s\n", recorder_is_enabled() ? "SI" : "NO");
+                break;
+            case 'k':
+                // Igual que 'w': con aliasing el audio se pisa durante la inferencia
+                if (memory_plan_is_shared(pipeline_buffers.audio_handle)) {
+                    Serial.println("[Recorder] El buffer de audio se reutiliza en la inferencia; no hay ventana para medir");
+                } else {
+                    recorder_benchmark(audio_buffer, AUDIO_SAMPLES);
+                }
+                break;
+            case 'b':
+                batch_run_dir(BATCH_DIR, audio_buffer, mfcc_buffer);
+                break;
+            case 'n': {
+                KernelComparison comparison;
+                if (kernel_compare_run(model_get_path(), mfcc_buffer, comparison)) {
+                    kernel_compare_print(comparison, Serial);
+                }
+                break;
+            }
+            case 'm': {
+                char path[48];
+                read_command_arg(path, sizeof(path));
+                if (!path[0]) {
+                    model_list_files(Serial);
+                } else if (model_ab_is_active()) {
+                    Serial.println("[Model] Terminar el A/B primero ('a' sin path)");
+                } else {
+                    model_swap(path, pipeline_buffers);
+                    update_pipeline_pointers();
+                }
+                break;
+            }
+            case 'a': {
+                char path[48];
+                read_command_arg(path, sizeof(path));
+                if (path[0]) {
+                    model_ab_start(path, pipeline_buffers);
+                } else {
+                    model_ab_stop(pipeline_buffers);
+                }
+                update_pipeline_pointers();
+                break;
+            }
+            case 'e':
+                export_every_iteration = !export_every_iteration;
+                Serial.printf("[Export] Exportar cada iteración: %s\n",
+                              export_every_iteration ? "SI" : "NO");
+                break;
             case 'h':
                 print_help();
                 break;
@@ -228,9 +403,16 @@ void loop() {
 
     Serial.printf("\n*** Iteración #%u - Preparate para hablar (3 seg, 's' para saltar) ***\n", iteration_count);
 
+#if DISPLAY_ANIMATIONS
+    anim_play(anim_idle, display_get(), ANIM_X, ANIM_Y);
+#endif
+
     // Espera con opción de saltar
-    for (int i = 0; i < 30; i++) {  // 30 * 100ms = 3 segundos
-        delay(100);
+    for (int i = 0; i < 300; i++) {  // 300 * 10ms = 3 segundos
+        delay(10);
+#if DISPLAY_ANIMATIONS
+        anim_tick(millis());
+#endif
         if (Serial.available() && Serial.peek() == 's') {
             Serial.read();  // Consumir el 's'
             Serial.println("[!] Saltando espera...");
@@ -239,84 +421,134 @@ void loop() {
     }
 
     // Estructura para métricas de esta iteración
-    PipelineMetrics metrics = {0};
-    metrics.iteration = iteration_count;
-    metrics.timestamp_ms = millis();
-
-    // Memoria al inicio de la iteración
-    metrics.psram_free_kb = get_psram_free_kb();
-    metrics.psram_used_kb = get_psram_total_kb() - metrics.psram_free_kb;
-    metrics.dram_free_kb = get_dram_free_kb();
-
-    unsigned long pipeline_start = millis();
+    PipelineMetrics metrics;
+    PROFILE_ITERATION_BEGIN(metrics, iteration_count);
 
     // -------------------------------------------------------------------------
     // Etapa 1: Capturar audio
     // -------------------------------------------------------------------------
-    unsigned long t1 = millis();
+#if DISPLAY_ANIMATIONS
+    // Avanza desde audio_capture() (poll callback); solo blits desde PSRAM
+    anim_play(anim_listen, display_get(), ANIM_X, ANIM_Y);
+#endif
+
+    PROFILE_STAGE_BEGIN(STAGE_CAPTURE);
 
     if (!audio_capture(audio_buffer)) {
+        // Cerrar la etapa: con PROFILER_ALLOC_HOOKS seguiría atribuyéndole
+        // las allocaciones hasta la próxima iteración
+        PROFILE_STAGE_END(STAGE_CAPTURE, metrics);
         Serial.println("ERROR: Fallo captura de audio");
         delay(5000);
         return;
     }
 
-    metrics.time_capture_ms = millis() - t1;
+    PROFILE_STAGE_END(STAGE_CAPTURE, metrics);
+
+#if DISPLAY_ANIMATIONS
+    // El último frame queda en pantalla mientras se procesa la ventana
+    anim_stop();
+#endif
+
+#if DISPLAY_ANIMATIONS && PROFILE_LEVEL >= PROFILE_FULL
+    AnimStats anim = anim_get_stats();
+    if (anim.frames) {
+        Serial.printf("[Anim] Frame: avg %u us, max %u us (%u frames durante la captura)\n",
+                      anim.avg_us, anim.max_us, anim.frames);
+    }
+#endif
+
+    // Audio crudo (antes de normalizar) para armar sets de regresión
+    if (export_every_iteration) {
+        export_audio(audio_buffer, AUDIO_SAMPLES, iteration_count);
+    }
+
+    // -------------------------------------------------------------------------
+    // Etapa opcional: grabar la ventana comprimida en LittleFS
+    // -------------------------------------------------------------------------
+    if (recorder_is_enabled()) {
+        PROFILE_STAGE_BEGIN(STAGE_RECORD);
+
+        recorder_record_window(audio_buffer, AUDIO_SAMPLES, millis());
+
+        PROFILE_STAGE_END(STAGE_RECORD, metrics);
+    }
 
     // -------------------------------------------------------------------------
     // Etapa 2: Normalizar
     // -------------------------------------------------------------------------
-    unsigned long t2 = millis();
+    PROFILE_STAGE_BEGIN(STAGE_NORMALIZE);
 
     audio_normalize(audio_buffer);
 
-    metrics.time_normalize_ms = millis() - t2;
+    PROFILE_STAGE_END(STAGE_NORMALIZE, metrics);
 
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
     // Estadísticas de audio
     AudioStats stats = audio_get_stats(audio_buffer);
     metrics.audio_rms = stats.rms;
     metrics.audio_peak_pos = stats.peak_pos;
     metrics.audio_peak_neg = stats.peak_neg;
+#endif
 
+#if PROFILE_LEVEL >= PROFILE_FULL
     Serial.printf("[Audio] RMS: %.1f, Picos: [%d, %d]\n",
                   stats.rms, stats.peak_neg, stats.peak_pos);
+#endif
 
     // -------------------------------------------------------------------------
     // Etapa 3: Extraer MFCCs
     // -------------------------------------------------------------------------
-    unsigned long t3 = millis();
+    PROFILE_STAGE_BEGIN(STAGE_MFCC);
 
     mfcc_extract(audio_buffer, mfcc_buffer);
 
-    metrics.time_mfcc_ms = millis() - t3;
+    PROFILE_STAGE_END(STAGE_MFCC, metrics);
+
+#if DISPLAY_HEATMAP && PROFILE_LEVEL >= PROFILE_FULL
+    // A N_FRAMES columnas por ventana de AUDIO_DURATION_SEC (25 columnas/s)
+    HeatmapStats heatmap = heatmap_get_stats();
+    if (heatmap.columns) {
+        Serial.printf("[Heatmap] Columna: avg %u us, max %u us (%.2f%% CPU a %d col/s)\n",
+                      heatmap.avg_us, heatmap.max_us,
+                      heatmap.avg_us * (N_FRAMES / (float)AUDIO_DURATION_SEC) / 1e4f,
+                      N_FRAMES / AUDIO_DURATION_SEC);
+    }
+#endif
+
+    if (export_every_iteration) {
+        export_mfcc(mfcc_buffer, iteration_count);
+    }
 
     // -------------------------------------------------------------------------
     // Etapa 4: Inferencia
     // -------------------------------------------------------------------------
-    unsigned long t4 = millis();
+    PROFILE_STAGE_BEGIN(STAGE_INFERENCE);
+
+    // En A/B la etapa incluye los dos modelos y la recarga de uno
+    EmotionResult result = model_ab_is_active() ? model_ab_run(mfcc_buffer, iteration_count)
+                                                : model_predict(mfcc_buffer);
+
+    PROFILE_STAGE_END(STAGE_INFERENCE, metrics);
 
-    EmotionResult result = model_predict(mfcc_buffer);
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
+    // Bucles calientes (dependen de dónde quedó cada buffer)
+    MfccFrameTiming frameTiming = mfcc_get_frame_timing();
+    metrics.mfcc_frame_avg_us = frameTiming.avg_us;
+    metrics.mfcc_frame_max_us = frameTiming.max_us;
+    metrics.invoke_us = model_get_last_invoke_us();
+#endif
 
-    metrics.time_inference_ms = millis() - t4;
+    recorder_tag_window(result.index, result.confidence);
 
     // -------------------------------------------------------------------------
-    // Finalizar métricas
+    // Finalizar métricas (CSV y, con PROFILE_FULL, reporte por Serial)
     // -------------------------------------------------------------------------
-    metrics.time_total_ms = millis() - pipeline_start;
-    metrics.emotion_index = result.index;
-    metrics.confidence = result.confidence;
-
-    // Guardar en CSV
-    profiler_log_iteration(metrics);
+    PROFILE_ITERATION_END(metrics, result.index, result.confidence);
 
     // Mostrar resultado
     print_result(result);
 
-    // Mostrar métricas en Serial
-    profiler_print_iteration(metrics);
-
-    Serial.printf("\n[CSV] Datos guardados en %s\n", CSV_FILENAME);
-
     // Esperar antes del próximo ciclo
     delay(2000);
 }
@@ -0,0 +1,373 @@
+#include "memory_plan.h"
+#include "config.h"
+#include "mfcc_extractor.h"
+#include "emotion_model.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+
+// =============================================================================
+// Implementación - Planner de memoria
+// =============================================================================
+
+static const char* REGION_NAMES[MEM_REGION_COUNT] = {"internal", "psram"};
+static const char* HEAT_NAMES[] = {"hot", "warm", "cold"};
+
+// Caps que se prueban para el bloque de cada región, en orden
+static const uint32_t INTERNAL_CAPS[] = {
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+    MALLOC_CAP_DMA | MALLOC_CAP_8BIT,
+};
+static const uint32_t PSRAM_CAPS[] = {
+    MALLOC_CAP_SPIRAM,
+};
+
+// -----------------------------------------------------------------------------
+// Política de placement
+// -----------------------------------------------------------------------------
+// Se aplica la primera regla con el mismo calor y tamaño <= max_bytes. Sin
+// regla, el buffer va a PSRAM. Los límites salen de lo que cuesta el acceso:
+// un buffer recorrido varias veces por frame paga la latencia de PSRAM (y
+// los misses de cache) en cada pasada; uno leído una vez por iteración no.
+
+struct PlacementRule {
+    MemoryHeat heat;
+    size_t max_bytes;
+    MemoryRegion region;
+};
+
+static const PlacementRule PLACEMENT_POLICY[] = {
+    {HEAT_HOT, 128 * 1024, MEM_INTERNAL},   // Scratch de la FFT, ventana, activaciones del arena
+    {HEAT_WARM,  8 * 1024, MEM_INTERNAL},   // Tablas chicas (DCT)
+};
+
+static PIPELINE_THREAD_LOCAL PlannedBuffer planBuffers[MEMORY_PLAN_MAX_BUFFERS];
+static PIPELINE_THREAD_LOCAL int planCount = 0;
+static PIPELINE_THREAD_LOCAL uint8_t* regionBlocks[MEM_REGION_COUNT] = {};
+static PIPELINE_THREAD_LOCAL size_t regionBytes[MEM_REGION_COUNT] = {};
+static PIPELINE_THREAD_LOCAL bool committed = false;
+static PIPELINE_THREAD_LOCAL int demotedCount = 0;
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static size_t align_up(size_t value) {
+    return (value + MEMORY_PLAN_ALIGN - 1) & ~(MEMORY_PLAN_ALIGN - 1);
+}
+
+static bool lifetimes_overlap(const PlannedBuffer& a, const PlannedBuffer& b) {
+    return a.first <= b.last && b.first <= a.last;
+}
+
+static bool addresses_overlap(const PlannedBuffer& a, const PlannedBuffer& b) {
+    return a.region == b.region &&
+           a.offset < b.offset + b.bytes && b.offset < a.offset + a.bytes;
+}
+
+// Greedy por tamaño (como el GreedyMemoryPlanner de TFLite Micro): cada
+// buffer va al primer hueco que no pisa a ningún buffer ya ubicado con el
+// que convive
+static void assign_offsets() {
+    int order[MEMORY_PLAN_MAX_BUFFERS];
+    for (int i = 0; i < planCount; i++) order[i] = i;
+    for (int i = 1; i < planCount; i++) {
+        int key = order[i];
+        int j = i - 1;
+        while (j >= 0 && planBuffers[order[j]].bytes < planBuffers[key].bytes) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    for (int r = 0; r < MEM_REGION_COUNT; r++) regionBytes[r] = 0;
+
+    for (int i = 0; i < planCount; i++) {
+        PlannedBuffer& buf = planBuffers[order[i]];
+        size_t offset = 0;
+
+        // Reintenta mientras el candidato choque con alguno ya ubicado
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            for (int k = 0; k < i; k++) {
+                const PlannedBuffer& other = planBuffers[order[k]];
+                if (other.region != buf.region || !lifetimes_overlap(buf, other)) continue;
+                if (offset < other.offset + other.bytes && other.offset < offset + buf.bytes) {
+                    offset = align_up(other.offset + other.bytes);
+                    moved = true;
+                }
+            }
+        }
+
+        buf.offset = offset;
+        if (offset + buf.bytes > regionBytes[buf.region]) {
+            regionBytes[buf.region] = align_up(offset + buf.bytes);
+        }
+    }
+}
+
+// Región según la tabla (o PSRAM con MEMORY_PLAN_FORCE_PSRAM)
+static void apply_policy() {
+    demotedCount = 0;
+    for (int i = 0; i < planCount; i++) {
+        PlannedBuffer& buf = planBuffers[i];
+        buf.region = MEM_PSRAM;
+        buf.placement = "sin regla";
+
+        if (MEMORY_PLAN_FORCE_PSRAM) {
+            buf.placement = "forzado";
+            continue;
+        }
+
+        for (const PlacementRule& rule : PLACEMENT_POLICY) {
+            if (rule.heat != buf.heat) continue;
+            if (buf.bytes > rule.max_bytes) {
+                buf.placement = "grande";
+                continue;
+            }
+            buf.region = rule.region;
+            buf.placement = "regla";
+            break;
+        }
+    }
+}
+
+// Pasa a PSRAM el buffer interno menos valioso: el más frío y, entre
+// iguales, el más grande (libera más SRAM por cada degradación)
+static bool demote_one(const char* reason) {
+    int victim = -1;
+    for (int i = 0; i < planCount; i++) {
+        const PlannedBuffer& buf = planBuffers[i];
+        if (buf.region != MEM_INTERNAL) continue;
+        if (victim < 0 || buf.heat > planBuffers[victim].heat ||
+            (buf.heat == planBuffers[victim].heat && buf.bytes > planBuffers[victim].bytes)) {
+            victim = i;
+        }
+    }
+    if (victim < 0) return false;
+
+    PlannedBuffer& buf = planBuffers[victim];
+    buf.region = MEM_PSRAM;
+    buf.placement = reason;
+    demotedCount++;
+    Serial.printf("[MemPlan] WARNING: %s (%.1f KB, %s) pasa a PSRAM: %s\n",
+                  buf.name, buf.bytes / 1024.0f, HEAT_NAMES[buf.heat], reason);
+    return true;
+}
+
+static void free_blocks() {
+    for (int r = 0; r < MEM_REGION_COUNT; r++) {
+        if (regionBlocks[r]) heap_caps_free(regionBlocks[r]);
+        regionBlocks[r] = nullptr;
+    }
+}
+
+static uint8_t* alloc_block(size_t bytes, const uint32_t* caps, size_t capsCount) {
+    for (size_t c = 0; c < capsCount; c++) {
+        uint8_t* block = (uint8_t*)heap_caps_aligned_alloc(MEMORY_PLAN_ALIGN, bytes, caps[c]);
+        if (block) {
+            if (c > 0) Serial.printf("[MemPlan] Bloque de %u KB desde caps 0x%x\n",
+                                     (unsigned)(bytes / 1024), (unsigned)caps[c]);
+            return block;
+        }
+    }
+    return nullptr;
+}
+
+// Retorna la región que no se pudo alocar o -1 si todas entraron
+static int alloc_blocks() {
+    if (regionBytes[MEM_INTERNAL] > 0) {
+        regionBlocks[MEM_INTERNAL] = alloc_block(regionBytes[MEM_INTERNAL], INTERNAL_CAPS,
+                                                 sizeof(INTERNAL_CAPS) / sizeof(INTERNAL_CAPS[0]));
+        if (!regionBlocks[MEM_INTERNAL]) return MEM_INTERNAL;
+    }
+    if (regionBytes[MEM_PSRAM] > 0) {
+        regionBlocks[MEM_PSRAM] = alloc_block(regionBytes[MEM_PSRAM], PSRAM_CAPS,
+                                              sizeof(PSRAM_CAPS) / sizeof(PSRAM_CAPS[0]));
+        if (!regionBlocks[MEM_PSRAM]) return MEM_PSRAM;
+    }
+    return -1;
+}
+
+static void format_lifetime(const PlannedBuffer& buf, char* out, size_t len) {
+    if (buf.first == STAGE_CAPTURE && buf.last == STAGE_COUNT - 1) {
+        snprintf(out, len, "persistente");
+    } else if (buf.first == buf.last) {
+        snprintf(out, len, "%s", profiler_stage_name(buf.first));
+    } else {
+        snprintf(out, len, "%s..%s", profiler_stage_name(buf.first), profiler_stage_name(buf.last));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+void memory_plan_reset() {
+    free_blocks();
+    planCount = 0;
+    committed = false;
+    demotedCount = 0;
+    for (int r = 0; r < MEM_REGION_COUNT; r++) regionBytes[r] = 0;
+}
+
+int memory_plan_add(const char* name, size_t bytes, PipelineStage first,
+                    PipelineStage last, MemoryHeat heat) {
+    if (committed || planCount >= MEMORY_PLAN_MAX_BUFFERS || first > last) {
+        Serial.printf("[MemPlan] ERROR: No se pudo declarar %s\n", name);
+        return -1;
+    }
+
+    PlannedBuffer& buf = planBuffers[planCount];
+    buf.name = name;
+    buf.bytes = align_up(bytes);
+    buf.first = first;
+    buf.last = last;
+    buf.heat = heat;
+    buf.region = MEM_PSRAM;
+    buf.placement = "";
+    buf.offset = 0;
+    return planCount++;
+}
+
+int memory_plan_add_persistent(const char* name, size_t bytes, MemoryHeat heat) {
+    return memory_plan_add(name, bytes, STAGE_CAPTURE, (PipelineStage)(STAGE_COUNT - 1), heat);
+}
+
+bool memory_plan_commit() {
+    if (committed) return true;
+
+    apply_policy();
+    assign_offsets();
+    while (regionBytes[MEM_INTERNAL] > MEMORY_PLAN_INTERNAL_BUDGET && demote_one("presupuesto")) {
+        assign_offsets();
+    }
+
+    // Sin bloque interno contiguo: se degrada de a un buffer (más lento, pero funciona)
+    int failed;
+    while ((failed = alloc_blocks()) >= 0) {
+        free_blocks();
+        if (failed == MEM_PSRAM || !demote_one("sin SRAM")) {
+            Serial.printf("[MemPlan] ERROR: No hay %u KB de PSRAM\n",
+                          (unsigned)(regionBytes[MEM_PSRAM] / 1024));
+            return false;
+        }
+        assign_offsets();
+    }
+
+    committed = true;
+    return true;
+}
+
+void* memory_plan_get(int handle) {
+    if (!committed || handle < 0 || handle >= planCount) return nullptr;
+    const PlannedBuffer& buf = planBuffers[handle];
+    return regionBlocks[buf.region] + buf.offset;
+}
+
+bool memory_plan_is_shared(int handle) {
+    if (!committed || handle < 0 || handle >= planCount) return false;
+    for (int i = 0; i < planCount; i++) {
+        if (i != handle && addresses_overlap(planBuffers[handle], planBuffers[i])) return true;
+    }
+    return false;
+}
+
+const PlannedBuffer* memory_plan_buffer(int handle) {
+    if (handle < 0 || handle >= planCount) return nullptr;
+    return &planBuffers[handle];
+}
+
+int memory_plan_find(const char* name) {
+    for (int i = 0; i < planCount; i++) {
+        if (strcmp(planBuffers[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+const char* memory_plan_region_name(MemoryRegion region) {
+    return region < MEM_REGION_COUNT ? REGION_NAMES[region] : "?";
+}
+
+const char* memory_plan_heat_name(MemoryHeat heat) {
+    return heat <= HEAT_COLD ? HEAT_NAMES[heat] : "?";
+}
+
+MemoryPlanSummary memory_plan_summary() {
+    MemoryPlanSummary summary = {};
+    summary.buffers = planCount;
+    summary.demoted = demotedCount;
+    summary.force_psram = MEMORY_PLAN_FORCE_PSRAM;
+
+    size_t total = 0;
+    for (int r = 0; r < MEM_REGION_COUNT; r++) {
+        summary.region_bytes[r] = regionBytes[r];
+        total += regionBytes[r];
+    }
+    for (int i = 0; i < planCount; i++) summary.declared_bytes += planBuffers[i].bytes;
+    summary.saved_bytes = summary.declared_bytes > total ? summary.declared_bytes - total : 0;
+    return summary;
+}
+
+void memory_plan_print(Print& out) {
+    // Ordenado por región y offset
+    int order[MEMORY_PLAN_MAX_BUFFERS];
+    for (int i = 0; i < planCount; i++) order[i] = i;
+    for (int i = 1; i < planCount; i++) {
+        int key = order[i];
+        const PlannedBuffer& k = planBuffers[key];
+        int j = i - 1;
+        while (j >= 0 && (planBuffers[order[j]].region > k.region ||
+                          (planBuffers[order[j]].region == k.region && planBuffers[order[j]].offset > k.offset))) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    out.println("  Región    Offset     Tamaño  Vida                 Calor  Motivo       Buffer");
+    for (int i = 0; i < planCount; i++) {
+        const PlannedBuffer& buf = planBuffers[order[i]];
+        char lifetime[32];
+        format_lifetime(buf, lifetime, sizeof(lifetime));
+        out.printf("  %-8s  0x%06x  %6.1f KB  %-19s  %-5s  %-11s  %s%s\n",
+                   REGION_NAMES[buf.region], (unsigned)buf.offset, buf.bytes / 1024.0f,
+                   lifetime, HEAT_NAMES[buf.heat], buf.placement, buf.name,
+                   memory_plan_is_shared(order[i]) ? " (compartido)" : "");
+    }
+
+    MemoryPlanSummary summary = memory_plan_summary();
+    out.printf("  Bloques: interna %.1f KB + PSRAM %.1f KB  |  declarado %.1f KB  |  ahorro %.1f KB\n",
+               summary.region_bytes[MEM_INTERNAL] / 1024.0f, summary.region_bytes[MEM_PSRAM] / 1024.0f,
+               summary.declared_bytes / 1024.0f, summary.saved_bytes / 1024.0f);
+    if (summary.force_psram) {
+        out.println("  (MEMORY_PLAN_FORCE_PSRAM: todo en PSRAM)");
+    } else if (summary.demoted > 0) {
+        out.printf("  (%d buffers degradados a PSRAM)\n", summary.demoted);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Plan del pipeline
+// -----------------------------------------------------------------------------
+
+bool memory_plan_pipeline(const char* model_path, PipelineBuffers& out, const char* alt_model_path) {
+    out = {};
+    memory_plan_reset();
+
+    // El audio muere al terminar los MFCCs; los MFCCs al cuantizar la entrada
+    out.audio_handle = memory_plan_add("audio", AUDIO_SAMPLES * sizeof(int16_t),
+                                       STAGE_CAPTURE, STAGE_MFCC, HEAT_COLD);
+    out.mfcc_handle = memory_plan_add("mfcc_out", N_MFCC * N_FRAMES * sizeof(float),
+                                      STAGE_MFCC, STAGE_INFERENCE, HEAT_COLD);
+
+    mfcc_plan_memory();
+    if (!model_plan_memory(model_path, alt_model_path)) return false;
+
+    if (!memory_plan_commit()) return false;
+
+    out.audio = (int16_t*)memory_plan_get(out.audio_handle);
+    out.mfcc = (float*)memory_plan_get(out.mfcc_handle);
+    return out.audio && out.mfcc;
+}
@@ -0,0 +1,133 @@
+#ifndef MEMORY_PLAN_H
+#define MEMORY_PLAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "profiler.h"
+
+class Print;
+
+// =============================================================================
+// Planner de memoria del pipeline
+// =============================================================================
+// Cada módulo declara sus buffers con tamaño, "calor" y vida útil (rango de
+// etapas del pipeline, ver PipelineStage). La región la elige la política de
+// placement (tabla tamaño/calor en memory_plan.cpp): lo caliente y chico va a
+// SRAM interna, lo grande o frío a PSRAM. memory_plan_commit() asigna un
+// offset a cada buffer dentro de un único bloque por región: dos buffers cuyas
+// vidas no se solapan pueden compartir direcciones (p.ej. el audio, que muere
+// al terminar los MFCCs, y el scratch del tensor arena, que solo vive durante
+// la inferencia). Todo el pipeline queda en dos allocaciones.
+//
+//   int h = memory_plan_add("audio", bytes, STAGE_CAPTURE, STAGE_MFCC, HEAT_COLD);
+//   ...
+//   memory_plan_commit();
+//   int16_t* audio = (int16_t*)memory_plan_get(h);
+//
+// El estado es por hilo en host (PIPELINE_THREAD_LOCAL), como el resto del
+// pipeline.
+// =============================================================================
+
+enum MemoryRegion : uint8_t {
+    MEM_INTERNAL = 0,   // SRAM interna: scratch caliente, tablas chicas
+    MEM_PSRAM,          // PSRAM: datos grandes o fríos
+    MEM_REGION_COUNT
+};
+
+// Qué tan seguido se recorre el buffer en los bucles del pipeline
+enum MemoryHeat : uint8_t {
+    HEAT_HOT = 0,       // Se recorre entero varias veces por frame/op (scratch)
+    HEAT_WARM,          // Se lee en cada frame/inferencia, acceso secuencial
+    HEAT_COLD           // Se escribe/lee una vez por iteración
+};
+
+// SRAM interna que el plan puede tomar: alcanza para el scratch de MFCC y
+// las activaciones del modelo; el resto queda para stacks, LittleFS y los
+// buffers DMA del I2S. Si no alcanza, se degradan buffers a PSRAM
+#ifndef MEMORY_PLAN_INTERNAL_BUDGET
+#define MEMORY_PLAN_INTERNAL_BUDGET (176 * 1024)
+#endif
+
+// -D MEMORY_PLAN_FORCE_PSRAM=1: todo a PSRAM (para comparar antes/después)
+#ifndef MEMORY_PLAN_FORCE_PSRAM
+#define MEMORY_PLAN_FORCE_PSRAM 0
+#endif
+
+constexpr int MEMORY_PLAN_MAX_BUFFERS = 16;
+constexpr size_t MEMORY_PLAN_ALIGN = 16;
+
+struct PlannedBuffer {
+    const char* name;
+    size_t bytes;
+    PipelineStage first;        // Primera etapa en la que está vivo
+    PipelineStage last;         // Última etapa (inclusive)
+    MemoryHeat heat;
+    MemoryRegion region;        // Elegida por la política (ver placement)
+    const char* placement;      // Motivo de la región (para el log)
+    size_t offset;              // Dentro del bloque de su región
+};
+
+struct MemoryPlanSummary {
+    int buffers;
+    size_t region_bytes[MEM_REGION_COUNT];  // Tamaño de cada bloque
+    size_t declared_bytes;                  // Suma de todos los buffers (sin aliasing)
+    size_t saved_bytes;                     // declared - total de los bloques
+    int demoted;                            // Buffers que la política quería en SRAM y quedaron en PSRAM
+    bool force_psram;                       // Compilado con MEMORY_PLAN_FORCE_PSRAM
+};
+
+// Descarta el plan actual (libera los bloques si ya estaba confirmado)
+void memory_plan_reset();
+
+// Declara un buffer vivo entre las etapas first y last (inclusive)
+// Retorna el handle o -1 si el plan ya está confirmado o lleno
+int memory_plan_add(const char* name, size_t bytes, PipelineStage first,
+                    PipelineStage last, MemoryHeat heat);
+
+// Buffer vivo en todas las etapas (tablas, modelo, estado del intérprete)
+int memory_plan_add_persistent(const char* name, size_t bytes, MemoryHeat heat);
+
+// Elige la región de cada buffer, asigna offsets y aloca un bloque por
+// región. El bloque interno se pide primero como SRAM interna y después como
+// memoria DMA-capable; si no entra (o supera MEMORY_PLAN_INTERNAL_BUDGET) se
+// degrada a PSRAM un buffer por vez, el más frío y grande primero, y se
+// loguea. Retorna false si no hay memoria
+bool memory_plan_commit();
+
+// Puntero del buffer (nullptr si el handle no es válido o no hay commit)
+void* memory_plan_get(int handle);
+
+// true si otro buffer comparte direcciones con este: su contenido no
+// sobrevive fuera de su vida declarada
+bool memory_plan_is_shared(int handle);
+
+const PlannedBuffer* memory_plan_buffer(int handle);
+const char* memory_plan_region_name(MemoryRegion region);
+const char* memory_plan_heat_name(MemoryHeat heat);
+
+// Handle del buffer declarado con ese nombre (-1 si no existe)
+int memory_plan_find(const char* name);
+MemoryPlanSummary memory_plan_summary();
+
+// Tabla del layout (región, offset, tamaño, vida, calor, motivo, aliasing)
+void memory_plan_print(Print& out);
+
+// -----------------------------------------------------------------------------
+// Plan del pipeline completo
+// -----------------------------------------------------------------------------
+
+struct PipelineBuffers {
+    int16_t* audio;             // AUDIO_SAMPLES muestras
+    float* mfcc;                // N_MFCC * N_FRAMES
+    int audio_handle;
+    int mfcc_handle;
+};
+
+// Declara el audio y los MFCCs de salida, los buffers de mfcc_extractor y
+// del modelo (mide el arena con model_path y alt_model_path si se da) y
+// confirma el plan. Después se llama a mfcc_init() y model_load() como
+// siempre
+bool memory_plan_pipeline(const char* model_path, PipelineBuffers& out,
+                          const char* alt_model_path = nullptr);
+
+#endif // MEMORY_PLAN_H
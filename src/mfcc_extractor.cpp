@@ -1,25 +1,36 @@
 #include "mfcc_extractor.h"
 #include "config.h"
+#include "memory_plan.h"
+#include "profiler.h"
 #include <Arduino.h>
 #include <math.h>
-#include "esp_heap_caps.h"
 #include "arduinoFFT.h"
 
 // =============================================================================
 // Implementación - Extracción de MFCCs
 // =============================================================================
 
-// Buffers internos (alocados en PSRAM)
-static float* vReal = nullptr;
-static float* vImag = nullptr;
-static float* melFilterbank = nullptr;
-static float* dctMatrix = nullptr;
-static float* hammingWindow = nullptr;
+// Buffers internos (del planner de memoria; uno por hilo en host)
+static PIPELINE_THREAD_LOCAL float* vReal = nullptr;
+static PIPELINE_THREAD_LOCAL float* vImag = nullptr;
+static PIPELINE_THREAD_LOCAL float* melFilterbank = nullptr;
+static PIPELINE_THREAD_LOCAL float* dctMatrix = nullptr;
+static PIPELINE_THREAD_LOCAL float* hammingWindow = nullptr;
 
-static ArduinoFFT<float> FFT;
+static PIPELINE_THREAD_LOCAL ArduinoFFT<float> FFT;
+
+// Handles en el plan de memoria (-1 = sin declarar)
+static PIPELINE_THREAD_LOCAL int vRealHandle = -1;
+static PIPELINE_THREAD_LOCAL int vImagHandle = -1;
+static PIPELINE_THREAD_LOCAL int melHandle = -1;
+static PIPELINE_THREAD_LOCAL int dctHandle = -1;
+static PIPELINE_THREAD_LOCAL int hammingHandle = -1;
 
 static const int MEL_COLS = (N_FFT / 2) + 1;
 
+static PIPELINE_THREAD_LOCAL MfccFrameTiming frameTiming = {};
+static PIPELINE_THREAD_LOCAL MfccColumnCallback columnCallback = nullptr;
+
 // -----------------------------------------------------------------------------
 // Funciones internas
 // -----------------------------------------------------------------------------
@@ -121,18 +132,28 @@ static void extract_frame(const int16_t* audio, int frame_index, float* mfccs) {
 // API pública
 // -----------------------------------------------------------------------------
 
+void mfcc_plan_memory() {
+    // El scratch de la FFT y la ventana se recorren enteros en cada frame; la
+    // DCT se lee una vez por frame. El filterbank también, pero con 160 KB la
+    // política lo deja en PSRAM
+    vRealHandle = memory_plan_add("fft_real", N_FFT * sizeof(float), STAGE_MFCC, STAGE_MFCC, HEAT_HOT);
+    vImagHandle = memory_plan_add("fft_imag", N_FFT * sizeof(float), STAGE_MFCC, STAGE_MFCC, HEAT_HOT);
+    hammingHandle = memory_plan_add_persistent("hamming", N_FFT * sizeof(float), HEAT_HOT);
+    dctHandle = memory_plan_add_persistent("dct", N_MFCC * N_MELS * sizeof(float), HEAT_WARM);
+    melHandle = memory_plan_add_persistent("mel_filterbank", N_MELS * MEL_COLS * sizeof(float), HEAT_HOT);
+}
+
 bool mfcc_init() {
     Serial.println("[MFCC] Inicializando...");
 
-    // Alocar buffers en PSRAM
-    vReal = (float*)heap_caps_aligned_alloc(16, N_FFT * sizeof(float), MALLOC_CAP_SPIRAM);
-    vImag = (float*)heap_caps_aligned_alloc(16, N_FFT * sizeof(float), MALLOC_CAP_SPIRAM);
-    melFilterbank = (float*)heap_caps_aligned_alloc(16, N_MELS * MEL_COLS * sizeof(float), MALLOC_CAP_SPIRAM);
-    dctMatrix = (float*)heap_caps_aligned_alloc(16, N_MFCC * N_MELS * sizeof(float), MALLOC_CAP_SPIRAM);
-    hammingWindow = (float*)heap_caps_aligned_alloc(16, N_FFT * sizeof(float), MALLOC_CAP_SPIRAM);
+    vReal = (float*)memory_plan_get(vRealHandle);
+    vImag = (float*)memory_plan_get(vImagHandle);
+    melFilterbank = (float*)memory_plan_get(melHandle);
+    dctMatrix = (float*)memory_plan_get(dctHandle);
+    hammingWindow = (float*)memory_plan_get(hammingHandle);
 
     if (!vReal || !vImag || !melFilterbank || !dctMatrix || !hammingWindow) {
-        Serial.println("[MFCC] ERROR: No se pudo alocar memoria");
+        Serial.println("[MFCC] ERROR: Buffers sin planificar (mfcc_plan_memory + memory_plan_commit)");
         return false;
     }
 
@@ -147,36 +168,50 @@ bool mfcc_init() {
 }
 
 void mfcc_extract(const int16_t* audio_in, float* mfcc_out) {
-    Serial.println("[MFCC] Extrayendo...");
+    PROFILE_LOG("[MFCC] Extrayendo...\n");
 
     float frameMFCCs[N_MFCC];
+    uint32_t totalUs = 0;
+    uint32_t maxUs = 0;
 
     for (int frame = 0; frame < N_FRAMES; frame++) {
+        unsigned long startUs = micros();
         extract_frame(audio_in, frame, frameMFCCs);
+        uint32_t elapsedUs = micros() - startUs;
+        totalUs += elapsedUs;
+        if (elapsedUs > maxUs) maxUs = elapsedUs;
 
         // Normalizar y guardar en formato (N_MFCC, N_FRAMES)
         for (int i = 0; i < N_MFCC; i++) {
-            mfcc_out[i * N_FRAMES + frame] = (frameMFCCs[i] - MFCC_MEAN) / MFCC_STD;
+            frameMFCCs[i] = (frameMFCCs[i] - MFCC_MEAN) / MFCC_STD;
+            mfcc_out[i * N_FRAMES + frame] = frameMFCCs[i];
         }
+        if (columnCallback) columnCallback(frame, frameMFCCs);
 
         if (frame % 25 == 0) {
-            Serial.printf("[MFCC] Frame %d/%d\n", frame, N_FRAMES);
+            PROFILE_LOG("[MFCC] Frame %d/%d\n", frame, N_FRAMES);
         }
     }
 
-    Serial.println("[MFCC] Completado");
+    frameTiming.avg_us = totalUs / N_FRAMES;
+    frameTiming.max_us = maxUs;
+
+    PROFILE_LOG("[MFCC] Completado\n");
 }
 
 void mfcc_deinit() {
-    if (vReal) heap_caps_free(vReal);
-    if (vImag) heap_caps_free(vImag);
-    if (melFilterbank) heap_caps_free(melFilterbank);
-    if (dctMatrix) heap_caps_free(dctMatrix);
-    if (hammingWindow) heap_caps_free(hammingWindow);
-
+    // La memoria es del plan (memory_plan_reset la libera)
     vReal = vImag = melFilterbank = dctMatrix = hammingWindow = nullptr;
 }
 
+MfccFrameTiming mfcc_get_frame_timing() {
+    return frameTiming;
+}
+
+void mfcc_set_column_callback(MfccColumnCallback callback) {
+    columnCallback = callback;
+}
+
 size_t mfcc_get_internal_memory_bytes() {
     // vReal + vImag + melFilterbank + dctMatrix + hammingWindow
     size_t total = 0;
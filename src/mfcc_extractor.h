@@ -8,8 +8,18 @@
 // Extracción de MFCCs
 // =============================================================================
 
-// Inicializa las matrices necesarias (Hamming, Mel filterbank, DCT)
-// Aloca memoria interna en PSRAM
+// Tiempo de extract_frame() (ventana + FFT + mel + DCT) en la última extracción
+struct MfccFrameTiming {
+    uint32_t avg_us;
+    uint32_t max_us;
+};
+
+// Declara los buffers internos en el plan de memoria (ver memory_plan.h).
+// Se llama antes de memory_plan_commit()
+void mfcc_plan_memory();
+
+// Inicializa las matrices necesarias (Hamming, Mel filterbank, DCT) sobre
+// los buffers del plan ya confirmado
 // Retorna true si OK
 bool mfcc_init();
 
@@ -18,7 +28,16 @@ bool mfcc_init();
 // mfcc_out: buffer de N_MFCC * N_FRAMES floats (debe estar pre-alocado)
 void mfcc_extract(const int16_t* audio_in, float* mfcc_out);
 
-// Libera memoria interna (opcional, para cleanup)
+// Tiempos por frame del último mfcc_extract()
+MfccFrameTiming mfcc_get_frame_timing();
+
+// Se llama desde mfcc_extract() con cada columna (N_MFCC valores ya
+// normalizados) apenas se calcula, p.ej. para el heatmap en vivo. Su tiempo
+// no entra en MfccFrameTiming. nullptr la desactiva
+typedef void (*MfccColumnCallback)(int frame, const float* column);
+void mfcc_set_column_callback(MfccColumnCallback callback);
+
+// Suelta los buffers internos (opcional, para cleanup)
 void mfcc_deinit();
 
 // Retorna la cantidad de memoria interna usada (en bytes)
@@ -0,0 +1,133 @@
+#include "mfcc_heatmap.h"
+#include "config.h"
+#include <Arduino.h>
+#include "Arduino_TFT.h"
+#include "canvas/Arduino_Canvas_Indexed.h"
+
+// =============================================================================
+// Implementación - Heatmap de MFCCs
+// =============================================================================
+
+// Paleta tipo "inferno": negro -> violeta -> rojo -> naranja -> amarillo
+struct ColorStop {
+    float pos;
+    uint8_t r, g, b;
+};
+
+static const ColorStop COLORMAP[] = {
+    {0.00f,   0,   0,   4},
+    {0.25f,  87,  16, 110},
+    {0.50f, 188,  55,  84},
+    {0.75f, 249, 142,   9},
+    {1.00f, 252, 255, 164},
+};
+static const int COLORMAP_STOPS = sizeof(COLORMAP) / sizeof(COLORMAP[0]);
+
+// Valor normalizado -> índice de la paleta: (v - HEATMAP_MIN) * QUANT_SCALE
+static const float QUANT_SCALE = 255.0f / (HEATMAP_MAX - HEATMAP_MIN);
+
+static Arduino_Canvas_Indexed* canvas = nullptr;
+static Arduino_TFT* output = nullptr;
+static uint16_t* palette = nullptr;
+static int16_t originX = 0;
+static int16_t originY = 0;
+
+static HeatmapStats stats = {};
+static uint32_t totalUs = 0;
+
+static void build_palette() {
+    for (int i = 0; i < 256; i++) {
+        float t = i / 255.0f;
+        int s = 0;
+        while (s < COLORMAP_STOPS - 2 && t > COLORMAP[s + 1].pos) s++;
+        const ColorStop& a = COLORMAP[s];
+        const ColorStop& b = COLORMAP[s + 1];
+        float f = (t - a.pos) / (b.pos - a.pos);
+        uint8_t r = (uint8_t)(a.r + (b.r - a.r) * f);
+        uint8_t g = (uint8_t)(a.g + (b.g - a.g) * f);
+        uint8_t bl = (uint8_t)(a.b + (b.b - a.b) * f);
+        palette[i] = RGB565(r, g, bl);
+    }
+}
+
+static inline uint8_t quantize(float v) {
+    float q = (v - HEATMAP_MIN) * QUANT_SCALE;
+    if (q <= 0.0f) return 0;
+    if (q >= 255.0f) return 255;
+    return (uint8_t)(q + 0.5f);
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+bool heatmap_init(Arduino_TFT* panel, int16_t x, int16_t y) {
+    if (!panel) return false;
+    heatmap_deinit();
+
+    canvas = new Arduino_Canvas_Indexed(N_FRAMES, N_MFCC, panel, x, y);
+    if (!canvas->begin(GFX_SKIP_OUTPUT_BEGIN)) {
+        Serial.println("[Heatmap] ERROR: No se pudo alocar el canvas");
+        heatmap_deinit();
+        return false;
+    }
+    // Los "colores" que se dibujan son índices de la paleta fija
+    canvas->setDirectUseColorIndex(true);
+    palette = canvas->getColorIndex();
+    build_palette();
+
+    output = panel;
+    originX = x;
+    originY = y;
+    canvas->fillScreen(quantize(0.0f));
+    canvas->flush();
+
+    stats = {};
+    totalUs = 0;
+    Serial.printf("[Heatmap] OK: %dx%d en (%d, %d)\n", N_FRAMES, N_MFCC, x, y);
+    return true;
+}
+
+void heatmap_push_column(int frame, const float* column) {
+    if (!canvas || frame < 0 || frame >= N_FRAMES) return;
+
+    uint32_t startUs = micros();
+    if (frame == 0) {
+        stats = {};
+        totalUs = 0;
+    }
+
+    uint8_t* fb = canvas->getFramebuffer() + frame;
+    uint8_t pixels[N_MFCC];
+    for (int i = 0; i < N_MFCC; i++) {
+        int row = N_MFCC - 1 - i;
+        pixels[row] = quantize(column[i]);
+        fb[row * N_FRAMES] = pixels[row];
+    }
+
+    output->startWrite();
+    output->writeAddrWindow(originX + frame, originY, 1, N_MFCC);
+    output->writeIndexedPixels(pixels, palette, N_MFCC);
+    output->endWrite();
+
+    uint32_t elapsedUs = micros() - startUs;
+    totalUs += elapsedUs;
+    stats.columns++;
+    stats.avg_us = totalUs / stats.columns;
+    if (elapsedUs > stats.max_us) stats.max_us = elapsedUs;
+}
+
+void heatmap_redraw() {
+    if (canvas) canvas->flush();
+}
+
+HeatmapStats heatmap_get_stats() {
+    return stats;
+}
+
+void heatmap_deinit() {
+    delete canvas;
+    canvas = nullptr;
+    output = nullptr;
+    palette = nullptr;
+}
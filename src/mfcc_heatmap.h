@@ -0,0 +1,40 @@
+#ifndef MFCC_HEATMAP_H
+#define MFCC_HEATMAP_H
+
+#include <stdint.h>
+
+// =============================================================================
+// Heatmap de MFCCs en vivo
+// =============================================================================
+// Un Arduino_Canvas_Indexed de N_FRAMES x N_MFCC (un byte por celda, 4 KB)
+// con una paleta de 256 colores precalculada. Cada columna que entrega
+// mfcc_extract() se cuantiza a 8 bits, se guarda en el canvas y se manda
+// sola al panel con writeIndexedPixels (N_MFCC píxeles). El tiempo corre de
+// izquierda a derecha: cada ventana nueva barre el heatmap encima de la
+// anterior, así no hay que retransmitir las columnas viejas para desplazarlas.
+// El coeficiente 0 queda abajo.
+// =============================================================================
+
+class Arduino_TFT;
+
+struct HeatmapStats {
+    uint32_t columns;      // Columnas de la última ventana
+    uint32_t avg_us;       // Cuantización + transferencia, por columna
+    uint32_t max_us;
+};
+
+// Crea el canvas y la paleta sobre el panel ya iniciado, con la esquina en
+// (x, y). Retorna true si OK
+bool heatmap_init(Arduino_TFT* panel, int16_t x, int16_t y);
+
+// Firma de MfccColumnCallback: mfcc_set_column_callback(heatmap_push_column)
+void heatmap_push_column(int frame, const float* column);
+
+// Manda el heatmap completo (p.ej. después de limpiar la pantalla)
+void heatmap_redraw();
+
+HeatmapStats heatmap_get_stats();
+
+void heatmap_deinit();
+
+#endif // MFCC_HEATMAP_H
@@ -0,0 +1,38 @@
+#ifndef MODEL_EMBEDDED_H
+#define MODEL_EMBEDDED_H
+
+// =============================================================================
+// Modelo embebido en flash
+// =============================================================================
+// Con -D MODEL_EMBEDDED=1, src/model_embedded.S incluye el .tflite de data/
+// como binario (.incbin) en .rodata. El flash está mapeado en memoria, así
+// que el intérprete lo usa en el lugar: sin buffer en RAM ni lectura de
+// LittleFS. data/ sigue siendo la única copia del modelo (la misma que se
+// sube a LittleFS con uploadfs).
+//
+// Lo incluyen config.h (MODEL_PATH) y el .S, así que solo macros del
+// preprocesador fuera de __ASSEMBLER__.
+// =============================================================================
+
+#ifndef MODEL_EMBEDDED
+#define MODEL_EMBEDDED 0
+#endif
+
+// Modelo por defecto: nombre en LittleFS y path en el proyecto para .incbin
+// (tools/embed_model.py pasa -Wa,-I$PROJECT_DIR y la dependencia del .o)
+#define MODEL_FILE_NAME "ser_202601_optimized_int8.tflite"
+#define MODEL_EMBEDDED_SOURCE "data/ser_202601_optimized_int8.tflite"
+
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+
+#if MODEL_EMBEDDED
+extern "C" {
+extern const uint8_t model_embedded_data[];     // Alineado a 16
+extern const uint32_t model_embedded_size;
+}
+#endif
+
+#endif // __ASSEMBLER__
+
+#endif // MODEL_EMBEDDED_H
@@ -0,0 +1,23 @@
+#ifndef MODEL_OPS_H
+#define MODEL_OPS_H
+
+// =============================================================================
+// Operadores de los modelos - GENERADO por tools/gen_op_resolver.py, no editar
+// =============================================================================
+// ser_202601_optimized_int8.tflite: ADD, CONV_2D, FULLY_CONNECTED, MAX_POOL_2D, MUL, SOFTMAX, MEAN
+// ser_cnn_int8.tflite: ADD, CONV_2D, FULLY_CONNECTED, MAX_POOL_2D, MUL, SOFTMAX, MEAN
+// =============================================================================
+
+#define MODEL_OPS_COUNT 7
+
+// X(código BuiltinOperator, método Add* de MicroMutableOpResolver)
+#define MODEL_OPS(X) \
+    X(ADD, Add) \
+    X(CONV_2D, Conv2D) \
+    X(FULLY_CONNECTED, FullyConnected) \
+    X(MAX_POOL_2D, MaxPool2D) \
+    X(MUL, Mul) \
+    X(SOFTMAX, Softmax) \
+    X(MEAN, Mean)
+
+#endif // MODEL_OPS_H
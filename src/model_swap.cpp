@@ -0,0 +1,217 @@
+#include "model_swap.h"
+#include "config.h"
+#include "mfcc_extractor.h"
+#include "profiler.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <math.h>
+#include <string.h>
+
+// =============================================================================
+// Implementación - Cambio de modelo y A/B
+// =============================================================================
+
+constexpr size_t MODEL_PATH_MAX = 48;
+
+struct AbModel {
+    char path[MODEL_PATH_MAX];
+    uint32_t invoke_us_sum;
+    uint32_t load_ms_sum;
+};
+
+static AbModel abModels[2];         // 0 = A, 1 = B
+static bool abActive = false;
+static uint32_t abWindows = 0;
+static uint32_t abAgree = 0;
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static void copy_path(char* dst, const char* src) {
+    strncpy(dst, src, MODEL_PATH_MAX - 1);
+    dst[MODEL_PATH_MAX - 1] = '\0';
+}
+
+// Plan + MFCC + modelo. El modelo se descarga antes de soltar su memoria
+static bool replan(const char* path, const char* alt_path, PipelineBuffers& buffers) {
+    model_unload();
+    mfcc_deinit();
+
+    if (!memory_plan_pipeline(path, buffers, alt_path)) return false;
+    if (!mfcc_init()) return false;
+    return model_load(path);
+}
+
+static void write_ab_row(uint32_t iteration, int first, const EmotionResult* results,
+                         const uint32_t* invokeUs, const uint32_t* loadMs, float maxDiff) {
+    bool writeHeader = !LittleFS.exists(AB_CSV_FILENAME);
+    File file = LittleFS.open(AB_CSV_FILENAME, "a");
+    if (!file) return;
+
+    if (writeHeader) {
+        file.println("iteration,model_a,model_b,first,"
+                     "emotion_a,confidence_a,invoke_us_a,load_ms_a,"
+                     "emotion_b,confidence_b,invoke_us_b,load_ms_b,"
+                     "agree,max_abs_diff");
+    }
+
+    file.printf("%u,%s,%s,%c,%s,%.4f,%u,%u,%s,%.4f,%u,%u,%d,%.4f\n",
+                iteration, abModels[0].path, abModels[1].path, first == 0 ? 'A' : 'B',
+                results[0].label, results[0].confidence, invokeUs[0], loadMs[0],
+                results[1].label, results[1].confidence, invokeUs[1], loadMs[1],
+                results[0].index == results[1].index ? 1 : 0, maxDiff);
+    file.close();
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+bool model_swap(const char* path, PipelineBuffers& buffers, const char* alt_path) {
+    // path puede apuntar al buffer de model_get_path(), que se pisa al cargar
+    char previous[MODEL_PATH_MAX];
+    char target[MODEL_PATH_MAX];
+    copy_path(previous, model_get_path());
+    copy_path(target, path);
+
+    if (!LittleFS.exists(target) && strcmp(target, MODEL_PATH) != 0) {
+        Serial.printf("[Model] ERROR: No existe %s\n", target);
+        return false;
+    }
+
+    Serial.printf("[Model] Cambiando a %s...\n", target);
+    unsigned long start = millis();
+    if (replan(target, alt_path, buffers)) {
+        Serial.printf("[Model] %s listo en %lu ms\n", target, millis() - start);
+        memory_plan_print(Serial);
+        return true;
+    }
+
+    Serial.printf("[Model] ERROR: No se pudo cargar %s, volviendo a %s\n", target, previous);
+    if (!replan(previous, nullptr, buffers)) {
+        Serial.println("[Model] ERROR: Tampoco se pudo volver al modelo anterior");
+    }
+    abActive = false;
+    return false;
+}
+
+bool model_ab_start(const char* path_b, PipelineBuffers& buffers) {
+    AbModel a = {};
+    AbModel b = {};
+    copy_path(a.path, model_get_path());
+    copy_path(b.path, path_b);
+
+    if (strcmp(a.path, b.path) == 0) {
+        Serial.println("[A/B] B es el mismo modelo que A");
+        return false;
+    }
+    if (!model_swap(a.path, buffers, b.path)) return false;
+
+    abModels[0] = a;
+    abModels[1] = b;
+    abWindows = 0;
+    abAgree = 0;
+    abActive = true;
+    Serial.printf("[A/B] A = %s, B = %s (resultados en %s)\n", a.path, b.path, AB_CSV_FILENAME);
+    return true;
+}
+
+bool model_ab_stop(PipelineBuffers& buffers) {
+    if (!abActive) return true;
+    abActive = false;
+    model_ab_print_summary(Serial);
+    return model_swap(abModels[0].path, buffers);
+}
+
+bool model_ab_is_active() {
+    return abActive;
+}
+
+EmotionResult model_ab_run(const float* mfcc, uint32_t iteration) {
+    EmotionResult results[2] = {};
+    uint32_t invokeUs[2] = {};
+    uint32_t loadMs[2] = {};
+
+    // Primero el que ya está cargado
+    int first = strcmp(model_get_path(), abModels[1].path) == 0 ? 1 : 0;
+    for (int n = 0; n < 2; n++) {
+        int m = n == 0 ? first : 1 - first;
+        if (strcmp(model_get_path(), abModels[m].path) != 0) {
+            unsigned long start = millis();
+            if (!model_load(abModels[m].path)) {
+                results[m].label = "error";
+                // model_load() ya descargó el intérprete anterior pero
+                // model_get_path() sigue con su path: volver al otro modelo
+                // (como model_swap) para que no se salte la recarga
+                if (!model_load(abModels[1 - m].path)) {
+                    Serial.printf("[A/B] ERROR: Tampoco se pudo volver a %s\n", abModels[1 - m].path);
+                }
+                continue;
+            }
+            loadMs[m] = millis() - start;
+        }
+        results[m] = model_predict(mfcc);
+        invokeUs[m] = model_get_last_invoke_us();
+    }
+
+    if (strcmp(results[0].label, "error") != 0 && strcmp(results[1].label, "error") != 0) {
+        float maxDiff = 0.0f;
+        for (int i = 0; i < NUM_EMOTIONS; i++) {
+            float diff = fabsf(results[0].probabilities[i] - results[1].probabilities[i]);
+            if (diff > maxDiff) maxDiff = diff;
+        }
+
+        abWindows++;
+        if (results[0].index == results[1].index) abAgree++;
+        for (int m = 0; m < 2; m++) {
+            abModels[m].invoke_us_sum += invokeUs[m];
+            abModels[m].load_ms_sum += loadMs[m];
+        }
+
+        write_ab_row(iteration, first, results, invokeUs, loadMs, maxDiff);
+        Serial.printf("[A/B] A: %s (%.2f, %u us)  B: %s (%.2f, %u us)  %s\n",
+                      results[0].label, results[0].confidence, invokeUs[0],
+                      results[1].label, results[1].confidence, invokeUs[1],
+                      results[0].index == results[1].index ? "coinciden" : "DIFIEREN");
+    }
+
+    return results[0];
+}
+
+void model_ab_print_summary(Print& out) {
+    if (abWindows == 0) {
+        out.println("[A/B] Sin ventanas comparadas");
+        return;
+    }
+
+    out.println("\n=== A/B ===");
+    out.printf("  Ventanas: %u  |  Acuerdo: %u (%.1f%%)\n",
+               abWindows, abAgree, abAgree * 100.0f / abWindows);
+    const char* names[2] = {"A", "B"};
+    for (int m = 0; m < 2; m++) {
+        out.printf("  %s %-36s invoke %8.0f us  recarga %6.0f ms\n",
+                   names[m], abModels[m].path,
+                   (float)abModels[m].invoke_us_sum / abWindows,
+                   (float)abModels[m].load_ms_sum / abWindows);
+    }
+    out.println("===========\n");
+}
+
+void model_list_files(Print& out) {
+    File root = LittleFS.open("/");
+    if (!root || !root.isDirectory()) return;
+
+    out.println("[Model] Modelos en LittleFS:");
+    File entry = root.openNextFile();
+    while (entry) {
+        String path = String("/") + entry.name();
+        size_t size = entry.size();
+        entry.close();
+        if (path.endsWith(".tflite")) {
+            bool current = strcmp(path.c_str(), model_get_path()) == 0;
+            out.printf("  %c %-40s %7.1f KB\n", current ? '*' : ' ', path.c_str(), size / 1024.0f);
+        }
+        entry = root.openNextFile();
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef MODEL_SWAP_H
+#define MODEL_SWAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "emotion_model.h"
+#include "memory_plan.h"
+
+class Print;
+
+// =============================================================================
+// Cambio de modelo en runtime y comparación A/B
+// =============================================================================
+// model_swap() rehace el plan de memoria del pipeline para otro .tflite de
+// LittleFS (el buffer del modelo y el arena cambian de tamaño), reinicia el
+// MFCC sobre los buffers nuevos y carga el modelo. Si algo falla vuelve al
+// modelo anterior. Los punteros de PipelineBuffers cambian: quien los guarde
+// tiene que actualizarlos.
+//
+// En modo A/B el plan se dimensiona para los dos modelos y cada ventana se
+// infiere con ambos sobre los mismos MFCCs. El orden se alterna (primero el
+// que quedó cargado), así hay una sola recarga por ventana. Cada ventana
+// agrega una fila a AB_CSV_FILENAME con latencia y acuerdo entre modelos.
+//
+// Dispositivo: comandos 'm' (cambiar modelo) y 'a' (A/B) por Serial.
+// =============================================================================
+
+// Rehace el plan para path (y alt_path si se da, para A/B) y carga path
+// Retorna false si no se pudo (queda cargado el modelo anterior)
+bool model_swap(const char* path, PipelineBuffers& buffers, const char* alt_path = nullptr);
+
+// Activa el A/B entre el modelo actual (A) y path_b
+bool model_ab_start(const char* path_b, PipelineBuffers& buffers);
+
+// Vuelve a un solo modelo (A) con el plan justo para él
+bool model_ab_stop(PipelineBuffers& buffers);
+
+bool model_ab_is_active();
+
+// Infiere la ventana con A y B, registra la fila en el CSV y retorna el
+// resultado de A (el que usa el resto del pipeline)
+EmotionResult model_ab_run(const float* mfcc, uint32_t iteration);
+
+// Ventanas, acuerdo y latencia media de cada modelo desde model_ab_start()
+void model_ab_print_summary(Print& out);
+
+// Imprime los .tflite de LittleFS (marca el cargado)
+void model_list_files(Print& out);
+
+#endif // MODEL_SWAP_H
@@ -0,0 +1,93 @@
+#include "op_profiler.h"
+#include "config.h"
+#include <Arduino.h>
+#include "tensorflow/lite/micro/micro_profiler.h"
+
+// =============================================================================
+// Implementación - Op Profiler
+// =============================================================================
+
+// BeginEvent/EndEvent son virtuales: se reemplaza el registro de ticks de la
+// base (que no se usa) por micros() por op
+class OpProfiler : public tflite::MicroProfiler {
+public:
+    uint32_t BeginEvent(const char* tag) override {
+        if (current_.count >= OP_PROFILER_MAX_OPS) return OP_PROFILER_MAX_OPS;
+        uint32_t handle = current_.count++;
+        current_.ops[handle].tag = tag;
+        startUs_[handle] = micros();
+        return handle;
+    }
+
+    void EndEvent(uint32_t event_handle) override {
+        if (event_handle >= OP_PROFILER_MAX_OPS) return;
+        uint32_t elapsed = micros() - startUs_[event_handle];
+        current_.ops[event_handle].us = elapsed;
+        current_.invoke_us += elapsed;
+    }
+
+    void begin() { current_ = {}; }
+    void end() { last_ = current_; }
+    const OpTimings& last() const { return last_; }
+
+private:
+    OpTimings current_ = {};
+    OpTimings last_ = {};
+    uint32_t startUs_[OP_PROFILER_MAX_OPS] = {};
+};
+
+static PIPELINE_THREAD_LOCAL OpProfiler opProfiler;
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+tflite::MicroProfiler* op_profiler_get() {
+    return &opProfiler;
+}
+
+void op_profiler_begin_invoke() {
+    opProfiler.begin();
+}
+
+void op_profiler_end_invoke() {
+    opProfiler.end();
+}
+
+const OpTimings& op_profiler_last() {
+    return opProfiler.last();
+}
+
+void op_profiler_print(const OpTimings& timings, Print& out) {
+    if (timings.count == 0) {
+        out.println("  (sin ops medidos)");
+        return;
+    }
+
+    float total = timings.invoke_us > 0 ? (float)timings.invoke_us : 1.0f;
+
+    for (int i = 0; i < timings.count; i++) {
+        const OpTiming& op = timings.ops[i];
+        out.printf("  %2d  %-18s %8u us  %5.1f%%\n",
+                   i, op.tag ? op.tag : "?", op.us, op.us * 100.0f / total);
+    }
+
+    // Totales por tipo de op
+    out.println("  Por tipo:");
+    bool counted[OP_PROFILER_MAX_OPS] = {};
+    for (int i = 0; i < timings.count; i++) {
+        if (counted[i]) continue;
+        const char* tag = timings.ops[i].tag ? timings.ops[i].tag : "?";
+        uint32_t sum = 0;
+        int n = 0;
+        for (int j = i; j < timings.count; j++) {
+            const char* other = timings.ops[j].tag ? timings.ops[j].tag : "?";
+            if (counted[j] || strcmp(tag, other) != 0) continue;
+            counted[j] = true;
+            sum += timings.ops[j].us;
+            n++;
+        }
+        out.printf("      %-18s x%-2d %8u us  %5.1f%%\n", tag, n, sum, sum * 100.0f / total);
+    }
+    out.printf("  Total ops: %u us\n", timings.invoke_us);
+}
@@ -0,0 +1,50 @@
+#ifndef OP_PROFILER_H
+#define OP_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Print;
+
+namespace tflite {
+class MicroProfiler;
+}
+
+// =============================================================================
+// Op Profiler - Tiempo de cada operador dentro de Invoke()
+// =============================================================================
+// Subclase de tflite::MicroProfiler: MicroGraph abre un evento por operador
+// (ScopedMicroProfiler, con el nombre del op como tag) y acá se mide con
+// micros(). Los ops se ejecutan siempre en el mismo orden, así que el índice
+// del evento es el índice del op en el grafo.
+//
+// El estado es por hilo en host (PIPELINE_THREAD_LOCAL), como el intérprete.
+// =============================================================================
+
+constexpr int OP_PROFILER_MAX_OPS = 48;
+
+struct OpTiming {
+    const char* tag;        // Nombre del op (CONV_2D, MAX_POOL_2D, ...)
+    uint32_t us;
+};
+
+struct OpTimings {
+    uint32_t invoke_us;     // Suma de los ops
+    uint8_t count;          // Ops medidos (se descartan los que excedan el máximo)
+    OpTiming ops[OP_PROFILER_MAX_OPS];
+};
+
+// Profiler para el constructor de MicroInterpreter
+tflite::MicroProfiler* op_profiler_get();
+
+// Llamar justo antes y después de Invoke()
+void op_profiler_begin_invoke();
+void op_profiler_end_invoke();
+
+// Tiempos del último Invoke() medido
+const OpTimings& op_profiler_last();
+
+// Tabla por op y totales por tipo de op
+void op_profiler_print(const OpTimings& timings, Print& out);
+
+#endif // OP_PROFILER_H
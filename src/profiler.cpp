@@ -1,5 +1,8 @@
 #include "profiler.h"
 #include "config.h"
+#include "cpu_stats.h"
+#include "memory_plan.h"
+#include "op_profiler.h"
 #include <Arduino.h>
 #include <LittleFS.h>
 #include "esp_heap_caps.h"
@@ -12,6 +15,280 @@ static File csvFile;
 static bool initialized = false;
 static const char* csvFilename = nullptr;
 
+static const char* STAGE_NAMES[STAGE_COUNT] = {
+    "capture", "record", "normalize", "mfcc", "inference", "storage"
+};
+
+// Estado de la iteración y de la etapa activa
+static unsigned long iterationStartUs = 0;
+static unsigned long stageStartUs = 0;
+static int activeStage = -1;
+static uint32_t stageDramMinStart = 0;
+static uint32_t stagePsramMinStart = 0;
+
+// La escritura del CSV se mide al loguear y se reporta en la fila siguiente
+static StageMemory lastStorageMem = {};
+
+// Carga por tarea de la última iteración (se vuelca en TASKS_CSV_FILENAME)
+static CpuStats lastCpuStats = {};
+
+// -----------------------------------------------------------------------------
+// Hooks de allocación (opcional)
+// -----------------------------------------------------------------------------
+
+#if PROFILER_ALLOC_HOOKS
+
+struct AllocCounters {
+    uint32_t count;
+    uint32_t bytes;
+    int32_t live;
+    int32_t peak_live;
+    uint32_t untracked;     // No entraron en trackedAllocs: live no las cuenta
+};
+
+// Allocaciones vivas hechas dentro de la etapa (para descontar sus free)
+static constexpr int TRACKED_ALLOCS = 256;
+
+struct TrackedAlloc {
+    void* ptr;
+    uint32_t size;
+};
+
+static AllocCounters allocCounters = {};
+static TrackedAlloc trackedAllocs[TRACKED_ALLOCS];
+static volatile bool hooksActive = false;
+static portMUX_TYPE hooksMux = portMUX_INITIALIZER_UNLOCKED;
+
+// free() termina llamando a heap_caps_free() (ya wrappeado): evitar contar dos veces
+static __thread int hookDepth = 0;
+
+static void hook_on_alloc(void* ptr, size_t size) {
+    if (!ptr || !hooksActive || hookDepth > 1) return;
+    portENTER_CRITICAL_SAFE(&hooksMux);
+    allocCounters.count++;
+    allocCounters.bytes += size;
+    // Sin lugar en la tabla su free no se podría descontar y live subiría
+    // de más: se cuenta aparte y el pico de la etapa queda como cota inferior
+    int slot = -1;
+    for (int i = 0; i < TRACKED_ALLOCS; i++) {
+        if (!trackedAllocs[i].ptr) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot >= 0) {
+        trackedAllocs[slot] = {ptr, (uint32_t)size};
+        allocCounters.live += size;
+        if (allocCounters.live > allocCounters.peak_live) {
+            allocCounters.peak_live = allocCounters.live;
+        }
+    } else {
+        allocCounters.untracked++;
+    }
+    portEXIT_CRITICAL_SAFE(&hooksMux);
+}
+
+static void hook_on_free(void* ptr) {
+    if (!ptr || !hooksActive || hookDepth > 1) return;
+    portENTER_CRITICAL_SAFE(&hooksMux);
+    for (int i = 0; i < TRACKED_ALLOCS; i++) {
+        if (trackedAllocs[i].ptr == ptr) {
+            allocCounters.live -= trackedAllocs[i].size;
+            trackedAllocs[i] = {nullptr, 0};
+            break;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&hooksMux);
+}
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+void* __real_heap_caps_malloc(size_t size, uint32_t caps);
+void* __real_heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps);
+void __real_heap_caps_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+    hookDepth++;
+    void* ptr = __real_malloc(size);
+    hook_on_alloc(ptr, size);
+    hookDepth--;
+    return ptr;
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    hookDepth++;
+    void* ptr = __real_calloc(n, size);
+    hook_on_alloc(ptr, n * size);
+    hookDepth--;
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    hookDepth++;
+    hook_on_free(ptr);
+    void* newPtr = __real_realloc(ptr, size);
+    hook_on_alloc(newPtr, size);
+    hookDepth--;
+    return newPtr;
+}
+
+void __wrap_free(void* ptr) {
+    hookDepth++;
+    hook_on_free(ptr);
+    __real_free(ptr);
+    hookDepth--;
+}
+
+void* __wrap_heap_caps_malloc(size_t size, uint32_t caps) {
+    hookDepth++;
+    void* ptr = __real_heap_caps_malloc(size, caps);
+    hook_on_alloc(ptr, size);
+    hookDepth--;
+    return ptr;
+}
+
+void* __wrap_heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    hookDepth++;
+    void* ptr = __real_heap_caps_aligned_alloc(alignment, size, caps);
+    hook_on_alloc(ptr, size);
+    hookDepth--;
+    return ptr;
+}
+
+void __wrap_heap_caps_free(void* ptr) {
+    hookDepth++;
+    hook_on_free(ptr);
+    __real_heap_caps_free(ptr);
+    hookDepth--;
+}
+}
+
+#endif // PROFILER_ALLOC_HOOKS
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static String csv_header() {
+    String header =
+        "iteration,"
+        "timestamp_ms,"
+        "psram_free_kb,"
+        "psram_used_kb,"
+        "dram_free_kb,"
+        "time_capture_ms,"
+        "time_record_ms,"
+        "time_normalize_ms,"
+        "time_mfcc_ms,"
+        "time_inference_ms,"
+        "time_total_ms,"
+        "audio_rms,"
+        "audio_peak_pos,"
+        "audio_peak_neg,"
+        "emotion_index,"
+        "confidence";
+
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        String name = STAGE_NAMES[s];
+        header += "," + name + "_dram_wm_drop_b";
+        header += "," + name + "_psram_wm_drop_b";
+        header += "," + name + "_allocs";
+        header += "," + name + "_alloc_bytes";
+        header += "," + name + "_peak_live_b";
+        header += "," + name + "_untracked_allocs";
+    }
+
+    header += ",peak_stage_dram,peak_stage_psram";
+    header += ",cpu0_busy_pct,cpu1_busy_pct,context_switches";
+    header += ",mfcc_frame_avg_us,mfcc_frame_max_us,invoke_us";
+    return header;
+}
+
+
+static void log_tasks(uint32_t iteration) {
+    if (lastCpuStats.task_count == 0) return;
+
+    bool writeHeader = !LittleFS.exists(TASKS_CSV_FILENAME);
+    File tasksFile = LittleFS.open(TASKS_CSV_FILENAME, "a");
+    if (!tasksFile) return;
+
+    if (writeHeader) {
+        tasksFile.println("iteration,window_us,task,core,busy_pct,stack_free_bytes");
+    }
+
+    for (int i = 0; i < lastCpuStats.task_count; i++) {
+        const TaskCpuStats& task = lastCpuStats.tasks[i];
+        tasksFile.printf("%u,%u,%s,%d,%.2f,%u\n",
+                         iteration, lastCpuStats.window_us, task.name,
+                         task.core, task.busy_pct, task.stack_free_bytes);
+    }
+    tasksFile.close();
+}
+
+// Tiempo por operador del último Invoke(), con la región del scratch del
+// arena para comparar builds/placements
+static void log_ops(uint32_t iteration) {
+    const OpTimings& timings = op_profiler_last();
+    if (timings.count == 0) return;
+
+    bool writeHeader = !LittleFS.exists(OPS_CSV_FILENAME);
+    File opsFile = LittleFS.open(OPS_CSV_FILENAME, "a");
+    if (!opsFile) return;
+
+    if (writeHeader) {
+        opsFile.println("iteration,op_index,op,us,scratch_region");
+    }
+
+    const PlannedBuffer* scratch = memory_plan_buffer(memory_plan_find("arena_scratch"));
+    const char* scratchRegion = scratch ? memory_plan_region_name(scratch->region) : "?";
+
+    for (int i = 0; i < timings.count; i++) {
+        opsFile.printf("%u,%d,%s,%u,%s\n", iteration, i,
+                       timings.ops[i].tag ? timings.ops[i].tag : "?", timings.ops[i].us, scratchRegion);
+    }
+    opsFile.close();
+}
+
+static void stage_memory_begin() {
+    stageDramMinStart = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    stagePsramMinStart = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+
+#if PROFILER_ALLOC_HOOKS
+    portENTER_CRITICAL(&hooksMux);
+    allocCounters = {};
+    memset(trackedAllocs, 0, sizeof(trackedAllocs));
+    portEXIT_CRITICAL(&hooksMux);
+    hooksActive = true;
+#endif
+}
+
+static void stage_memory_end(StageMemory& mem) {
+#if PROFILER_ALLOC_HOOKS
+    hooksActive = false;
+    portENTER_CRITICAL(&hooksMux);
+    AllocCounters counters = allocCounters;
+    portEXIT_CRITICAL(&hooksMux);
+
+    mem.alloc_count = counters.count;
+    mem.alloc_bytes = counters.bytes;
+    mem.peak_live_bytes = counters.peak_live > 0 ? counters.peak_live : 0;
+    mem.untracked_allocs = counters.untracked;
+#else
+    mem.alloc_count = 0;
+    mem.alloc_bytes = 0;
+    mem.peak_live_bytes = 0;
+    mem.untracked_allocs = 0;
+#endif
+
+    mem.dram_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    mem.psram_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+    mem.dram_watermark_drop = stageDramMinStart - mem.dram_min_free;
+    mem.psram_watermark_drop = stagePsramMinStart - mem.psram_min_free;
+}
+
 bool profiler_init(const char* filename) {
     if (!LittleFS.begin(true)) {
         Serial.println("[Profiler] ERROR: No se pudo montar LittleFS");
@@ -23,6 +300,23 @@ bool profiler_init(const char* filename) {
     // Verificar si el archivo existe para saber si escribir header
     bool writeHeader = !LittleFS.exists(filename);
 
+    // Si el CSV existente tiene otras columnas, archivarlo y empezar uno nuevo
+    if (!writeHeader) {
+        File oldFile = LittleFS.open(filename, "r");
+        String oldHeader = oldFile.readStringUntil('\n');
+        oldFile.close();
+
+        oldHeader.trim();
+
+        if (oldHeader != csv_header()) {
+            String archived = String(filename) + ".old";
+            LittleFS.remove(archived);
+            LittleFS.rename(filename, archived);
+            Serial.printf("[Profiler] Columnas nuevas, CSV anterior en %s\n", archived.c_str());
+            writeHeader = true;
+        }
+    }
+
     csvFile = LittleFS.open(filename, "a");  // Append mode
     if (!csvFile) {
         Serial.println("[Profiler] ERROR: No se pudo abrir archivo CSV");
@@ -30,24 +324,7 @@ bool profiler_init(const char* filename) {
     }
 
     if (writeHeader) {
-        // Escribir header del CSV
-        csvFile.println(
-            "iteration,"
-            "timestamp_ms,"
-            "psram_free_kb,"
-            "psram_used_kb,"
-            "dram_free_kb,"
-            "time_capture_ms,"
-            "time_normalize_ms,"
-            "time_mfcc_ms,"
-            "time_inference_ms,"
-            "time_total_ms,"
-            "audio_rms,"
-            "audio_peak_pos,"
-            "audio_peak_neg,"
-            "emotion_index,"
-            "confidence"
-        );
+        profiler_write_csv_header(csvFile);
         csvFile.flush();
         Serial.printf("[Profiler] CSV creado: %s\n", filename);
     } else {
@@ -65,29 +342,121 @@ void profiler_log_init_memory(const InitMemoryProfile& profile) {
     File initFile = LittleFS.open("/init_memory.txt", "w");
     if (initFile) {
         initFile.printf("PSRAM Initial: %u KB\n", profile.psram_initial_kb);
+        initFile.printf("DRAM Initial: %u KB\n", profile.dram_initial_kb);
         initFile.printf("Audio Buffer: %.1f KB\n", profile.audio_buffer_kb);
         initFile.printf("MFCC Buffer: %.1f KB\n", profile.mfcc_buffer_kb);
         initFile.printf("MFCC Internal: %.1f KB\n", profile.mfcc_internal_kb);
         initFile.printf("Model Buffer: %.1f KB\n", profile.model_buffer_kb);
         initFile.printf("Tensor Arena: %.1f KB\n", profile.tensor_arena_kb);
         initFile.printf("PSRAM After Init: %u KB\n", profile.psram_after_init_kb);
+        initFile.printf("DRAM After Init: %u KB\n", profile.dram_after_init_kb);
         initFile.printf("Total Allocated: %u KB\n", profile.total_allocated_kb);
+        initFile.printf("PSRAM Min Free: %u KB\n", profile.psram_min_free_kb);
+        initFile.printf("DRAM Min Free: %u KB\n", profile.dram_min_free_kb);
+        initFile.printf("Plan Internal: %.1f KB\n", profile.plan_internal_kb);
+        initFile.printf("Plan PSRAM: %.1f KB\n", profile.plan_psram_kb);
+        initFile.printf("Plan Declared: %.1f KB\n", profile.plan_declared_kb);
+        initFile.printf("Plan Saved: %.1f KB\n", profile.plan_saved_kb);
+        initFile.printf("Plan Demoted: %d\n", profile.plan_demoted);
+        initFile.printf("Plan Policy: %s\n", profile.plan_force_psram ? "psram-only" : "size/heat");
+        initFile.println("\nLayout:");
+        memory_plan_print(initFile);
         initFile.close();
     }
 }
 
-void profiler_log_iteration(const PipelineMetrics& metrics) {
-    if (!initialized || !csvFile) return;
+void profiler_iteration_begin(PipelineMetrics& metrics, uint32_t iteration) {
+    metrics = {};
+    metrics.iteration = iteration;
+    metrics.timestamp_ms = millis();
 
-    // Escribir línea CSV
-    csvFile.printf(
-        "%u,%lu,%u,%u,%u,%lu,%lu,%lu,%lu,%lu,%.2f,%d,%d,%d,%.4f\n",
+    // Memoria al inicio de la iteración
+    metrics.psram_free_kb = heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024;
+    metrics.psram_used_kb = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / 1024 - metrics.psram_free_kb;
+    metrics.dram_free_kb = heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024;
+
+#if PROFILE_LEVEL >= PROFILE_FULL
+    cpu_stats_begin();
+#endif
+
+    iterationStartUs = micros();
+}
+
+void profiler_stage_begin(PipelineStage stage) {
+    stage_memory_begin();
+    activeStage = stage;
+    stageStartUs = micros();
+}
+
+void profiler_stage_end(PipelineStage stage, PipelineMetrics& metrics) {
+    unsigned long elapsedMs = (micros() - stageStartUs) / 1000;
+    if (activeStage != stage) return;
+
+    stage_memory_end(metrics.stage_mem[stage]);
+    activeStage = -1;
+
+    switch (stage) {
+        case STAGE_CAPTURE:   metrics.time_capture_ms = elapsedMs;   break;
+        case STAGE_RECORD:    metrics.time_record_ms = elapsedMs;    break;
+        case STAGE_NORMALIZE: metrics.time_normalize_ms = elapsedMs; break;
+        case STAGE_MFCC:      metrics.time_mfcc_ms = elapsedMs;      break;
+        case STAGE_INFERENCE: metrics.time_inference_ms = elapsedMs; break;
+        default: break;
+    }
+}
+
+static void finish_iteration(PipelineMetrics& metrics) {
+#if PROFILE_LEVEL >= PROFILE_FULL
+    cpu_stats_end(lastCpuStats);
+    metrics.cpu0_busy_pct = lastCpuStats.core_busy_pct[0];
+    metrics.cpu1_busy_pct = lastCpuStats.core_busy_pct[1];
+    metrics.context_switches = lastCpuStats.context_switches;
+#else
+    metrics.cpu0_busy_pct = -1.0f;
+    metrics.cpu1_busy_pct = -1.0f;
+    metrics.context_switches = -1;
+#endif
+
+    metrics.stage_mem[STAGE_STORAGE] = lastStorageMem;
+
+    // La etapa que más bajó el watermark es la que fijó el pico
+    uint32_t maxDramDrop = 0;
+    uint32_t maxPsramDrop = 0;
+    metrics.peak_stage_dram = -1;
+    metrics.peak_stage_psram = -1;
+
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const StageMemory& mem = metrics.stage_mem[s];
+        if (mem.dram_watermark_drop > maxDramDrop) {
+            maxDramDrop = mem.dram_watermark_drop;
+            metrics.peak_stage_dram = s;
+        }
+        if (mem.psram_watermark_drop > maxPsramDrop) {
+            maxPsramDrop = mem.psram_watermark_drop;
+            metrics.peak_stage_psram = s;
+        }
+    }
+}
+
+const char* profiler_stage_name(PipelineStage stage) {
+    if (stage < 0 || stage >= STAGE_COUNT) return "none";
+    return STAGE_NAMES[stage];
+}
+
+void profiler_write_csv_header(Print& out) {
+    out.println(csv_header());
+}
+
+void profiler_write_csv_row(Print& out, const PipelineMetrics& metrics) {
+    out.printf(
+        "%u,%lu,%u,%u,%u,%lu,%lu,%lu,%lu,%lu,%lu,%.2f,%d,%d,%d,%.4f",
         metrics.iteration,
         metrics.timestamp_ms,
         metrics.psram_free_kb,
         metrics.psram_used_kb,
         metrics.dram_free_kb,
         metrics.time_capture_ms,
+        metrics.time_record_ms,
         metrics.time_normalize_ms,
         metrics.time_mfcc_ms,
         metrics.time_inference_ms,
@@ -99,8 +468,48 @@ void profiler_log_iteration(const PipelineMetrics& metrics) {
         metrics.confidence
     );
 
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const StageMemory& mem = metrics.stage_mem[s];
+        out.printf(",%u,%u,%u,%u,%u,%u",
+                   mem.dram_watermark_drop, mem.psram_watermark_drop,
+                   mem.alloc_count, mem.alloc_bytes, mem.peak_live_bytes, mem.untracked_allocs);
+    }
+    out.printf(",%d,%d", metrics.peak_stage_dram, metrics.peak_stage_psram);
+    out.printf(",%.1f,%.1f,%d",
+               metrics.cpu0_busy_pct, metrics.cpu1_busy_pct, metrics.context_switches);
+    out.printf(",%u,%u,%u\n",
+               metrics.mfcc_frame_avg_us, metrics.mfcc_frame_max_us, metrics.invoke_us);
+}
+
+void profiler_iteration_end(PipelineMetrics& metrics, int emotion_index, float confidence) {
+    metrics.time_total_ms = (micros() - iterationStartUs) / 1000;
+    metrics.emotion_index = emotion_index;
+    metrics.confidence = confidence;
+    finish_iteration(metrics);
+
+    profiler_log_iteration(metrics);
+
+#if PROFILE_LEVEL >= PROFILE_FULL
+    profiler_print_iteration(metrics);
+    Serial.printf("\n[CSV] Datos guardados en %s\n", csvFilename);
+#endif
+}
+
+void profiler_log_iteration(const PipelineMetrics& metrics) {
+    if (!initialized || !csvFile) return;
+
+    stage_memory_begin();
+
+    // Escribir línea CSV
+    profiler_write_csv_row(csvFile, metrics);
+
     // Flush cada iteración para no perder datos
     csvFile.flush();
+
+    log_tasks(metrics.iteration);
+    log_ops(metrics.iteration);
+
+    stage_memory_end(lastStorageMem);
 }
 
 void profiler_close() {
@@ -116,6 +525,7 @@ void profiler_print_init_memory(const InitMemoryProfile& profile) {
     Serial.println("================================================================");
 
     Serial.printf("\nPSRAM Inicial:     %u KB\n", profile.psram_initial_kb);
+    Serial.printf("DRAM Inicial:      %u KB\n", profile.dram_initial_kb);
 
     Serial.println("\nALLOCACIONES:");
     Serial.println("├── Audio");
@@ -128,7 +538,13 @@ void profiler_print_init_memory(const InitMemoryProfile& profile) {
     Serial.printf("│   └── tensorArena:      %6.1f KB\n", profile.tensor_arena_kb);
     Serial.println("└──────────────────────────────────");
     Serial.printf("   TOTAL ALLOCADO:    %6u KB\n", profile.total_allocated_kb);
-    Serial.printf("   PSRAM RESTANTE:    %6u KB\n", profile.psram_after_init_kb);
+    Serial.printf("   PSRAM RESTANTE:    %6u KB  (mínimo: %u KB)\n",
+                  profile.psram_after_init_kb, profile.psram_min_free_kb);
+    Serial.printf("   DRAM RESTANTE:     %6u KB  (mínimo: %u KB)\n",
+                  profile.dram_after_init_kb, profile.dram_min_free_kb);
+
+    Serial.println("\nPLAN DE MEMORIA:");
+    memory_plan_print(Serial);
 
     Serial.println("================================================================\n");
 }
@@ -142,14 +558,47 @@ void profiler_print_iteration(const PipelineMetrics& metrics) {
     Serial.printf("  PSRAM libre: %u KB  |  usado: %u KB\n", metrics.psram_free_kb, metrics.psram_used_kb);
     Serial.printf("  DRAM libre:  %u KB\n", metrics.dram_free_kb);
 
+    Serial.println("\nWATERMARK POR ETAPA (bajada del mínimo histórico):");
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const StageMemory& mem = metrics.stage_mem[s];
+        Serial.printf("  %-10s DRAM: %6u B  |  PSRAM: %7u B", STAGE_NAMES[s],
+                      mem.dram_watermark_drop, mem.psram_watermark_drop);
+#if PROFILER_ALLOC_HOOKS
+        Serial.printf("  |  allocs: %u (%u B, pico %u B)",
+                      mem.alloc_count, mem.alloc_bytes, mem.peak_live_bytes);
+        if (mem.untracked_allocs > 0) {
+            Serial.printf("  [%u sin seguir: pico subestimado]", mem.untracked_allocs);
+        }
+#endif
+        Serial.println();
+    }
+    Serial.printf("  Pico DRAM: %s  |  Pico PSRAM: %s\n",
+                  profiler_stage_name((PipelineStage)metrics.peak_stage_dram),
+                  profiler_stage_name((PipelineStage)metrics.peak_stage_psram));
+
+    Serial.println("\nCPU:");
+    Serial.printf("  Core 0: %5.1f%%  |  Core 1: %5.1f%%  |  Cambios de contexto: %d\n",
+                  metrics.cpu0_busy_pct, metrics.cpu1_busy_pct, metrics.context_switches);
+    for (int i = 0; i < lastCpuStats.task_count; i++) {
+        const TaskCpuStats& task = lastCpuStats.tasks[i];
+        if (task.busy_pct < 1.0f) continue;
+        Serial.printf("  %-16s core %2d  %5.1f%%\n", task.name, task.core, task.busy_pct);
+    }
+
     Serial.println("\nTIEMPOS:");
     Serial.printf("  Captura:     %4lu ms\n", metrics.time_capture_ms);
+    Serial.printf("  Grabación:   %4lu ms\n", metrics.time_record_ms);
     Serial.printf("  Normalizar:  %4lu ms\n", metrics.time_normalize_ms);
-    Serial.printf("  MFCC:        %4lu ms\n", metrics.time_mfcc_ms);
-    Serial.printf("  Inferencia:  %4lu ms\n", metrics.time_inference_ms);
+    Serial.printf("  MFCC:        %4lu ms  (frame: %u us prom, %u us máx)\n",
+                  metrics.time_mfcc_ms, metrics.mfcc_frame_avg_us, metrics.mfcc_frame_max_us);
+    Serial.printf("  Inferencia:  %4lu ms  (Invoke: %u us)\n",
+                  metrics.time_inference_ms, metrics.invoke_us);
     Serial.printf("  ─────────────────────\n");
     Serial.printf("  TOTAL:       %4lu ms\n", metrics.time_total_ms);
 
+    Serial.println("\nOPS (último Invoke):");
+    op_profiler_print(op_profiler_last(), Serial);
+
     Serial.println("\nAUDIO:");
     Serial.printf("  RMS: %.1f  |  Picos: [%d, %d]\n",
                   metrics.audio_rms, metrics.audio_peak_neg, metrics.audio_peak_pos);
@@ -206,27 +655,20 @@ void profiler_reset_csv() {
     if (LittleFS.exists(csvFilename)) {
         LittleFS.remove(csvFilename);
     }
+    if (LittleFS.exists(TASKS_CSV_FILENAME)) {
+        LittleFS.remove(TASKS_CSV_FILENAME);
+    }
+    if (LittleFS.exists(OPS_CSV_FILENAME)) {
+        LittleFS.remove(OPS_CSV_FILENAME);
+    }
+    if (LittleFS.exists(AB_CSV_FILENAME)) {
+        LittleFS.remove(AB_CSV_FILENAME);
+    }
 
     // Recrear con header
     csvFile = LittleFS.open(csvFilename, "w");
     if (csvFile) {
-        csvFile.println(
-            "iteration,"
-            "timestamp_ms,"
-            "psram_free_kb,"
-            "psram_used_kb,"
-            "dram_free_kb,"
-            "time_capture_ms,"
-            "time_normalize_ms,"
-            "time_mfcc_ms,"
-            "time_inference_ms,"
-            "time_total_ms,"
-            "audio_rms,"
-            "audio_peak_pos,"
-            "audio_peak_neg,"
-            "emotion_index,"
-            "confidence"
-        );
+        profiler_write_csv_header(csvFile);
         csvFile.flush();
         csvFile.close();
 
@@ -4,10 +4,87 @@
 #include <stdint.h>
 #include <stddef.h>
 
+class Print;
+
 // =============================================================================
 // Profiler - Métricas de memoria y tiempo para análisis
 // =============================================================================
 
+// -----------------------------------------------------------------------------
+// Niveles de profiling (compile-time, -D PROFILE_LEVEL=n)
+// -----------------------------------------------------------------------------
+// PROFILE_OFF:      sin instrumentación, las macros PROFILE_* no generan código
+// PROFILE_COUNTERS: tiempos, watermarks por etapa y CSV, sin reporte por Serial
+// PROFILE_FULL:     además carga de CPU por tarea y reporte detallado por Serial
+#define PROFILE_OFF      0
+#define PROFILE_COUNTERS 1
+#define PROFILE_FULL     2
+
+#ifndef PROFILE_LEVEL
+#define PROFILE_LEVEL PROFILE_FULL
+#endif
+
+#if PROFILE_LEVEL >= PROFILE_COUNTERS
+#define PROFILE_ITERATION_BEGIN(metrics, iteration) profiler_iteration_begin(metrics, iteration)
+#define PROFILE_STAGE_BEGIN(stage)                  profiler_stage_begin(stage)
+#define PROFILE_STAGE_END(stage, metrics)           profiler_stage_end(stage, metrics)
+#define PROFILE_ITERATION_END(metrics, index, conf) profiler_iteration_end(metrics, index, conf)
+#else
+#define PROFILE_ITERATION_BEGIN(metrics, iteration) ((void)(metrics))
+#define PROFILE_STAGE_BEGIN(stage)                  ((void)0)
+#define PROFILE_STAGE_END(stage, metrics)           ((void)0)
+#define PROFILE_ITERATION_END(metrics, index, conf) ((void)0)
+#endif
+
+// Progreso por frame/iteración de los módulos (captura, MFCC, inferencia):
+// solo con PROFILE_FULL. Errores y warnings se imprimen siempre
+#if PROFILE_LEVEL >= PROFILE_FULL
+#define PROFILE_LOG(...) Serial.printf(__VA_ARGS__)
+#else
+#define PROFILE_LOG(...) ((void)0)
+#endif
+
+#define TASKS_CSV_FILENAME "/tasks.csv"
+#define OPS_CSV_FILENAME "/ops.csv"
+#define AB_CSV_FILENAME "/ab.csv"
+
+// Modo opcional de hooks de allocación: atribuye cantidad y bytes de cada
+// malloc/heap_caps_* a la etapa activa. Requiere linkear con
+// -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free,
+// --wrap=heap_caps_malloc,--wrap=heap_caps_aligned_alloc,--wrap=heap_caps_free
+// (ver env t-circle-s3-RV-allochooks en platformio.ini)
+#ifndef PROFILER_ALLOC_HOOKS
+#define PROFILER_ALLOC_HOOKS 0
+#endif
+
+// Etapas instrumentadas del pipeline
+enum PipelineStage {
+    STAGE_CAPTURE = 0,
+    STAGE_RECORD,       // Grabación opcional de la ventana (IMA-ADPCM en LittleFS)
+    STAGE_NORMALIZE,
+    STAGE_MFCC,
+    STAGE_INFERENCE,
+    STAGE_STORAGE,      // Escritura del CSV en LittleFS (de la iteración anterior)
+    STAGE_COUNT
+};
+
+// Memoria de una etapa (bytes)
+// heap_caps_get_minimum_free_size() es un mínimo histórico desde el boot:
+// el "drop" es cuánto lo bajó la etapa. Un drop > 0 indica que esa etapa
+// fijó un nuevo pico de uso, aunque sea transitorio (ej: dentro de Invoke()).
+struct StageMemory {
+    uint32_t dram_watermark_drop;
+    uint32_t psram_watermark_drop;
+    uint32_t dram_min_free;         // Mínimo histórico al terminar la etapa
+    uint32_t psram_min_free;
+
+    // Solo con PROFILER_ALLOC_HOOKS (0 si está deshabilitado)
+    uint32_t alloc_count;
+    uint32_t alloc_bytes;
+    uint32_t peak_live_bytes;       // Pico de bytes vivos alocados dentro de la etapa
+    uint32_t untracked_allocs;      // Allocs con la tabla llena: no suman a peak_live_bytes
+};
+
 // Datos de una iteración del pipeline
 struct PipelineMetrics {
     // Identificación
@@ -21,11 +98,17 @@ struct PipelineMetrics {
 
     // Tiempos (ms)
     unsigned long time_capture_ms;
+    unsigned long time_record_ms;
     unsigned long time_normalize_ms;
     unsigned long time_mfcc_ms;
     unsigned long time_inference_ms;
     unsigned long time_total_ms;
 
+    // Bucles calientes (us): comparan placements de memoria entre builds
+    uint32_t mfcc_frame_avg_us;     // extract_frame() promedio
+    uint32_t mfcc_frame_max_us;
+    uint32_t invoke_us;             // interpreter->Invoke()
+
     // Audio
     float audio_rms;
     int16_t audio_peak_pos;
@@ -34,12 +117,23 @@ struct PipelineMetrics {
     // Resultado
     int emotion_index;
     float confidence;
+
+    // Memoria por etapa
+    StageMemory stage_mem[STAGE_COUNT];
+    int8_t peak_stage_dram;     // Etapa que fijó el pico de DRAM (-1 = ninguna)
+    int8_t peak_stage_psram;    // Etapa que fijó el pico de PSRAM (-1 = ninguna)
+
+    // CPU durante el pipeline (-1 = no disponible)
+    float cpu0_busy_pct;
+    float cpu1_busy_pct;
+    int32_t context_switches;
 };
 
 // Datos de memoria de inicialización (una sola vez)
 struct InitMemoryProfile {
-    // PSRAM antes de cualquier allocación
+    // PSRAM y DRAM antes de cualquier allocación
     uint32_t psram_initial_kb;
+    uint32_t dram_initial_kb;
 
     // Tamaño de cada buffer (KB)
     float audio_buffer_kb;
@@ -48,26 +142,66 @@ struct InitMemoryProfile {
     float model_buffer_kb;
     float tensor_arena_kb;
 
-    // PSRAM después de todas las allocaciones
+    // PSRAM y DRAM después de todas las allocaciones
     uint32_t psram_after_init_kb;
+    uint32_t dram_after_init_kb;
     uint32_t total_allocated_kb;
+
+    // Mínimos históricos (watermark) al terminar la inicialización
+    uint32_t psram_min_free_kb;
+    uint32_t dram_min_free_kb;
+
+    // Plan de memoria (ver memory_plan.h): bloques reales vs suma declarada
+    float plan_internal_kb;
+    float plan_psram_kb;
+    float plan_declared_kb;
+    float plan_saved_kb;
+    int plan_demoted;           // Buffers que la política quería en SRAM y no entraron
+    bool plan_force_psram;      // Build con MEMORY_PLAN_FORCE_PSRAM
 };
 
 // Inicializa el profiler y abre/crea el archivo CSV en LittleFS
 // filename: nombre del archivo CSV (ej: "/profiling.csv")
+// La carga por tarea se guarda aparte en TASKS_CSV_FILENAME y el tiempo por
+// operador de Invoke() en OPS_CSV_FILENAME (formato largo)
 // Retorna true si OK
 bool profiler_init(const char* filename);
 
 // Registra el perfil de memoria de inicialización
 void profiler_log_init_memory(const InitMemoryProfile& profile);
 
+// Las funciones de iteración y etapa se usan a través de las macros PROFILE_*
+
+// Inicia una iteración: memoria libre, timestamp y (con PROFILE_FULL) la
+// referencia de run-time stats para la carga de CPU
+void profiler_iteration_begin(PipelineMetrics& metrics, uint32_t iteration);
+
+// Marca el inicio de una etapa: toma el tiempo, el watermark de DRAM/PSRAM y,
+// con PROFILER_ALLOC_HOOKS, empieza a atribuirle las allocaciones
+void profiler_stage_begin(PipelineStage stage);
+
+// Marca el fin de la etapa y guarda su tiempo y StageMemory en metrics
+void profiler_stage_end(PipelineStage stage, PipelineMetrics& metrics);
+
+// Cierra la iteración: guarda el resultado, determina qué etapa fijó el pico
+// de DRAM y PSRAM, escribe el CSV y (con PROFILE_FULL) imprime el reporte
+void profiler_iteration_end(PipelineMetrics& metrics, int emotion_index, float confidence);
+
+// Nombre corto de la etapa (para CSV y Serial)
+const char* profiler_stage_name(PipelineStage stage);
+
 // Registra una iteración del pipeline
 void profiler_log_iteration(const PipelineMetrics& metrics);
 
+// Header y fila del CSV de métricas en cualquier salida (Serial, File).
+// El modo batch los usa para escribir el mismo formato fuera del profiler
+void profiler_write_csv_header(Print& out);
+void profiler_write_csv_row(Print& out, const PipelineMetrics& metrics);
+
 // Cierra el archivo CSV (flush)
 void profiler_close();
 
-// Imprime resumen de memoria de inicialización
+// Imprime resumen de memoria de inicialización y el layout del plan
 void profiler_print_init_memory(const InitMemoryProfile& profile);
 
 // Imprime métricas de una iteración
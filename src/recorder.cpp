@@ -0,0 +1,357 @@
+#include "recorder.h"
+#include "config.h"
+#include "ima_adpcm.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+
+// =============================================================================
+// Implementación - Recorder
+// =============================================================================
+
+// Se escriben de a 8 bloques (4 KB) para no fragmentar las escrituras en LittleFS
+static constexpr size_t WRITE_BLOCKS = 8;
+
+// Archivo descartable de recorder_benchmark()
+static constexpr const char* REC_BENCH_PATH = "/rec_bench.adp";
+
+static uint8_t writeBuffer[WRITE_BLOCKS * IMA_ADPCM_BLOCK_BYTES];
+static size_t writeBlocks = 0;
+
+// Muestras que todavía no completan un bloque
+static int16_t pending[IMA_ADPCM_SAMPLES_PER_BLOCK];
+static size_t pendingCount = 0;
+
+static ImaAdpcmState encoderState;
+static File dataFile;
+static uint32_t fileSeq = 0;
+static int windowsInFile = 0;
+
+static bool enabled = false;
+static bool mounted = false;
+static bool windowOpen = false;
+static bool entryPending = false;
+static RecordIndexEntry currentEntry;
+
+static uint32_t encodeUs = 0;
+static uint32_t writeUs = 0;
+static uint32_t bytesWritten = 0;
+
+// -----------------------------------------------------------------------------
+// Funciones internas
+// -----------------------------------------------------------------------------
+
+static String data_path(uint32_t seq) {
+    char path[32];
+    snprintf(path, sizeof(path), "%s/rec_%04u.adp", REC_DIR, seq);
+    return String(path);
+}
+
+static String index_path(uint32_t seq) {
+    char path[32];
+    snprintf(path, sizeof(path), "%s/rec_%04u.idx", REC_DIR, seq);
+    return String(path);
+}
+
+// Busca el menor y mayor número de archivo en REC_DIR (desde fromSeq)
+static bool scan_files(uint32_t* minSeq, uint32_t* maxSeq, uint32_t fromSeq = 0) {
+    File dir = LittleFS.open(REC_DIR);
+    if (!dir || !dir.isDirectory()) return false;
+
+    bool found = false;
+    File entry = dir.openNextFile();
+    while (entry) {
+        unsigned seq;
+        if (sscanf(entry.name(), "rec_%u.adp", &seq) == 1 && seq >= fromSeq) {
+            if (!found || seq < *minSeq) *minSeq = seq;
+            if (!found || seq > *maxSeq) *maxSeq = seq;
+            found = true;
+        }
+        entry = dir.openNextFile();
+    }
+    return found;
+}
+
+// false si no se pudo borrar el .adp: scan_files() lo seguiría devolviendo
+// como el más viejo, así que la rotación sigue desde el siguiente
+static bool delete_file(uint32_t seq) {
+    if (!LittleFS.remove(data_path(seq))) {
+        Serial.printf("[Recorder] ERROR: No se pudo borrar %s\n", data_path(seq).c_str());
+        return false;
+    }
+    LittleFS.remove(index_path(seq));
+    Serial.printf("[Recorder] Rotación: borrado rec_%04u\n", seq);
+    return true;
+}
+
+// Libera espacio borrando los archivos más viejos (nunca el actual)
+static void ensure_space(size_t bytesNeeded) {
+    uint32_t fromSeq = 0;
+    while (LittleFS.totalBytes() - LittleFS.usedBytes() < bytesNeeded) {
+        uint32_t minSeq = 0, maxSeq = 0;
+        if (!scan_files(&minSeq, &maxSeq, fromSeq) || minSeq >= fileSeq) break;
+        if (!delete_file(minSeq)) fromSeq = minSeq + 1;
+    }
+}
+
+static bool open_next_file() {
+    if (dataFile) dataFile.close();
+
+    fileSeq++;
+    if (fileSeq > (uint32_t)REC_MAX_FILES) {
+        uint32_t minSeq = 0, maxSeq = 0;
+        uint32_t fromSeq = 0;
+        while (scan_files(&minSeq, &maxSeq, fromSeq) && minSeq + REC_MAX_FILES <= fileSeq) {
+            if (!delete_file(minSeq)) fromSeq = minSeq + 1;
+        }
+    }
+
+    dataFile = LittleFS.open(data_path(fileSeq), "w");
+    if (!dataFile) {
+        Serial.printf("[Recorder] ERROR: No se pudo crear %s\n", data_path(fileSeq).c_str());
+        return false;
+    }
+
+    RecordFileHeader header = {
+        {'M', 'L', 'R', 'A'}, 1, 0, SAMPLE_RATE,
+        IMA_ADPCM_BLOCK_BYTES, IMA_ADPCM_SAMPLES_PER_BLOCK
+    };
+    dataFile.write((const uint8_t*)&header, sizeof(header));
+    windowsInFile = 0;
+    return true;
+}
+
+static void write_index_entry() {
+    File indexFile = LittleFS.open(index_path(fileSeq), "a");
+    if (indexFile) {
+        indexFile.write((const uint8_t*)&currentEntry, sizeof(currentEntry));
+        indexFile.close();
+    }
+    entryPending = false;
+}
+
+static void flush_blocks() {
+    if (writeBlocks == 0) return;
+
+    unsigned long start = micros();
+    size_t len = writeBlocks * IMA_ADPCM_BLOCK_BYTES;
+    dataFile.write(writeBuffer, len);
+    writeUs += micros() - start;
+    bytesWritten += len;
+    writeBlocks = 0;
+}
+
+static void encode_block(const int16_t* samples, size_t count) {
+    unsigned long start = micros();
+    ima_adpcm_encode_block(encoderState, samples, count,
+                           writeBuffer + writeBlocks * IMA_ADPCM_BLOCK_BYTES);
+    encodeUs += micros() - start;
+
+    if (++writeBlocks == WRITE_BLOCKS) flush_blocks();
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+bool recorder_init() {
+    if (!LittleFS.begin(true)) {
+        Serial.println("[Recorder] ERROR: No se pudo montar LittleFS");
+        return false;
+    }
+
+    if (!LittleFS.exists(REC_DIR)) {
+        LittleFS.mkdir(REC_DIR);
+    }
+
+    // Los archivos nuevos continúan la numeración existente
+    uint32_t minSeq = 0, maxSeq = 0;
+    if (scan_files(&minSeq, &maxSeq)) {
+        fileSeq = maxSeq;
+    }
+
+    mounted = true;
+    Serial.printf("[Recorder] OK: %s (último archivo: %u)\n", REC_DIR, fileSeq);
+    return true;
+}
+
+void recorder_set_enabled(bool value) {
+    enabled = value && mounted;
+}
+
+bool recorder_is_enabled() {
+    return enabled;
+}
+
+bool recorder_begin_window(uint32_t timestamp_ms) {
+    if (!enabled) return false;
+
+    // La ventana anterior no llegó a inferencia: indexarla sin emoción
+    if (entryPending) write_index_entry();
+
+    if (!dataFile || windowsInFile >= REC_WINDOWS_PER_FILE) {
+        if (!open_next_file()) return false;
+    }
+
+    ensure_space(ima_adpcm_blocks_for(AUDIO_SAMPLES) * IMA_ADPCM_BLOCK_BYTES + sizeof(writeBuffer));
+
+    currentEntry = {};
+    currentEntry.timestamp_ms = timestamp_ms;
+    currentEntry.offset = dataFile.size();
+    currentEntry.emotion_index = -1;
+
+    ima_adpcm_reset(encoderState);
+    pendingCount = 0;
+    writeBlocks = 0;
+    encodeUs = writeUs = bytesWritten = 0;
+    windowOpen = true;
+    return true;
+}
+
+void recorder_feed(const int16_t* samples, size_t count) {
+    if (!windowOpen) return;
+
+    currentEntry.samples += count;
+
+    // Completar el bloque pendiente
+    if (pendingCount > 0) {
+        size_t n = IMA_ADPCM_SAMPLES_PER_BLOCK - pendingCount;
+        if (n > count) n = count;
+        memcpy(pending + pendingCount, samples, n * sizeof(int16_t));
+        pendingCount += n;
+        samples += n;
+        count -= n;
+
+        if (pendingCount < IMA_ADPCM_SAMPLES_PER_BLOCK) return;
+        encode_block(pending, pendingCount);
+        pendingCount = 0;
+    }
+
+    // Bloques completos directo desde la entrada, sin copiar
+    while (count >= IMA_ADPCM_SAMPLES_PER_BLOCK) {
+        encode_block(samples, IMA_ADPCM_SAMPLES_PER_BLOCK);
+        samples += IMA_ADPCM_SAMPLES_PER_BLOCK;
+        count -= IMA_ADPCM_SAMPLES_PER_BLOCK;
+    }
+
+    memcpy(pending, samples, count * sizeof(int16_t));
+    pendingCount = count;
+}
+
+void recorder_end_window(RecorderStats* stats) {
+    if (!windowOpen) return;
+
+    if (pendingCount > 0) {
+        encode_block(pending, pendingCount);
+        pendingCount = 0;
+    }
+    flush_blocks();
+
+    unsigned long start = micros();
+    dataFile.flush();
+    writeUs += micros() - start;
+
+    windowOpen = false;
+    entryPending = true;
+    windowsInFile++;
+
+    if (stats) {
+        stats->encode_us = encodeUs;
+        stats->write_us = writeUs;
+        stats->bytes_written = bytesWritten;
+    }
+}
+
+bool recorder_record_window(const int16_t* audio, size_t count, uint32_t timestamp_ms,
+                            RecorderStats* stats) {
+    if (!recorder_begin_window(timestamp_ms)) return false;
+    recorder_feed(audio, count);
+    recorder_end_window(stats);
+    return true;
+}
+
+void recorder_tag_window(int emotion_index, float confidence) {
+    if (!entryPending) return;
+
+    currentEntry.emotion_index = (int8_t)emotion_index;
+    currentEntry.confidence_x10000 = (uint16_t)constrain(confidence * 10000.0f, 0.0f, 10000.0f);
+    write_index_entry();
+}
+
+void recorder_benchmark(const int16_t* audio, size_t count) {
+    static constexpr int RUNS = 5;
+
+    Serial.println("\n[Recorder] Benchmark IMA-ADPCM...");
+
+    // 1. Solo encoder (RAM)
+    uint8_t block[IMA_ADPCM_BLOCK_BYTES];
+    ImaAdpcmState state;
+    unsigned long start = micros();
+    for (int run = 0; run < RUNS; run++) {
+        ima_adpcm_reset(state);
+        for (size_t offset = 0; offset < count; offset += IMA_ADPCM_SAMPLES_PER_BLOCK) {
+            size_t n = count - offset;
+            if (n > IMA_ADPCM_SAMPLES_PER_BLOCK) n = IMA_ADPCM_SAMPLES_PER_BLOCK;
+            ima_adpcm_encode_block(state, audio + offset, n, block);
+        }
+    }
+    float encodeMs = (micros() - start) / 1000.0f / RUNS;
+
+    // 2. Encoder + escritura en LittleFS, sobre un archivo descartable fuera
+    // de REC_DIR: no entra en la rotación ni en el índice del dataset
+    RecorderStats stats = {};
+    float totalMs = 0.0f;
+    bool ok = false;
+    File benchFile;
+    if (mounted && !windowOpen) benchFile = LittleFS.open(REC_BENCH_PATH, "w");
+    if (benchFile) {
+        ima_adpcm_reset(state);
+        size_t blocks = 0;
+        start = micros();
+        for (size_t offset = 0; offset < count; offset += IMA_ADPCM_SAMPLES_PER_BLOCK) {
+            size_t n = count - offset;
+            if (n > IMA_ADPCM_SAMPLES_PER_BLOCK) n = IMA_ADPCM_SAMPLES_PER_BLOCK;
+            unsigned long encodeStart = micros();
+            ima_adpcm_encode_block(state, audio + offset, n, writeBuffer + blocks * IMA_ADPCM_BLOCK_BYTES);
+            stats.encode_us += micros() - encodeStart;
+
+            if (++blocks == WRITE_BLOCKS || offset + n >= count) {
+                unsigned long writeStart = micros();
+                benchFile.write(writeBuffer, blocks * IMA_ADPCM_BLOCK_BYTES);
+                stats.write_us += micros() - writeStart;
+                stats.bytes_written += blocks * IMA_ADPCM_BLOCK_BYTES;
+                blocks = 0;
+            }
+        }
+        unsigned long flushStart = micros();
+        benchFile.flush();
+        stats.write_us += micros() - flushStart;
+        totalMs = (micros() - start) / 1000.0f;
+        benchFile.close();
+        LittleFS.remove(REC_BENCH_PATH);
+        ok = true;
+    }
+
+    float windowMs = count * 1000.0f / SAMPLE_RATE;
+    Serial.printf("  Encoder (RAM):      %6.2f ms/ventana  (%.0fx tiempo real, %.1f MB/s)\n",
+                  encodeMs, windowMs / encodeMs, count * sizeof(int16_t) / (encodeMs * 1000.0f));
+    if (ok) {
+        Serial.printf("  Encoder + LittleFS: %6.2f ms/ventana  (encode %.2f ms, write %.2f ms, %u bytes)\n",
+                      totalMs, stats.encode_us / 1000.0f, stats.write_us / 1000.0f,
+                      stats.bytes_written);
+    } else {
+        Serial.println("  Encoder + LittleFS: ERROR (LittleFS no disponible)");
+    }
+}
+
+void recorder_for_each_file(void (*fn)(const char* path)) {
+    File dir = LittleFS.open(REC_DIR);
+    if (!dir || !dir.isDirectory()) return;
+
+    File entry = dir.openNextFile();
+    while (entry) {
+        String path = String(REC_DIR) + "/" + entry.name();
+        entry.close();
+        fn(path.c_str());
+        entry = dir.openNextFile();
+    }
+}
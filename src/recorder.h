@@ -0,0 +1,75 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// Recorder - Ventanas capturadas comprimidas en LittleFS (IMA-ADPCM 4:1)
+// =============================================================================
+// Cada archivo /rec/rec_NNNN.adp guarda hasta REC_WINDOWS_PER_FILE ventanas
+// como bloques IMA-ADPCM independientes. El índice /rec/rec_NNNN.idx tiene una
+// entrada por ventana con timestamp, offset y la emoción predicha. Se
+// conservan los últimos REC_MAX_FILES archivos (rotación).
+//
+// Decodificar en host: python tools/adpcm_to_wav.py rec_0001.adp
+// =============================================================================
+
+// Header de cada archivo .adp (16 bytes, little-endian)
+struct RecordFileHeader {
+    char magic[4];              // "MLRA"
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t sample_rate;
+    uint16_t block_bytes;
+    uint16_t samples_per_block;
+};
+
+// Entrada del índice .idx (16 bytes, little-endian)
+struct RecordIndexEntry {
+    uint32_t timestamp_ms;
+    uint32_t offset;            // Offset del primer bloque en el .adp
+    uint32_t samples;
+    int8_t emotion_index;       // -1 si la ventana no llegó a inferencia
+    uint8_t reserved;
+    uint16_t confidence_x10000;
+};
+
+// Tiempos de la última ventana grabada
+struct RecorderStats {
+    uint32_t encode_us;
+    uint32_t write_us;
+    uint32_t bytes_written;
+};
+
+// Monta LittleFS, crea REC_DIR y busca el último número de archivo
+// Retorna true si OK
+bool recorder_init();
+
+// Habilita o deshabilita la grabación (por defecto deshabilitada)
+void recorder_set_enabled(bool enabled);
+bool recorder_is_enabled();
+
+// API incremental: la ventana se codifica por bloques a medida que llegan
+// muestras, así puede intercalarse con la captura
+bool recorder_begin_window(uint32_t timestamp_ms);
+void recorder_feed(const int16_t* samples, size_t count);
+void recorder_end_window(RecorderStats* stats = nullptr);
+
+// Graba una ventana completa (begin + feed + end)
+bool recorder_record_window(const int16_t* audio, size_t count, uint32_t timestamp_ms,
+                            RecorderStats* stats = nullptr);
+
+// Agrega la emoción predicha a la última ventana grabada y escribe su entrada
+// en el índice
+void recorder_tag_window(int emotion_index, float confidence);
+
+// Mide el throughput del encoder (solo RAM) y de encoder + escritura en
+// LittleFS (archivo descartable fuera de REC_DIR) sobre una ventana, e
+// imprime el resultado. No toca el dataset ni el índice
+void recorder_benchmark(const int16_t* audio, size_t count);
+
+// Lista de archivos de grabación (para exportar): llama a fn con cada path
+void recorder_for_each_file(void (*fn)(const char* path));
+
+#endif // RECORDER_H
@@ -0,0 +1,114 @@
+#include "wav_file.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+
+// =============================================================================
+// Implementación - Lectura de WAV
+// =============================================================================
+
+static uint32_t read_u32_le(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_u16_le(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Recorre los chunks RIFF hasta encontrar "fmt " y "data"
+static bool parse_header(File& file, WavInfo* info) {
+    uint8_t riff[12];
+    if (file.read(riff, sizeof(riff)) != sizeof(riff) ||
+        memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    bool haveFmt = false;
+    uint16_t format = 0;
+    uint32_t pos = sizeof(riff);
+    size_t fileSize = file.size();
+
+    while (pos + 8 <= fileSize) {
+        uint8_t chunk[8];
+        if (file.read(chunk, sizeof(chunk)) != sizeof(chunk)) return false;
+        uint32_t chunkSize = read_u32_le(chunk + 4);
+        pos += 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[16];
+            if (chunkSize < sizeof(fmt) || file.read(fmt, sizeof(fmt)) != sizeof(fmt)) return false;
+            format = read_u16_le(fmt);
+            info->channels = read_u16_le(fmt + 2);
+            info->sample_rate = read_u32_le(fmt + 4);
+            info->bits_per_sample = read_u16_le(fmt + 14);
+            haveFmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!haveFmt) return false;
+            info->data_offset = pos;
+            info->data_bytes = fileSize - pos < chunkSize ? fileSize - pos : chunkSize;
+            // 1 = PCM, 0xFFFE = WAVE_FORMAT_EXTENSIBLE (PCM en la práctica)
+            return (format == 1 || format == 0xFFFE) && info->bits_per_sample == 16 &&
+                   info->channels >= 1;
+        }
+
+        // Chunks con tamaño impar llevan un byte de relleno
+        pos += chunkSize + (chunkSize & 1);
+        if (!file.seek(pos)) return false;
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// API pública
+// -----------------------------------------------------------------------------
+
+bool wav_open_info(const char* path, WavInfo* info) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("[Wav] ERROR: No se pudo abrir %s\n", path);
+        return false;
+    }
+
+    bool ok = parse_header(file, info);
+    file.close();
+    if (!ok) Serial.printf("[Wav] ERROR: %s no es WAV PCM16\n", path);
+    return ok;
+}
+
+int32_t wav_read_pcm16(const char* path, int16_t* out, size_t max_samples, WavInfo* info) {
+    WavInfo localInfo;
+    if (!info) info = &localInfo;
+
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        Serial.printf("[Wav] ERROR: No se pudo abrir %s\n", path);
+        return -1;
+    }
+    if (!parse_header(file, info) || !file.seek(info->data_offset)) {
+        Serial.printf("[Wav] ERROR: %s no es WAV PCM16\n", path);
+        file.close();
+        return -1;
+    }
+
+    size_t frameBytes = 2 * info->channels;
+    size_t available = info->data_bytes / frameBytes;
+    size_t count = available < max_samples ? available : max_samples;
+
+    if (info->channels == 1) {
+        // Little-endian en disco y en memoria (ESP32 y x86)
+        count = file.read((uint8_t*)out, count * 2) / 2;
+    } else {
+        uint8_t frame[16];
+        size_t i = 0;
+        for (; i < count; i++) {
+            if (frameBytes > sizeof(frame) || file.read(frame, frameBytes) != frameBytes) break;
+            out[i] = (int16_t)read_u16_le(frame);
+        }
+        count = i;
+    }
+    file.close();
+
+    if (count < max_samples) {
+        memset(out + count, 0, (max_samples - count) * sizeof(int16_t));
+    }
+    return (int32_t)count;
+}
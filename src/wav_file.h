@@ -0,0 +1,32 @@
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// Lectura de WAV PCM16 desde LittleFS
+// =============================================================================
+// Soporta mono o estéreo (se toma el canal izquierdo). Los archivos
+// truncados se leen hasta donde llegan: el header de data/audio.wav declara
+// más muestras de las que tiene.
+// =============================================================================
+
+struct WavInfo {
+    uint32_t sample_rate;
+    uint16_t channels;
+    uint16_t bits_per_sample;
+    uint32_t data_offset;       // Offset del primer byte del chunk "data"
+    uint32_t data_bytes;        // Bytes disponibles (no los declarados)
+};
+
+// Lee el header y ubica el chunk de datos
+// Retorna true si es un WAV PCM de 16 bits
+bool wav_open_info(const char* path, WavInfo* info);
+
+// Lee hasta max_samples muestras y completa con ceros hasta max_samples
+// Retorna la cantidad de muestras leídas del archivo, -1 si hay error
+int32_t wav_read_pcm16(const char* path, int16_t* out, size_t max_samples,
+                       WavInfo* info = nullptr);
+
+#endif // WAV_FILE_H
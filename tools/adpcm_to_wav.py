@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+Decodifica grabaciones IMA-ADPCM del recorder (src/recorder.h) a WAV PCM.
+
+Entrada: rec_NNNN.adp (y su índice rec_NNNN.idx en el mismo directorio).
+Salida: un WAV por ventana, nombrado con timestamp y emoción predicha:
+
+  <out>/rec_NNNN_w00_t123456ms_happy.wav
+
+Sin índice se decodifica todo el archivo como un único WAV.
+
+Uso:
+  python tools/adpcm_to_wav.py export/rec_0001.adp --out wavs
+"""
+
+import argparse
+import os
+import struct
+import sys
+import wave
+
+EMOTION_LABELS = ["anger", "disgust", "fear", "happy", "neutral", "sad", "surprise"]
+
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767,
+]
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+HEADER = struct.Struct("<4sHHIHH")
+INDEX_ENTRY = struct.Struct("<IIIbBH")
+
+
+def decode_block(block, samples_per_block):
+    predictor, index = struct.unpack_from("<hB", block, 0)
+    index = min(max(index, 0), 88)
+    out = [predictor]
+
+    for byte in block[4:]:
+        for nibble in (byte & 0x0F, byte >> 4):
+            step = STEP_TABLE[index]
+            diff = step >> 3
+            if nibble & 4:
+                diff += step
+            if nibble & 2:
+                diff += step >> 1
+            if nibble & 1:
+                diff += step >> 2
+            predictor += -diff if nibble & 8 else diff
+            predictor = min(max(predictor, -32768), 32767)
+            index = min(max(index + INDEX_TABLE[nibble], 0), 88)
+            out.append(predictor)
+
+    return out[:samples_per_block]
+
+
+def decode_range(data, offset, samples, block_bytes, samples_per_block):
+    pcm = []
+    while len(pcm) < samples and offset + block_bytes <= len(data):
+        pcm += decode_block(data[offset:offset + block_bytes], samples_per_block)
+        offset += block_bytes
+    return pcm[:samples]
+
+
+def write_wav(path, pcm, sample_rate):
+    with wave.open(path, "wb") as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(2)
+        wav.setframerate(sample_rate)
+        wav.writeframes(struct.pack("<%dh" % len(pcm), *pcm))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+", help="Archivos .adp")
+    parser.add_argument("--out", default=".", help="Directorio de salida")
+    args = parser.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+
+    for path in args.files:
+        with open(path, "rb") as f:
+            data = f.read()
+
+        magic, version, _, sample_rate, block_bytes, samples_per_block = HEADER.unpack_from(data)
+        if magic != b"MLRA":
+            print(f"{path}: no es una grabación MLRA", file=sys.stderr)
+            continue
+
+        base = os.path.splitext(os.path.basename(path))[0]
+        index_path = os.path.splitext(path)[0] + ".idx"
+
+        entries = []
+        if os.path.exists(index_path):
+            with open(index_path, "rb") as f:
+                raw = f.read()
+            entries = [INDEX_ENTRY.unpack_from(raw, i)
+                       for i in range(0, len(raw) - INDEX_ENTRY.size + 1, INDEX_ENTRY.size)]
+
+        if not entries:
+            blocks = (len(data) - HEADER.size) // block_bytes
+            entries = [(0, HEADER.size, blocks * samples_per_block, -1, 0, 0)]
+
+        for n, (timestamp, offset, samples, emotion, _, confidence) in enumerate(entries):
+            pcm = decode_range(data, offset, samples, block_bytes, samples_per_block)
+            label = EMOTION_LABELS[emotion] if 0 <= emotion < len(EMOTION_LABELS) else "unknown"
+            out = os.path.join(args.out, f"{base}_w{n:02d}_t{timestamp}ms_{label}.wav")
+            write_wav(out, pcm, sample_rate)
+            print(f"{out}: {len(pcm)} muestras, {label} ({confidence / 100:.1f}%)")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
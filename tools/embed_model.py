@@ -0,0 +1,23 @@
+"""
+extra_script de PlatformIO para src/model_embedded.S (ver model_embedded.h).
+
+.incbin busca el archivo relativo al directorio actual del assembler o a sus
+-I, no a los -I del preprocesador: se agrega -Wa,-I$PROJECT_DIR para que
+MODEL_EMBEDDED_SOURCE ("data/...") resuelva sin importar desde dónde corre
+el compilador.
+
+SCons tampoco ve el .incbin al escanear dependencias: el objeto depende a
+mano de data/*.tflite, así que cambiar un modelo vuelve a ensamblarlo.
+"""
+
+import glob
+import os
+
+Import("env")  # noqa: F821
+
+project = env.subst("$PROJECT_DIR")  # noqa: F821
+env.Append(ASPPFLAGS=["-Wa,-I" + project])  # noqa: F821
+env.Depends(  # noqa: F821
+    os.path.join("$BUILD_DIR", "src", "model_embedded.S.o"),
+    sorted(glob.glob(os.path.join(project, "data", "*.tflite"))),
+)
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+"""
+Receptor host del protocolo de exportación binaria (src/export_link.h).
+
+Lee el USB-CDC del T-Circle (o un volcado crudo guardado en archivo), separa
+las tramas COBS delimitadas por 0x00, verifica CRC-32 y números de secuencia,
+reensambla los streams y los guarda en disco:
+
+  audio -> <out>/iterNNNN_audio.wav
+  mfcc  -> <out>/iterNNNN_mfcc.npy   (float32, shape [N_MFCC, N_FRAMES])
+  file  -> <out>/<nombre del archivo>
+
+El texto que no forma parte de una trama (logs del firmware) se imprime tal cual.
+
+Uso:
+  python tools/export_receiver.py /dev/ttyACM0 --out capturas --send w
+  python tools/export_receiver.py --input volcado.bin --out capturas
+
+Requiere pyserial solo para leer del puerto.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import wave
+import zlib
+
+FRAME_BEGIN = 0x01
+FRAME_DATA = 0x02
+FRAME_END = 0x03
+
+KIND_AUDIO = 1
+KIND_MFCC = 2
+KIND_FILE = 3
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("COBS inválido")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Stream:
+    def __init__(self, kind, total, iteration, param0, param1, name):
+        self.kind = kind
+        self.total = total
+        self.iteration = iteration
+        self.param0 = param0
+        self.param1 = param1
+        self.name = name
+        self.data = bytearray(total)
+        self.received = 0
+        self.start = time.monotonic()
+
+
+class Receiver:
+    def __init__(self, out_dir, verbose=False):
+        self.out_dir = out_dir
+        self.verbose = verbose
+        self.streams = {}
+        self.expected_seq = None
+        self.frames_ok = 0
+        self.crc_errors = 0
+        self.seq_gaps = 0
+        self.completed = []
+        os.makedirs(out_dir, exist_ok=True)
+
+    def feed_chunk(self, chunk):
+        """Procesa el contenido entre dos delimitadores 0x00."""
+        if not chunk:
+            return
+        try:
+            frame = cobs_decode(chunk)
+        except ValueError:
+            frame = b""
+        if len(frame) < 8 or zlib.crc32(frame[:-4]) != struct.unpack("<I", frame[-4:])[0]:
+            self._text_or_error(chunk)
+            return
+
+        ftype, stream_id, seq = struct.unpack("<BBH", frame[:4])
+        payload = frame[4:-4]
+        self.frames_ok += 1
+
+        if self.expected_seq is not None and seq != self.expected_seq:
+            lost = (seq - self.expected_seq) & 0xFFFF
+            self.seq_gaps += 1
+            print(f"[rx] salto de secuencia: esperado {self.expected_seq}, llegó {seq} "
+                  f"({lost} tramas perdidas)", file=sys.stderr)
+        self.expected_seq = (seq + 1) & 0xFFFF
+
+        if ftype == FRAME_BEGIN:
+            kind, total, iteration, p0, p1 = struct.unpack("<BIIII", payload[:17])
+            name = payload[17:].decode("utf-8", "replace")
+            self.streams[stream_id] = Stream(kind, total, iteration, p0, p1, name)
+        elif ftype == FRAME_DATA:
+            stream = self.streams.get(stream_id)
+            if stream is None:
+                return
+            (offset,) = struct.unpack("<I", payload[:4])
+            data = payload[4:]
+            stream.data[offset:offset + len(data)] = data
+            stream.received += len(data)
+        elif ftype == FRAME_END:
+            stream = self.streams.pop(stream_id, None)
+            if stream is None:
+                return
+            total, crc = struct.unpack("<II", payload[:8])
+            self._finish(stream, total, crc)
+
+    def _text_or_error(self, chunk):
+        text = chunk.decode("utf-8", "replace")
+        printable = sum(c.isprintable() or c in "\r\n\t" for c in text)
+        if printable >= len(text) * 0.9:
+            sys.stdout.write(text)
+            sys.stdout.flush()
+        else:
+            self.crc_errors += 1
+            print(f"[rx] trama descartada ({len(chunk)} bytes, CRC/COBS inválido)",
+                  file=sys.stderr)
+
+    def _finish(self, stream, total, crc):
+        data = bytes(stream.data[:total])
+        ok = stream.received == total and zlib.crc32(data) == crc
+        elapsed = max(time.monotonic() - stream.start, 1e-6)
+        status = "OK" if ok else "CORRUPTO"
+
+        path = self._save(stream, data, ok)
+        print(f"[rx] {stream.name}: {total} bytes, {total / elapsed / 1024:.0f} KB/s, "
+              f"{status} -> {path}", file=sys.stderr)
+        self.completed.append((stream, ok, path))
+
+    def _save(self, stream, data, ok):
+        suffix = "" if ok else ".corrupt"
+        if stream.kind == KIND_AUDIO:
+            path = os.path.join(self.out_dir, f"iter{stream.iteration:04d}_audio{suffix}.wav")
+            with wave.open(path, "wb") as wav:
+                wav.setnchannels(1)
+                wav.setsampwidth(stream.param1 // 8)
+                wav.setframerate(stream.param0)
+                wav.writeframes(data)
+        elif stream.kind == KIND_MFCC:
+            path = os.path.join(self.out_dir, f"iter{stream.iteration:04d}_mfcc{suffix}.npy")
+            write_npy(path, data, (stream.param0, stream.param1))
+        else:
+            name = os.path.basename(stream.name) or "file.bin"
+            path = os.path.join(self.out_dir, name + suffix)
+            with open(path, "wb") as f:
+                f.write(data)
+        return path
+
+    def summary(self):
+        print(f"[rx] tramas OK: {self.frames_ok}, descartadas: {self.crc_errors}, "
+              f"saltos de secuencia: {self.seq_gaps}, streams: {len(self.completed)}",
+              file=sys.stderr)
+
+
+def write_npy(path, data, shape):
+    """Escribe un .npy float32 little-endian sin depender de numpy."""
+    header = "{'descr': '<f4', 'fortran_order': False, 'shape': (%d, %d), }" % shape
+    header_len = 10 + len(header) + 1
+    header += " " * ((64 - header_len % 64) % 64) + "\n"
+    with open(path, "wb") as f:
+        f.write(b"\x93NUMPY\x01\x00")
+        f.write(struct.pack("<H", len(header)))
+        f.write(header.encode("latin1"))
+        f.write(data)
+
+
+def run(source, receiver, idle_timeout):
+    buffer = bytearray()
+    last_data = time.monotonic()
+    while True:
+        chunk = source.read(65536)
+        if chunk:
+            last_data = time.monotonic()
+            buffer += chunk
+            *frames, buffer = buffer.split(b"\x00")
+            for frame in frames:
+                receiver.feed_chunk(bytes(frame))
+        elif idle_timeout and time.monotonic() - last_data > idle_timeout:
+            break
+        elif not chunk and not hasattr(source, "in_waiting"):
+            break
+    if buffer:
+        receiver.feed_chunk(bytes(buffer))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", nargs="?", help="Puerto serie (ej: /dev/ttyACM0, COM5)")
+    parser.add_argument("--input", help="Leer un volcado crudo en lugar del puerto")
+    parser.add_argument("--out", default="export", help="Directorio de salida")
+    parser.add_argument("--send", default="", help="Comandos a enviar al conectar (ej: wfx)")
+    parser.add_argument("--idle", type=float, default=5.0,
+                        help="Segundos sin datos para terminar (0 = nunca)")
+    args = parser.parse_args()
+
+    receiver = Receiver(args.out)
+
+    if args.input:
+        with open(args.input, "rb") as f:
+            run(f, receiver, 0)
+    elif args.port:
+        import serial  # pyserial
+
+        # USB-CDC nativo: el baudrate se ignora, la velocidad es la del USB
+        with serial.Serial(args.port, 115200, timeout=0.1) as port:
+            for cmd in args.send:
+                port.write(cmd.encode())
+                time.sleep(0.05)
+            try:
+                run(port, receiver, args.idle)
+            except KeyboardInterrupt:
+                pass
+    else:
+        parser.error("Indicar un puerto o --input")
+
+    receiver.summary()
+    return 0 if receiver.crc_errors == 0 and receiver.seq_gaps == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
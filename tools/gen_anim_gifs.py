@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Genera las animaciones de la UI (src/animation.h) como GIFs de 48x48:
+
+  data/anim_idle.gif    círculo que "respira" (espera)
+  data/anim_listen.gif  barras de nivel (escuchando)
+
+El tamaño es ANIM_MAX_WIDTH x ANIM_MAX_HEIGHT de src/config.h: el lugar
+arriba del heatmap en (ANIM_X, ANIM_Y). Solo usa la biblioteca estándar.
+
+Uso:
+  python tools/gen_anim_gifs.py --out data
+"""
+
+import argparse
+import math
+import os
+import struct
+
+SIZE = 48
+
+# Paleta de 16 colores (RGB888); 0 es el fondo negro del panel
+PALETTE = [(0, 0, 0)]
+for i in range(1, 8):  # Cian, de oscuro a claro
+    PALETTE.append((0, 24 + i * 28, 32 + i * 30))
+for i in range(1, 9):  # Verde a amarillo
+    PALETTE.append((min(255, i * 32), 200 + i * 6, 40))
+
+
+def lzw_encode(pixels, min_size):
+    clear = 1 << min_size
+    eoi = clear + 1
+    out = bytearray()
+    bits = 0
+    nbits = 0
+
+    def emit(code, size):
+        nonlocal bits, nbits
+        bits |= code << nbits
+        nbits += size
+        while nbits >= 8:
+            out.append(bits & 0xFF)
+            bits >>= 8
+            nbits -= 8
+
+    table = {(i,): i for i in range(clear)}
+    next_code = eoi + 1
+    size = min_size + 1
+    emit(clear, size)
+    prefix = ()
+    for p in pixels:
+        candidate = prefix + (p,)
+        if candidate in table:
+            prefix = candidate
+            continue
+        emit(table[prefix], size)
+        if next_code < 4096:
+            table[candidate] = next_code
+            next_code += 1
+            if next_code > (1 << size) and size < 12:
+                size += 1
+        else:
+            emit(clear, size)
+            table = {(i,): i for i in range(clear)}
+            next_code = eoi + 1
+            size = min_size + 1
+        prefix = (p,)
+    emit(table[prefix], size)
+    emit(eoi, size)
+    if nbits:
+        out.append(bits & 0xFF)
+
+    data = bytearray([min_size])
+    for i in range(0, len(out), 255):
+        chunk = out[i:i + 255]
+        data += bytes([len(chunk)]) + chunk
+    return data + b"\x00"
+
+
+def write_gif(path, frames, delay_cs):
+    out = bytearray(b"GIF89a")
+    out += struct.pack("<HHBBB", SIZE, SIZE, 0xF3, 0, 0)  # Paleta global de 16
+    out += b"".join(bytes(c) for c in PALETTE)
+    out += b"!\xff\x0bNETSCAPE2.0\x03\x01\x00\x00\x00"      # Repetir siempre
+    for pixels in frames:
+        out += b"!\xf9\x04\x04" + struct.pack("<H", delay_cs) + b"\x00\x00"
+        out += b"," + struct.pack("<HHHHB", 0, 0, SIZE, SIZE, 0)
+        out += lzw_encode(pixels, 4)
+    out += b";"
+    with open(path, "wb") as f:
+        f.write(out)
+    return len(out)
+
+
+def idle_frames(count=16):
+    frames = []
+    c = (SIZE - 1) / 2.0
+    for n in range(count):
+        radius = 13 + 5 * (0.5 - 0.5 * math.cos(2 * math.pi * n / count))
+        pixels = []
+        for y in range(SIZE):
+            for x in range(SIZE):
+                d = math.hypot(x - c, y - c)
+                if d > radius:
+                    pixels.append(0)
+                else:
+                    # Más claro hacia el centro
+                    pixels.append(1 + min(6, int((radius - d) / radius * 7)))
+        frames.append(pixels)
+    return frames
+
+
+def listen_frames(count=12):
+    frames = []
+    bars = 5
+    width = 6
+    gap = (SIZE - bars * width) // (bars + 1)
+    for n in range(count):
+        pixels = [0] * (SIZE * SIZE)
+        for b in range(bars):
+            phase = 2 * math.pi * (n / count + b * 0.23)
+            height = int(8 + 16 * (0.5 + 0.5 * math.sin(phase)) * (1.0 - abs(b - 2) * 0.18))
+            x0 = gap + b * (width + gap)
+            for y in range(SIZE // 2 - height, SIZE // 2 + height):
+                level = abs(y - SIZE // 2) * 8 // 24
+                for x in range(x0, x0 + width):
+                    pixels[y * SIZE + x] = 8 + min(7, level)
+        frames.append(pixels)
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--out", default="data", help="directorio de salida (data/ de LittleFS)")
+    args = parser.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    for name, frames, delay in (("anim_idle.gif", idle_frames(), 8),
+                                ("anim_listen.gif", listen_frames(), 6)):
+        path = os.path.join(args.out, name)
+        size = write_gif(path, frames, delay)
+        print(f"{path}: {len(frames)} frames, {size} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""
+Genera src/model_ops.h con los operadores que usan los modelos de data/.
+
+Lee cada data/*.tflite (flatbuffer del schema de TFLite, sin dependencias),
+junta los builtin ops de todos los subgrafos y escribe la lista como X-macro
+para que emotion_model.cpp registre exactamente esos ops en el resolver:
+
+  #define MODEL_OPS_COUNT 9
+  #define MODEL_OPS(X) \\
+      X(CONV_2D, Conv2D) \\
+      ...
+
+El resolver cubre la unión de los modelos (se pueden cambiar en runtime). Al
+cargar, emotion_model.cpp vuelve a recorrer los subgrafos del modelo y falla
+con el nombre del op si falta alguno.
+
+Se ejecuta antes de cada build de PlatformIO (extra_scripts = pre:...) y solo
+reescribe el header si cambió. A mano:
+
+  python tools/gen_op_resolver.py            # regenera src/model_ops.h
+  python tools/gen_op_resolver.py --list     # ops por modelo, sin escribir
+"""
+
+import argparse
+import glob
+import os
+import struct
+import sys
+
+# BuiltinOperator -> (nombre del enum, método de MicroMutableOpResolver)
+# Solo los ops que TFLite Micro sabe registrar
+BUILTIN_OPS = {
+    0: ("ADD", "Add"),
+    1: ("AVERAGE_POOL_2D", "AveragePool2D"),
+    2: ("CONCATENATION", "Concatenation"),
+    3: ("CONV_2D", "Conv2D"),
+    4: ("DEPTHWISE_CONV_2D", "DepthwiseConv2D"),
+    5: ("DEPTH_TO_SPACE", "DepthToSpace"),
+    6: ("DEQUANTIZE", "Dequantize"),
+    8: ("FLOOR", "Floor"),
+    9: ("FULLY_CONNECTED", "FullyConnected"),
+    11: ("L2_NORMALIZATION", "L2Normalization"),
+    12: ("L2_POOL_2D", "L2Pool2D"),
+    14: ("LOGISTIC", "Logistic"),
+    17: ("MAX_POOL_2D", "MaxPool2D"),
+    18: ("MUL", "Mul"),
+    19: ("RELU", "Relu"),
+    21: ("RELU6", "Relu6"),
+    22: ("RESHAPE", "Reshape"),
+    23: ("RESIZE_BILINEAR", "ResizeBilinear"),
+    25: ("SOFTMAX", "Softmax"),
+    26: ("SPACE_TO_DEPTH", "SpaceToDepth"),
+    27: ("SVDF", "Svdf"),
+    28: ("TANH", "Tanh"),
+    34: ("PAD", "Pad"),
+    36: ("GATHER", "Gather"),
+    37: ("BATCH_TO_SPACE_ND", "BatchToSpaceNd"),
+    38: ("SPACE_TO_BATCH_ND", "SpaceToBatchNd"),
+    39: ("TRANSPOSE", "Transpose"),
+    40: ("MEAN", "Mean"),
+    41: ("SUB", "Sub"),
+    43: ("SQUEEZE", "Squeeze"),
+    45: ("STRIDED_SLICE", "StridedSlice"),
+    47: ("EXP", "Exp"),
+    49: ("SPLIT", "Split"),
+    53: ("CAST", "Cast"),
+    54: ("PRELU", "Prelu"),
+    55: ("MAXIMUM", "Maximum"),
+    56: ("ARG_MAX", "ArgMax"),
+    57: ("MINIMUM", "Minimum"),
+    58: ("LESS", "Less"),
+    59: ("NEG", "Neg"),
+    60: ("PADV2", "PadV2"),
+    61: ("GREATER", "Greater"),
+    62: ("GREATER_EQUAL", "GreaterEqual"),
+    63: ("LESS_EQUAL", "LessEqual"),
+    65: ("SLICE", "Slice"),
+    66: ("SIN", "Sin"),
+    67: ("TRANSPOSE_CONV", "TransposeConv"),
+    70: ("EXPAND_DIMS", "ExpandDims"),
+    71: ("EQUAL", "Equal"),
+    72: ("NOT_EQUAL", "NotEqual"),
+    73: ("LOG", "Log"),
+    75: ("SQRT", "Sqrt"),
+    76: ("RSQRT", "Rsqrt"),
+    77: ("SHAPE", "Shape"),
+    79: ("ARG_MIN", "ArgMin"),
+    82: ("REDUCE_MAX", "ReduceMax"),
+    83: ("PACK", "Pack"),
+    84: ("LOGICAL_OR", "LogicalOr"),
+    86: ("LOGICAL_AND", "LogicalAnd"),
+    87: ("LOGICAL_NOT", "LogicalNot"),
+    88: ("UNPACK", "Unpack"),
+    90: ("FLOOR_DIV", "FloorDiv"),
+    92: ("SQUARE", "Square"),
+    93: ("ZEROS_LIKE", "ZerosLike"),
+    94: ("FILL", "Fill"),
+    95: ("FLOOR_MOD", "FloorMod"),
+    97: ("RESIZE_NEAREST_NEIGHBOR", "ResizeNearestNeighbor"),
+    98: ("LEAKY_RELU", "LeakyRelu"),
+    100: ("MIRROR_PAD", "MirrorPad"),
+    101: ("ABS", "Abs"),
+    102: ("SPLIT_V", "SplitV"),
+    104: ("CEIL", "Ceil"),
+    106: ("ADD_N", "AddN"),
+    107: ("GATHER_ND", "GatherNd"),
+    108: ("COS", "Cos"),
+    111: ("ELU", "Elu"),
+    114: ("QUANTIZE", "Quantize"),
+    116: ("ROUND", "Round"),
+    117: ("HARD_SWISH", "HardSwish"),
+    118: ("IF", "If"),
+}
+
+HEADER_PATH = os.path.join("src", "model_ops.h")
+
+
+# -----------------------------------------------------------------------------
+# Lectura del flatbuffer
+# -----------------------------------------------------------------------------
+
+class Table:
+    """Tabla de un flatbuffer: campos por índice a través de su vtable."""
+
+    def __init__(self, buf, pos):
+        self.buf = buf
+        self.pos = pos
+        vtable = pos - struct.unpack_from("<i", buf, pos)[0]
+        self.vtable = vtable
+        self.vtable_size = struct.unpack_from("<H", buf, vtable)[0]
+
+    def _field(self, index):
+        entry = 4 + 2 * index
+        if entry >= self.vtable_size:
+            return 0
+        return struct.unpack_from("<H", self.buf, self.vtable + entry)[0]
+
+    def scalar(self, index, fmt, default=0):
+        offset = self._field(index)
+        if not offset:
+            return default
+        return struct.unpack_from("<" + fmt, self.buf, self.pos + offset)[0]
+
+    def tables(self, index):
+        offset = self._field(index)
+        if not offset:
+            return []
+        loc = self.pos + offset
+        vec = loc + struct.unpack_from("<I", self.buf, loc)[0]
+        count = struct.unpack_from("<I", self.buf, vec)[0]
+        result = []
+        for i in range(count):
+            elem = vec + 4 + 4 * i
+            result.append(Table(self.buf, elem + struct.unpack_from("<I", self.buf, elem)[0]))
+        return result
+
+
+def model_ops(path):
+    """Builtin codes usados por los operadores de todos los subgrafos."""
+    with open(path, "rb") as f:
+        buf = f.read()
+    if buf[4:8] != b"TFL3":
+        raise ValueError(f"{path}: no es un modelo TFLite (identificador {buf[4:8]!r})")
+
+    model = Table(buf, struct.unpack_from("<I", buf, 0)[0])
+    # Model: 1 = operator_codes, 2 = subgraphs
+    # OperatorCode: 0 = deprecated_builtin_code (int8), 3 = builtin_code (int32)
+    codes = []
+    for opcode in model.tables(1):
+        deprecated = opcode.scalar(0, "b")
+        builtin = opcode.scalar(3, "i")
+        codes.append(max(deprecated, builtin))
+
+    used = set()
+    for subgraph in model.tables(2):
+        # SubGraph: 3 = operators; Operator: 0 = opcode_index
+        for op in subgraph.tables(3):
+            used.add(codes[op.scalar(0, "I")])
+    return used
+
+
+# -----------------------------------------------------------------------------
+# Header
+# -----------------------------------------------------------------------------
+
+def render_header(models):
+    union = sorted(set().union(*models.values()))
+    lines = [
+        "#ifndef MODEL_OPS_H",
+        "#define MODEL_OPS_H",
+        "",
+        "// =============================================================================",
+        "// Operadores de los modelos - GENERADO por tools/gen_op_resolver.py, no editar",
+        "// =============================================================================",
+    ]
+    for name in sorted(models):
+        ops = ", ".join(BUILTIN_OPS[code][0] for code in sorted(models[name]))
+        lines.append(f"// {name}: {ops}")
+    lines += [
+        "// =============================================================================",
+        "",
+        f"#define MODEL_OPS_COUNT {len(union)}",
+        "",
+        "// X(código BuiltinOperator, método Add* de MicroMutableOpResolver)",
+        "#define MODEL_OPS(X) \\",
+    ]
+    for i, code in enumerate(union):
+        name, method = BUILTIN_OPS[code]
+        tail = " \\" if i < len(union) - 1 else ""
+        lines.append(f"    X({name}, {method}){tail}")
+    lines += ["", "#endif // MODEL_OPS_H", ""]
+    return "\n".join(lines)
+
+
+def collect(project_dir):
+    models = {}
+    for path in sorted(glob.glob(os.path.join(project_dir, "data", "*.tflite"))):
+        ops = model_ops(path)
+        unknown = [code for code in ops if code not in BUILTIN_OPS]
+        if unknown:
+            raise ValueError(f"{path}: ops sin soporte en TFLite Micro: {sorted(unknown)}")
+        models[os.path.basename(path)] = ops
+    if not models:
+        raise ValueError(f"No hay modelos en {os.path.join(project_dir, 'data')}")
+    return models
+
+
+def generate(project_dir):
+    header = render_header(collect(project_dir))
+    path = os.path.join(project_dir, HEADER_PATH)
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == header:
+                return False
+    with open(path, "w") as f:
+        f.write(header)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--project", default=os.path.join(os.path.dirname(__file__), ".."),
+                        help="directorio del proyecto (default: el padre de tools/)")
+    parser.add_argument("--list", action="store_true", help="solo listar los ops por modelo")
+    args = parser.parse_args()
+
+    try:
+        models = collect(args.project)
+    except (OSError, ValueError) as e:
+        print(e, file=sys.stderr)
+        return 1
+
+    if args.list:
+        for name in sorted(models):
+            print(f"{name}: {', '.join(BUILTIN_OPS[c][0] for c in sorted(models[name]))}")
+        return 0
+
+    changed = generate(args.project)
+    print(f"{HEADER_PATH}: {'actualizado' if changed else 'sin cambios'}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+else:
+    # extra_script de PlatformIO (SCons): regenera antes de compilar
+    Import("env")  # noqa: F821
+    project = env.subst("$PROJECT_DIR")  # noqa: F821
+    try:
+        if generate(project):
+            print(f"[gen_op_resolver] {HEADER_PATH} actualizado")
+    except (OSError, ValueError) as e:
+        print(f"[gen_op_resolver] ERROR: {e}", file=sys.stderr)
+        env.Exit(1)  # noqa: F821